@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
@@ -32,6 +33,17 @@ public:
         Emplace<PushMode::Wait>(std::forward<Args>(args)...);
     }
 
+    /// Like EmplaceWait, but a parked consumer is only woken by the next Flush
+    template <typename... Args>
+    void EmplaceWaitDeferred(Args&&... args) {
+        Emplace<PushMode::Wait, false>(std::forward<Args>(args)...);
+    }
+
+    /// Wakes the consumer for the elements emplaced with EmplaceWaitDeferred, if it is parked
+    void Flush() {
+        NotifyConsumer();
+    }
+
     bool TryPop(T& t) {
         return Pop<PopMode::Try>(t);
     }
@@ -70,7 +82,7 @@ private:
         Count,
     };
 
-    template <PushMode Mode, typename... Args>
+    template <PushMode Mode, bool notify = true, typename... Args>
     bool Emplace(Args&&... args) {
         const size_t write_index = m_write_index.load(std::memory_order::relaxed);
 
@@ -81,10 +93,18 @@ private:
             }
         } else if constexpr (Mode == PushMode::Wait) {
             // Wait until we have free slots to write to.
-            std::unique_lock lock{producer_cv_mutex};
-            producer_cv.wait(lock, [this, write_index] {
-                return (write_index - m_read_index.load(std::memory_order::acquire)) < Capacity;
-            });
+            if ((write_index - m_read_index.load(std::memory_order::acquire)) == Capacity) {
+                if constexpr (!notify) {
+                    // Deferred elements fill the queue, the consumer has to drain them first.
+                    NotifyConsumer();
+                }
+                std::unique_lock lock{producer_cv_mutex};
+                m_producer_waiting.store(true);
+                producer_cv.wait(lock, [this, write_index] {
+                    return (write_index - m_read_index.load()) < Capacity;
+                });
+                m_producer_waiting.store(false, std::memory_order::relaxed);
+            }
         } else {
             static_assert(Mode < PushMode::Count, "Invalid PushMode.");
         }
@@ -98,13 +118,22 @@ private:
         // Increment the write index.
         ++m_write_index;
 
-        // Notify the consumer that we have pushed into the queue.
-        std::scoped_lock lock{consumer_cv_mutex};
-        consumer_cv.notify_one();
+        if constexpr (notify) {
+            NotifyConsumer();
+        }
 
         return true;
     }
 
+    void NotifyConsumer() {
+        // Notify the consumer that we have pushed into the queue. The lock is only taken when the
+        // consumer is parked, so a burst of pushes to a busy consumer never touches it.
+        if (m_consumer_waiting.load()) {
+            std::scoped_lock lock{consumer_cv_mutex};
+            consumer_cv.notify_one();
+        }
+    }
+
     template <PopMode Mode>
     bool Pop(T& t, [[maybe_unused]] std::stop_token stop_token = {}) {
         const size_t read_index = m_read_index.load(std::memory_order::relaxed);
@@ -116,18 +145,26 @@ private:
             }
         } else if constexpr (Mode == PopMode::Wait) {
             // Wait until the queue is not empty.
-            std::unique_lock lock{consumer_cv_mutex};
-            consumer_cv.wait(lock, [this, read_index] {
-                return read_index != m_write_index.load(std::memory_order::acquire);
-            });
+            if (read_index == m_write_index.load(std::memory_order::acquire)) {
+                std::unique_lock lock{consumer_cv_mutex};
+                m_consumer_waiting.store(true);
+                consumer_cv.wait(lock, [this, read_index] {
+                    return read_index != m_write_index.load();
+                });
+                m_consumer_waiting.store(false, std::memory_order::relaxed);
+            }
         } else if constexpr (Mode == PopMode::WaitWithStopToken) {
             // Wait until the queue is not empty.
-            std::unique_lock lock{consumer_cv_mutex};
-            Common::CondvarWait(consumer_cv, lock, stop_token, [this, read_index] {
-                return read_index != m_write_index.load(std::memory_order::acquire);
-            });
-            if (stop_token.stop_requested()) {
-                return false;
+            if (read_index == m_write_index.load(std::memory_order::acquire)) {
+                std::unique_lock lock{consumer_cv_mutex};
+                m_consumer_waiting.store(true);
+                Common::CondvarWait(consumer_cv, lock, stop_token, [this, read_index] {
+                    return read_index != m_write_index.load();
+                });
+                m_consumer_waiting.store(false, std::memory_order::relaxed);
+                if (stop_token.stop_requested()) {
+                    return false;
+                }
             }
         } else {
             static_assert(Mode < PopMode::Count, "Invalid PopMode.");
@@ -142,9 +179,11 @@ private:
         // Increment the read index.
         ++m_read_index;
 
-        // Notify the producer that we have popped off the queue.
-        std::scoped_lock lock{producer_cv_mutex};
-        producer_cv.notify_one();
+        // Notify the producer that we have popped off the queue, if it is waiting for a slot.
+        if (m_producer_waiting.load()) {
+            std::scoped_lock lock{producer_cv_mutex};
+            producer_cv.notify_one();
+        }
 
         return true;
     }
@@ -154,6 +193,12 @@ private:
 
     std::array<T, Capacity> m_data;
 
+    // Set by a side before it parks. The flag store and the index load of the waiter, and the
+    // index increment and the flag load of the other side, are sequentially consistent, so either
+    // the waiter sees the new index or the other side sees the flag and wakes it.
+    std::atomic_bool m_producer_waiting{false};
+    std::atomic_bool m_consumer_waiting{false};
+
     std::condition_variable_any producer_cv;
     std::mutex producer_cv_mutex;
     std::condition_variable_any consumer_cv;
@@ -1,7 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 
 #include "common/assert.h"
 #include "common/fiber.h"
@@ -13,8 +16,65 @@ namespace Common {
 
 constexpr std::size_t default_stack_size = 512 * 1024;
 
+namespace {
+
+/// Where the host thread of a fiber waits while the fiber isn't running
+struct HostThreadSlot {
+    std::mutex mutex;
+    std::condition_variable cv;
+    Fiber::HandoffState handoff{};
+    bool resume{};
+    bool running{};
+    bool exit{};
+
+    std::function<void()> entry_point;
+    boost::context::detail::fcontext_t context{};
+    boost::context::detail::fcontext_t thread_context{};
+};
+
+std::atomic_bool use_host_threads{};
+Fiber::HostThreadHandoff host_thread_handoff{};
+
+void ParkHostThread(HostThreadSlot& slot) {
+    Fiber::HandoffState handoff;
+    bool exit{};
+    {
+        std::unique_lock lk{slot.mutex};
+        slot.cv.wait(lk, [&slot] { return slot.resume || slot.exit; });
+        exit = slot.exit;
+        slot.resume = false;
+        slot.running = !exit;
+        handoff = slot.handoff;
+    }
+    if (exit) {
+        // The fiber was destroyed while parked. As with stack fibers, what is left on its stack is
+        // abandoned, the thread goes back to where it started and returns to be joined.
+        ASSERT(slot.thread_context != nullptr);
+        boost::context::detail::jump_fcontext(slot.thread_context, nullptr);
+    }
+    if (host_thread_handoff.restore) {
+        host_thread_handoff.restore(handoff);
+    }
+}
+
+void HostThreadStartFunc(boost::context::detail::transfer_t transfer) {
+    auto* slot = static_cast<HostThreadSlot*>(transfer.data);
+    slot->thread_context = transfer.fctx;
+    ParkHostThread(*slot);
+    slot->entry_point();
+    UNREACHABLE();
+}
+
+} // Anonymous namespace
+
 struct Fiber::FiberImpl {
-    FiberImpl() : stack{default_stack_size}, rewind_stack{default_stack_size} {}
+    explicit FiberImpl(bool uses_host_thread) : stack{default_stack_size} {
+        if (uses_host_thread) {
+            host_slot = std::make_shared<HostThreadSlot>();
+        } else {
+            rewind_stack.resize(default_stack_size);
+        }
+    }
 
     VirtualBuffer<u8> stack;
     VirtualBuffer<u8> rewind_stack;
@@ -30,6 +90,10 @@ struct Fiber::FiberImpl {
     u8* rewind_stack_limit{};
     boost::context::detail::fcontext_t context{};
     boost::context::detail::fcontext_t rewind_context{};
+
+    // Only used by fibers backed by host threads, which run on the stack of the fiber.
+    std::shared_ptr<HostThreadSlot> host_slot;
+    std::thread host_thread;
 };
 
 void Fiber::SetRewindPoint(std::function<void()>&& rewind_func) {
@@ -66,8 +130,13 @@ void Fiber::RewindStartFunc(boost::context::detail::transfer_t transfer) {
     fiber->OnRewind(transfer);
 }
 
-Fiber::Fiber(std::function<void()>&& entry_point_func) : impl{std::make_unique<FiberImpl>()} {
+Fiber::Fiber(std::function<void()>&& entry_point_func)
+    : impl{std::make_unique<FiberImpl>(use_host_threads.load())} {
     impl->entry_point = std::move(entry_point_func);
+    if (impl->host_slot) {
+        // The thread is started on the first switch to the fiber.
+        return;
+    }
     impl->stack_limit = impl->stack.data();
     impl->rewind_stack_limit = impl->rewind_stack.data();
     u8* stack_base = impl->stack_limit + default_stack_size;
@@ -75,12 +144,28 @@ Fiber::Fiber(std::function<void()>&& entry_point_func) : impl{std::make_unique<F
         boost::context::detail::make_fcontext(stack_base, impl->stack.size(), FiberStartFunc);
 }
 
-Fiber::Fiber() : impl{std::make_unique<FiberImpl>()} {}
+Fiber::Fiber() : impl{std::make_unique<FiberImpl>(use_host_threads.load())} {}
 
 Fiber::~Fiber() {
     if (impl->released) {
         return;
     }
+    if (impl->host_slot) {
+        bool running{};
+        {
+            std::scoped_lock lk{impl->host_slot->mutex};
+            running = impl->host_slot->running || impl->host_slot->resume;
+            impl->host_slot->exit = true;
+        }
+        ASSERT_MSG(!running, "Destroying a fiber that's still running");
+
+        // Wake up the parked thread and wait for it to leave the stack of the fiber.
+        impl->host_slot->cv.notify_one();
+        if (impl->host_thread.joinable()) {
+            impl->host_thread.join();
+        }
+        return;
+    }
     // Make sure the Fiber is not being used
     const bool locked = impl->guard.try_lock();
     ASSERT_MSG(locked, "Destroying a fiber that's still running");
@@ -94,12 +179,19 @@ void Fiber::Exit() {
     if (!impl->is_thread_fiber) {
         return;
     }
-    impl->guard.unlock();
+    if (!impl->host_slot) {
+        impl->guard.unlock();
+    }
     impl->released = true;
 }
 
 void Fiber::Rewind() {
     ASSERT(impl->rewind_point);
+    if (impl->host_slot) {
+        // There is no other stack to switch to, the rewind point runs on top of the current one.
+        impl->rewind_point();
+        UNREACHABLE();
+    }
     ASSERT(impl->rewind_context == nullptr);
     u8* stack_base = impl->rewind_stack_limit + default_stack_size;
     impl->rewind_context =
@@ -107,7 +199,53 @@ void Fiber::Rewind() {
     boost::context::detail::jump_fcontext(impl->rewind_context, this);
 }
 
+void Fiber::ResumeHostThread() {
+    // The fiber may be destroyed as soon as it runs, so it isn't touched after waking it up.
+    const std::shared_ptr<HostThreadSlot> slot = impl->host_slot;
+    if (impl->entry_point) {
+        // First switch to the fiber, the thread moves to the stack of the fiber and parks there.
+        u8* stack_base = impl->stack.data() + default_stack_size;
+        slot->entry_point = std::move(impl->entry_point);
+        slot->context = boost::context::detail::make_fcontext(stack_base, impl->stack.size(),
+                                                              HostThreadStartFunc);
+        impl->host_thread = std::thread(
+            [slot] { boost::context::detail::jump_fcontext(slot->context, slot.get()); });
+        impl->entry_point = nullptr;
+    }
+    {
+        std::scoped_lock lk{slot->mutex};
+        ASSERT_MSG(!slot->resume, "Yielding to a fiber twice");
+        if (host_thread_handoff.save) {
+            host_thread_handoff.save(slot->handoff);
+        }
+        slot->resume = true;
+    }
+    slot->cv.notify_one();
+}
+
 void Fiber::YieldTo(std::weak_ptr<Fiber> weak_from, Fiber& to) {
+    if (to.impl->host_slot) {
+        // Nothing owning is kept on the stack, it is abandoned if the fiber is destroyed while
+        // parked. The slot outlives the park, the fiber joins its thread before it goes away.
+        HostThreadSlot* from_slot{};
+        if (auto from = weak_from.lock()) {
+            ASSERT_MSG(from->impl->host_slot, "Yielding between fibers of different kinds");
+            from_slot = from->impl->host_slot.get();
+        }
+        weak_from.reset();
+        ASSERT(from_slot != nullptr);
+
+        // The fiber counts as switched away as soon as the target may run. The target is woken up
+        // before parking, it may also yield back to us before we are parked.
+        {
+            std::scoped_lock lk{from_slot->mutex};
+            from_slot->running = false;
+        }
+        to.ResumeHostThread();
+        ParkHostThread(*from_slot);
+        return;
+    }
+
     to.impl->guard.lock();
     to.impl->previous_fiber = weak_from.lock();
 
@@ -127,9 +265,20 @@ void Fiber::YieldTo(std::weak_ptr<Fiber> weak_from, Fiber& to) {
 
 std::shared_ptr<Fiber> Fiber::ThreadToFiber() {
     std::shared_ptr<Fiber> fiber = std::shared_ptr<Fiber>{new Fiber()};
+    if (fiber->impl->host_slot) {
+        // The calling thread is the host thread of the fiber.
+        fiber->impl->host_slot->running = true;
+        fiber->impl->is_thread_fiber = true;
+        return fiber;
+    }
     fiber->impl->guard.lock();
     fiber->impl->is_thread_fiber = true;
     return fiber;
 }
 
+void Fiber::SetUseHostThreads(bool enabled, HostThreadHandoff handoff) {
+    host_thread_handoff = std::move(handoff);
+    use_host_threads = enabled;
+}
+
 } // namespace Common
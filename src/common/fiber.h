@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <memory>
 
+#include "common/common_types.h"
+
 namespace boost::context::detail {
 struct transfer_t;
 }
@@ -29,6 +32,14 @@ namespace Common {
  */
 class Fiber {
 public:
+    /// Thread local state carried from the yielding host thread to the resumed one
+    using HandoffState = std::array<u64, 2>;
+
+    struct HostThreadHandoff {
+        std::function<void(HandoffState&)> save;
+        std::function<void(const HandoffState&)> restore;
+    };
+
     Fiber(std::function<void()>&& entry_point_func);
     ~Fiber();
 
@@ -43,6 +54,15 @@ public:
     static void YieldTo(std::weak_ptr<Fiber> weak_from, Fiber& to);
     [[nodiscard]] static std::shared_ptr<Fiber> ThreadToFiber();
 
+    /**
+     * Backs the fibers created from now on with a host thread each instead of a stack switched on
+     * the calling thread. Yielding wakes up the thread of the target fiber and parks the current
+     * one, so still only one of them runs at a time. As fiber code expects the thread local state
+     * of the thread that switched to it, the handoff copies it over on every switch.
+     * Fibers of both kinds can't yield to each other, so this must be set before creating any.
+     */
+    static void SetUseHostThreads(bool enabled, HostThreadHandoff handoff = {});
+
     void SetRewindPoint(std::function<void()>&& rewind_func);
 
     void Rewind();
@@ -58,6 +78,8 @@ private:
     static void FiberStartFunc(boost::context::detail::transfer_t transfer);
     static void RewindStartFunc(boost::context::detail::transfer_t transfer);
 
+    void ResumeHostThread();
+
     struct FiberImpl;
     std::unique_ptr<FiberImpl> impl;
 };
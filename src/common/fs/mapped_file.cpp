@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/fs/mapped_file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+
+namespace Common::FS {
+
+MappedFile::MappedFile() = default;
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    Open(path);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data{std::exchange(other.data, nullptr)}, size{std::exchange(other.size, 0)} {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    Close();
+    data = std::exchange(other.data, nullptr);
+    size = std::exchange(other.size, 0);
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR(Common_Filesystem, "Failed to open {}", PathToUTF8String(path));
+        return false;
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        LOG_ERROR(Common_Filesystem, "Failed to create file mapping for {}",
+                  PathToUTF8String(path));
+        return false;
+    }
+    void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        LOG_ERROR(Common_Filesystem, "Failed to map {}", PathToUTF8String(path));
+        return false;
+    }
+    data = static_cast<const u8*>(view);
+    size = static_cast<size_t>(file_size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+    data = nullptr;
+    size = 0;
+}
+
+#else
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR(Common_Filesystem, "Failed to open {}", PathToUTF8String(path));
+        return false;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    const size_t file_size = static_cast<size_t>(st.st_size);
+    void* const view = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        LOG_ERROR(Common_Filesystem, "Failed to map {}", PathToUTF8String(path));
+        return false;
+    }
+    data = static_cast<const u8*>(view);
+    size = file_size;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data) {
+        munmap(const_cast<u8*>(data), size);
+    }
+    data = nullptr;
+    size = 0;
+}
+
+#endif
+
+} // namespace Common::FS
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Common::FS {
+
+/**
+ * Read-only memory mapping of a whole file.
+ * Pages are loaded lazily by the host, so only the regions that are actually accessed are read
+ * from disk.
+ */
+class MappedFile final {
+public:
+    MappedFile();
+
+    /**
+     * Maps the file at path.
+     * If the file can't be opened or mapped, IsOpen() returns false.
+     *
+     * @param path Filesystem path
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Maps the file at path, unmapping any previously mapped file.
+     *
+     * @param path Filesystem path
+     *
+     * @returns True if the file was mapped, false otherwise.
+     */
+    bool Open(const std::filesystem::path& path);
+
+    /// Unmaps the file.
+    void Close();
+
+    /// Returns true if a file is currently mapped.
+    [[nodiscard]] bool IsOpen() const {
+        return data != nullptr;
+    }
+
+    /// Returns the mapped contents of the file.
+    [[nodiscard]] std::span<const u8> Data() const {
+        return {data, size};
+    }
+
+    /// Returns the size of the mapped file in bytes.
+    [[nodiscard]] size_t Size() const {
+        return size;
+    }
+
+private:
+    const u8* data{};
+    size_t size{};
+};
+
+} // namespace Common::FS
@@ -14,6 +14,8 @@
 #ifndef _GNU_SOURCE
 #define _GNU_SOURCE
 #endif
+#include <fstream>
+#include <string>
 #include <boost/icl/interval_set.hpp>
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -92,14 +94,7 @@ public:
     explicit Impl(size_t backing_size_, size_t virtual_size_)
         : backing_size{backing_size_}, virtual_size{virtual_size_}, process{GetCurrentProcess()},
           kernelbase_dll("Kernelbase") {
-        if (!kernelbase_dll.IsOpen()) {
-            LOG_CRITICAL(HW_Memory, "Failed to load Kernelbase.dll");
-            throw std::bad_alloc{};
-        }
-        GetFuncAddress(kernelbase_dll, "CreateFileMapping2", pfn_CreateFileMapping2);
-        GetFuncAddress(kernelbase_dll, "VirtualAlloc2", pfn_VirtualAlloc2);
-        GetFuncAddress(kernelbase_dll, "MapViewOfFile3", pfn_MapViewOfFile3);
-        GetFuncAddress(kernelbase_dll, "UnmapViewOfFile2", pfn_UnmapViewOfFile2);
+        LoadFunctions();
 
         // Allocate backing file map
         backing_handle =
@@ -128,16 +123,20 @@ public:
             LOG_CRITICAL(HW_Memory, "Failed to map {} MiB of virtual memory", backing_size >> 20);
             throw std::bad_alloc{};
         }
-        // Allocate virtual address placeholder
-        virtual_base = static_cast<u8*>(pfn_VirtualAlloc2(process, nullptr, virtual_size,
-                                                          MEM_RESERVE | MEM_RESERVE_PLACEHOLDER,
-                                                          PAGE_NOACCESS, nullptr, 0));
-        if (!virtual_base) {
-            Release();
-            LOG_CRITICAL(HW_Memory, "Failed to reserve {} GiB of virtual memory",
-                         virtual_size >> 30);
+        ReserveVirtualBase();
+    }
+
+    explicit Impl(const Impl& backing_owner, size_t virtual_size_)
+        : backing_size{backing_owner.backing_size}, virtual_size{virtual_size_},
+          process{GetCurrentProcess()}, kernelbase_dll("Kernelbase") {
+        LoadFunctions();
+        // The backing file map stays owned by the other instance, only its handle is shared
+        if (!DuplicateHandle(process, backing_owner.backing_handle, process, &backing_handle, 0,
+                             FALSE, DUPLICATE_SAME_ACCESS)) {
+            LOG_CRITICAL(HW_Memory, "Failed to duplicate backing memory file handle");
             throw std::bad_alloc{};
         }
+        ReserveVirtualBase();
     }
 
     ~Impl() {
@@ -199,6 +198,11 @@ public:
         UNREACHABLE();
     }
 
+    bool EnableHugePages() {
+        // Large pages can't back placeholder views on Windows
+        return false;
+    }
+
     const size_t backing_size; ///< Size of the backing memory in bytes
     const size_t virtual_size; ///< Size of the virtual address placeholder in bytes
 
@@ -206,6 +210,30 @@ public:
     u8* virtual_base{};
 
 private:
+    void LoadFunctions() {
+        if (!kernelbase_dll.IsOpen()) {
+            LOG_CRITICAL(HW_Memory, "Failed to load Kernelbase.dll");
+            throw std::bad_alloc{};
+        }
+        GetFuncAddress(kernelbase_dll, "CreateFileMapping2", pfn_CreateFileMapping2);
+        GetFuncAddress(kernelbase_dll, "VirtualAlloc2", pfn_VirtualAlloc2);
+        GetFuncAddress(kernelbase_dll, "MapViewOfFile3", pfn_MapViewOfFile3);
+        GetFuncAddress(kernelbase_dll, "UnmapViewOfFile2", pfn_UnmapViewOfFile2);
+    }
+
+    void ReserveVirtualBase() {
+        // Allocate virtual address placeholder
+        virtual_base = static_cast<u8*>(pfn_VirtualAlloc2(process, nullptr, virtual_size,
+                                                          MEM_RESERVE | MEM_RESERVE_PLACEHOLDER,
+                                                          PAGE_NOACCESS, nullptr, 0));
+        if (!virtual_base) {
+            Release();
+            LOG_CRITICAL(HW_Memory, "Failed to reserve {} GiB of virtual memory",
+                         virtual_size >> 30);
+            throw std::bad_alloc{};
+        }
+    }
+
     /// Release all resources in the object
     void Release() {
         if (!placeholders.empty()) {
@@ -469,17 +497,27 @@ public:
             throw std::bad_alloc{};
         }
 
-        // Virtual memory initialization
-        virtual_base = virtual_map_base = static_cast<u8*>(ChooseVirtualBase(virtual_size));
-        if (virtual_base == MAP_FAILED) {
-            LOG_CRITICAL(HW_Memory, "mmap failed: {}", strerror(errno));
+        ReserveVirtualBase();
+        good = true;
+    }
+
+    explicit Impl(const Impl& backing_owner, size_t virtual_size_)
+        : backing_size{backing_owner.backing_size}, virtual_size{virtual_size_} {
+        bool good = false;
+        SCOPE_EXIT {
+            if (!good) {
+                Release();
+            }
+        };
+
+        // The backing map stays owned by the other instance, only the file is shared
+        fd = dup(backing_owner.fd);
+        if (fd < 0) {
+            LOG_CRITICAL(HW_Memory, "dup failed: {}", strerror(errno));
             throw std::bad_alloc{};
         }
-#if defined(__linux__)
-        madvise(virtual_base, virtual_size, MADV_HUGEPAGE);
-#endif
 
-        free_manager.SetAddressSpace(virtual_base, virtual_size);
+        ReserveVirtualBase();
         good = true;
     }
 
@@ -511,6 +549,11 @@ public:
         void* ret = mmap(virtual_base + virtual_offset, length, flags, MAP_SHARED | MAP_FIXED, fd,
                          host_offset);
         ASSERT_MSG(ret != MAP_FAILED, "mmap failed: {}", strerror(errno));
+#ifdef __linux__
+        if (huge_pages) {
+            AdviseHugePages(static_cast<u8*>(ret), host_offset, length);
+        }
+#endif
     }
 
     void Unmap(size_t virtual_offset, size_t length) {
@@ -551,6 +594,10 @@ public:
 
     bool ClearBackingRegion(size_t physical_offset, size_t length) {
 #ifdef __linux__
+        if (backing_base == MAP_FAILED) {
+            return false;
+        }
+
         // Set MADV_REMOVE on backing map to destroy it instantly.
         // This also deletes the area from the backing file.
         int ret = madvise(backing_base + physical_offset, length, MADV_REMOVE);
@@ -566,6 +613,21 @@ public:
         virtual_base = nullptr;
     }
 
+    bool EnableHugePages() {
+#ifdef __linux__
+        if (!IsShmemHugePageAllowed()) {
+            return false;
+        }
+        if (backing_base != MAP_FAILED) {
+            madvise(backing_base, backing_size, MADV_HUGEPAGE);
+        }
+        huge_pages = true;
+        return true;
+#else
+        return false;
+#endif
+    }
+
     const size_t backing_size; ///< Size of the backing memory in bytes
     const size_t virtual_size; ///< Size of the virtual address placeholder in bytes
 
@@ -574,6 +636,20 @@ public:
     u8* virtual_map_base{reinterpret_cast<u8*>(MAP_FAILED)};
 
 private:
+    void ReserveVirtualBase() {
+        // Virtual memory initialization
+        virtual_base = virtual_map_base = static_cast<u8*>(ChooseVirtualBase(virtual_size));
+        if (virtual_base == MAP_FAILED) {
+            LOG_CRITICAL(HW_Memory, "mmap failed: {}", strerror(errno));
+            throw std::bad_alloc{};
+        }
+#if defined(__linux__)
+        madvise(virtual_base, virtual_size, MADV_HUGEPAGE);
+#endif
+
+        free_manager.SetAddressSpace(virtual_base, virtual_size);
+    }
+
     /// Release all resources in the object
     void Release() {
         if (virtual_map_base != MAP_FAILED) {
@@ -592,6 +668,39 @@ private:
         }
     }
 
+#ifdef __linux__
+    /// Returns true when the kernel may back shared memory with transparent huge pages
+    static bool IsShmemHugePageAllowed() {
+        std::ifstream file{"/sys/kernel/mm/transparent_hugepage/shmem_enabled"};
+        std::string modes;
+        if (!std::getline(file, modes)) {
+            LOG_WARNING(HW_Memory, "Transparent huge pages are not supported by the kernel");
+            return false;
+        }
+        // The active mode is the one in brackets, e.g. "always within_size [advise] never"
+        if (modes.find("[never]") != std::string::npos ||
+            modes.find("[deny]") != std::string::npos) {
+            LOG_WARNING(HW_Memory, "Huge pages for shared memory are disabled by the kernel: {}",
+                        modes);
+            return false;
+        }
+        return true;
+    }
+
+    /// A huge page can only be mapped when the virtual address and the file offset share their
+    /// 2 MiB alignment, and the mapping covers at least one whole huge page
+    void AdviseHugePages(u8* pointer, size_t host_offset, size_t length) {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+        if ((address - host_offset) % HugePageSize != 0) {
+            return;
+        }
+        if (AlignUp(address, HugePageSize) + HugePageSize > address + length) {
+            return;
+        }
+        madvise(pointer, length, MADV_HUGEPAGE);
+    }
+#endif
+
     void AdjustMap(size_t* virtual_offset, size_t* length) {
         if (virtual_base != nullptr) {
             return;
@@ -614,6 +723,7 @@ private:
     }
 
     int fd{-1}; // memfd file descriptor, -1 is the error value of memfd_create
+    bool huge_pages{false}; ///< Mappings are advised to use transparent huge pages
     FreeRegionManager free_manager{};
 };
 
@@ -627,6 +737,10 @@ public:
         throw std::bad_alloc{};
     }
 
+    explicit Impl(const Impl& /* backing_owner */, size_t /* virtual_size */) {
+        throw std::bad_alloc{};
+    }
+
     void Map(size_t virtual_offset, size_t host_offset, size_t length, MemoryPermission perm) {}
 
     void Unmap(size_t virtual_offset, size_t length) {}
@@ -639,6 +753,10 @@ public:
 
     void EnableDirectMappedAddress() {}
 
+    bool EnableHugePages() {
+        return false;
+    }
+
     u8* backing_base{nullptr};
     u8* virtual_base{nullptr};
 };
@@ -672,6 +790,34 @@ HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_)
     }
 }
 
+HostMemory::HostMemory(const HostMemory& backing_owner, size_t virtual_size_)
+    : backing_size(backing_owner.backing_size), virtual_size(virtual_size_) {
+    if (!backing_owner.impl) {
+        // The owner already fell back to a plain buffer, there is nothing to alias.
+        return;
+    }
+    try {
+        impl = std::make_unique<HostMemory::Impl>(
+            *backing_owner.impl, AlignUp(virtual_size, PageAlignment) + HugePageSize);
+        virtual_base = impl->virtual_base;
+
+        // Ensure the virtual base is aligned to the L2 block size.
+        virtual_base = reinterpret_cast<u8*>(
+            Common::AlignUp(reinterpret_cast<uintptr_t>(virtual_base), HugePageSize));
+        virtual_base_offset = virtual_base - impl->virtual_base;
+
+        if (backing_owner.huge_pages) {
+            huge_pages = impl->EnableHugePages();
+        }
+
+    } catch (const std::bad_alloc&) {
+        LOG_CRITICAL(HW_Memory, "Failed to reserve a view of {} GiB over the backing memory",
+                     virtual_size >> 30);
+        impl.reset();
+        virtual_base = nullptr;
+    }
+}
+
 HostMemory::~HostMemory() = default;
 
 HostMemory::HostMemory(HostMemory&&) noexcept = default;
@@ -715,11 +861,17 @@ void HostMemory::Protect(size_t virtual_offset, size_t length, MemoryPermission
 }
 
 void HostMemory::ClearBackingRegion(size_t physical_offset, size_t length, u32 fill_value) {
+    ASSERT_MSG(backing_base != nullptr, "Views do not own the backing memory");
     if (!impl || fill_value != 0 || !impl->ClearBackingRegion(physical_offset, length)) {
         std::memset(backing_base + physical_offset, fill_value, length);
     }
 }
 
+bool HostMemory::EnableHugePages() {
+    huge_pages = impl && impl->EnableHugePages();
+    return huge_pages;
+}
+
 void HostMemory::EnableDirectMappedAddress() {
     if (impl) {
         impl->EnableDirectMappedAddress();
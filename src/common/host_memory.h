@@ -25,6 +25,15 @@ DECLARE_ENUM_FLAG_OPERATORS(MemoryPermission)
 class HostMemory {
 public:
     explicit HostMemory(size_t backing_size_, size_t virtual_size_);
+
+    /**
+     * Creates a new virtual address placeholder over the backing memory of another buffer.
+     * Mappings of both buffers alias the same physical pages, the backing is not duplicated.
+     * When the owner has no fastmem arena, the view has no virtual base either.
+     * The view does not own the backing, its BackingBasePointer is null.
+     */
+    explicit HostMemory(const HostMemory& backing_owner, size_t virtual_size_);
+
     ~HostMemory();
 
     /**
@@ -49,6 +58,15 @@ public:
 
     void EnableDirectMappedAddress();
 
+    /**
+     * Lets the host back the memory with transparent 2 MiB huge pages. Mappings only use them
+     * where the virtual address and the backing offset share their 2 MiB alignment.
+     * Must be called before any mapping is made. Views of this buffer inherit the mode.
+     *
+     * @returns True when the host supports huge pages for the backing memory.
+     */
+    bool EnableHugePages();
+
     void ClearBackingRegion(size_t physical_offset, size_t length, u32 fill_value);
 
     [[nodiscard]] u8* BackingBasePointer() noexcept {
@@ -79,6 +97,7 @@ private:
     u8* backing_base{};
     u8* virtual_base{};
     size_t virtual_base_offset{};
+    bool huge_pages{};
 
     // Fallback if fastmem is not supported on this platform
     std::unique_ptr<Common::VirtualBuffer<u8>> fallback_buffer;
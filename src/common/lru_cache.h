@@ -49,6 +49,10 @@ public:
         Attach(item);
     }
 
+    [[nodiscard]] TickType GetTick(size_t id) const {
+        return item_pool[id].tick;
+    }
+
     void Free(size_t id) {
         auto& item = item_pool[id];
         Detach(item);
@@ -60,7 +64,7 @@ public:
     template <typename Func>
     void ForEachItemBelow(TickType tick, Func&& func) {
         static constexpr bool RETURNS_BOOL =
-            std::is_same_v<std::invoke_result<Func, ObjectType>, bool>;
+            std::is_same_v<std::invoke_result_t<Func, ObjectType>, bool>;
         Item* iterator = first_item;
         while (iterator) {
             if (static_cast<s64>(tick) - static_cast<s64>(iterator->tick) < 0) {
@@ -210,6 +210,12 @@ struct Values {
                                              true,
                                              true,
                                              &use_speed_limit};
+    Setting<bool> use_huge_pages{linkage, false, "use_huge_pages", Category::Core};
+    Setting<bool> use_shared_service_threads{linkage, false, "use_shared_service_threads",
+                                             Category::Core};
+    Setting<bool> use_host_thread_per_guest_thread{linkage, false,
+                                                   "use_host_thread_per_guest_thread",
+                                                   Category::Core};
 
     // Cpu
     SwitchableSetting<CpuBackend, true> cpu_backend{linkage,
@@ -390,6 +396,20 @@ struct Values {
                                                            VramUsageMode::Aggressive,
                                                            "vram_usage_mode",
                                                            Category::RendererAdvanced};
+    SwitchableSetting<u32, true> texture_cache_budget{linkage,
+                                                      0,
+                                                      0,
+                                                      65536,
+                                                      "texture_cache_budget",
+                                                      Category::RendererAdvanced,
+                                                      Specialization::Countable};
+    SwitchableSetting<u32, true> astc_decode_cache_size{linkage,
+                                                        256,
+                                                        0,
+                                                        4096,
+                                                        "astc_decode_cache_size",
+                                                        Category::RendererAdvanced,
+                                                        Specialization::Countable};
     SwitchableSetting<bool> async_presentation{linkage,
 #ifdef ANDROID
                                                true,
@@ -437,6 +457,8 @@ struct Values {
                                           Category::RendererDebug};
     Setting<bool> disable_buffer_reorder{linkage, false, "disable_buffer_reorder",
                                          Category::RendererDebug};
+    Setting<bool> disable_gpu_fastmem{linkage, false, "disable_gpu_fastmem",
+                                      Category::RendererDebug};
 
     // System
     SwitchableSetting<Language, true> language_index{linkage,
@@ -583,6 +605,9 @@ struct Values {
         false};
     Setting<bool> dump_macros{
         linkage, false, "dump_macros", Category::DebuggingGraphics, Specialization::Default, false};
+    Setting<bool> dump_gpu_commands{
+        linkage, false, "dump_gpu_commands", Category::DebuggingGraphics, Specialization::Default,
+        false};
     Setting<bool> enable_fs_access_log{linkage, false, "enable_fs_access_log", Category::Debugging};
     Setting<bool> reporting_services{
         linkage, false, "reporting_services", Category::Debugging, Specialization::Default, false};
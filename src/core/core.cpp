@@ -60,6 +60,8 @@
 #include "core/tools/renderdoc.h"
 #include "hid_core/hid_core.h"
 #include "network/network.h"
+#include "video_core/gpu.h"
+#include "video_core/gpu_thread.h"
 #include "video_core/host1x/host1x.h"
 #include "video_core/renderer_base.h"
 #include "video_core/video_core.h"
@@ -267,18 +269,39 @@ struct System::Impl {
         // Setting changes may require a full system reinitialization (e.g., disabling multicore).
         ReinitializeIfNecessary(system);
 
+        // The kernel creates the fibers of the guest threads, pick what backs them first.
+        cpu_manager.SetHostThreadPerGuestThread(
+            is_multicore && !Settings::IsNceEnabled() &&
+            Settings::values.use_host_thread_per_guest_thread.GetValue());
+
         kernel.Initialize();
         cpu_manager.Initialize();
     }
 
-    SystemResultStatus SetupForApplicationProcess(System& system, Frontend::EmuWindow& emu_window) {
-        telemetry_session = std::make_unique<Core::TelemetrySession>();
-
+    SystemResultStatus InitializeGPU(System& system, Frontend::EmuWindow& emu_window) {
         host1x_core = std::make_unique<Tegra::Host1x::Host1x>(system);
         gpu_core = VideoCore::CreateGPU(emu_window, system);
         if (!gpu_core) {
             return SystemResultStatus::ErrorVideoCore;
         }
+        return SystemResultStatus::Success;
+    }
+
+    void ShutdownGPU() {
+        if (gpu_core != nullptr) {
+            gpu_core->NotifyShutdown();
+        }
+        gpu_core.reset();
+        host1x_core.reset();
+    }
+
+    SystemResultStatus SetupForApplicationProcess(System& system, Frontend::EmuWindow& emu_window) {
+        telemetry_session = std::make_unique<Core::TelemetrySession>();
+
+        if (const auto result = InitializeGPU(system, emu_window);
+            result != SystemResultStatus::Success) {
+            return result;
+        }
 
         audio_core = std::make_unique<AudioCore::AudioCore>(system);
 
@@ -480,7 +503,21 @@ struct System::Impl {
     }
 
     PerfStatsResults GetAndResetPerfStats() {
-        return perf_stats->GetAndResetStats(core_timing.GetGlobalTimeUs());
+        PerfStatsResults results = perf_stats->GetAndResetStats(core_timing.GetGlobalTimeUs());
+        if (gpu_core) {
+            const auto queue_stats = gpu_core->GetAndResetQueueStats();
+            results.gpu_queue_depth = queue_stats.average_depth;
+            results.gpu_queue_latency_us = queue_stats.average_latency_us;
+            if (auto* const rasterizer = gpu_core->Renderer().ReadRasterizer()) {
+                const auto download_stats = rasterizer->GetDownloadStats();
+                results.gpu_download_bytes = download_stats.bytes;
+                results.gpu_download_latency_us = download_stats.average_latency_us;
+                const auto texture_stats = rasterizer->GetAndResetTextureCacheStats();
+                results.gpu_texture_evictions = texture_stats.evictions;
+                results.gpu_texture_thrash_rate = texture_stats.thrash_rate;
+            }
+        }
+        return results;
     }
 
     mutable std::mutex suspend_guard;
@@ -637,6 +674,16 @@ SystemResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::stri
     return impl->Load(*this, emu_window, filepath, params);
 }
 
+SystemResultStatus System::InitializeGPU(Frontend::EmuWindow& emu_window) {
+    impl->telemetry_session = std::make_unique<Core::TelemetrySession>();
+    return impl->InitializeGPU(*this, emu_window);
+}
+
+void System::ShutdownGPU() {
+    impl->ShutdownGPU();
+    impl->telemetry_session.reset();
+}
+
 bool System::IsPoweredOn() const {
     return impl->is_powered_on.load(std::memory_order::relaxed);
 }
@@ -211,6 +211,17 @@ public:
                                           const std::string& filepath,
                                           Service::AM::FrontendAppletParameters& params);
 
+    /**
+     * Creates host1x and the GPU without loading an application, for tools that drive the GPU
+     * directly. Must not be used together with Load.
+     * @param emu_window Reference to the host-system window used for video output.
+     * @returns SystemResultStatus code, indicating if the operation succeeded.
+     */
+    [[nodiscard]] SystemResultStatus InitializeGPU(Frontend::EmuWindow& emu_window);
+
+    /// Destroys the GPU and host1x created by InitializeGPU.
+    void ShutdownGPU();
+
     /**
      * Indicates if the emulated system is powered on (all subsystems initialized and able to run an
      * application).
@@ -22,6 +22,60 @@ namespace Core::Timing {
 
 constexpr s64 MAX_SLICE_LENGTH = 10000;
 
+namespace {
+
+/// Children per node of the event heap. A wider node keeps a sift down within fewer cache lines
+/// than a binary heap at the cost of a few more comparisons per level.
+constexpr size_t HEAP_ARITY = 4;
+
+template <typename T>
+void HeapPush(std::vector<T>& heap, T&& value) {
+    size_t index = heap.size();
+    heap.push_back(std::move(value));
+    T moved = std::move(heap[index]);
+    while (index > 0) {
+        const size_t parent = (index - 1) / HEAP_ARITY;
+        if (!(moved < heap[parent])) {
+            break;
+        }
+        heap[index] = std::move(heap[parent]);
+        index = parent;
+    }
+    heap[index] = std::move(moved);
+}
+
+template <typename T>
+void HeapPop(std::vector<T>& heap) {
+    T moved = std::move(heap.back());
+    heap.pop_back();
+    if (heap.empty()) {
+        return;
+    }
+    const size_t size = heap.size();
+    size_t index = 0;
+    while (true) {
+        const size_t first_child = index * HEAP_ARITY + 1;
+        if (first_child >= size) {
+            break;
+        }
+        const size_t last_child = std::min(first_child + HEAP_ARITY, size);
+        size_t smallest = first_child;
+        for (size_t child = first_child + 1; child < last_child; ++child) {
+            if (heap[child] < heap[smallest]) {
+                smallest = child;
+            }
+        }
+        if (!(heap[smallest] < moved)) {
+            break;
+        }
+        heap[index] = std::move(heap[smallest]);
+        index = smallest;
+    }
+    heap[index] = std::move(moved);
+}
+
+} // Anonymous namespace
+
 std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callback) {
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
@@ -31,7 +85,17 @@ struct CoreTiming::Event {
     u64 fifo_order;
     std::weak_ptr<EventType> type;
     s64 reschedule_time;
-    heap_t::handle_type handle{};
+    /// Sequence number of the event type when this instance was scheduled
+    size_t sequence_number;
+
+    /// Returns the event type when this instance has not been unscheduled
+    std::shared_ptr<EventType> LiveType() const {
+        auto event_type = type.lock();
+        if (event_type && event_type->sequence_number.load() != sequence_number) {
+            event_type.reset();
+        }
+        return event_type;
+    }
 
     // Sort by time, unless the times are the same, in which case sort by
     // the order added to the queue
@@ -44,10 +108,23 @@ struct CoreTiming::Event {
     }
 };
 
+struct CoreTiming::PendingEvent {
+    Event event;
+    PendingEvent* next;
+};
+
 CoreTiming::CoreTiming() : clock{Common::CreateOptimalClock()} {}
 
 CoreTiming::~CoreTiming() {
     Reset();
+    ClearPendingList();
+
+    PendingEvent* node = free_pending_events;
+    while (node) {
+        PendingEvent* const next = node->next;
+        delete node;
+        node = next;
+    }
 }
 
 void CoreTiming::ThreadEntry(CoreTiming& instance) {
@@ -73,6 +150,7 @@ void CoreTiming::Initialize(std::function<void()>&& on_thread_init_) {
 
 void CoreTiming::ClearPendingEvents() {
     std::scoped_lock lock{advance_lock, basic_lock};
+    ClearPendingList();
     event_queue.clear();
     event.Set();
 }
@@ -112,19 +190,14 @@ bool CoreTiming::IsRunning() const {
 
 bool CoreTiming::HasPendingEvents() const {
     std::scoped_lock lock{basic_lock};
-    return !(wait_set && event_queue.empty());
+    return !(wait_set && event_queue.empty() && pending_events.load() == nullptr);
 }
 
 void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
                                const std::shared_ptr<EventType>& event_type, bool absolute_time) {
-    {
-        std::scoped_lock scope{basic_lock};
-        const auto next_time{absolute_time ? ns_into_future : GetGlobalTimeNs() + ns_into_future};
-
-        auto h{event_queue.emplace(Event{next_time.count(), event_fifo_id++, event_type, 0})};
-        (*h).handle = h;
-    }
-
+    const auto next_time{absolute_time ? ns_into_future : GetGlobalTimeNs() + ns_into_future};
+    PushPendingEvent(Event{next_time.count(), event_fifo_id.fetch_add(1), event_type, 0,
+                           event_type->sequence_number.load()});
     event.Set();
 }
 
@@ -132,37 +205,17 @@ void CoreTiming::ScheduleLoopingEvent(std::chrono::nanoseconds start_time,
                                       std::chrono::nanoseconds resched_time,
                                       const std::shared_ptr<EventType>& event_type,
                                       bool absolute_time) {
-    {
-        std::scoped_lock scope{basic_lock};
-        const auto next_time{absolute_time ? start_time : GetGlobalTimeNs() + start_time};
-
-        auto h{event_queue.emplace(
-            Event{next_time.count(), event_fifo_id++, event_type, resched_time.count()})};
-        (*h).handle = h;
-    }
-
+    const auto next_time{absolute_time ? start_time : GetGlobalTimeNs() + start_time};
+    PushPendingEvent(Event{next_time.count(), event_fifo_id.fetch_add(1), event_type,
+                           resched_time.count(), event_type->sequence_number.load()});
     event.Set();
 }
 
 void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
                                  UnscheduleEventType type) {
-    {
-        std::scoped_lock lk{basic_lock};
-
-        std::vector<heap_t::handle_type> to_remove;
-        for (auto itr = event_queue.begin(); itr != event_queue.end(); itr++) {
-            const Event& e = *itr;
-            if (e.type.lock().get() == event_type.get()) {
-                to_remove.push_back(itr->handle);
-            }
-        }
-
-        for (auto& h : to_remove) {
-            event_queue.erase(h);
-        }
-
-        event_type->sequence_number++;
-    }
+    // Every instance scheduled so far carries the old sequence number and is now stale. Stale
+    // instances are dropped when they reach the top of the queue instead of being searched for.
+    event_type->sequence_number.fetch_add(1);
 
     // Force any in-progress events to finish
     if (type == UnscheduleEventType::Wait) {
@@ -197,39 +250,90 @@ u64 CoreTiming::GetGPUTicks() const {
     return Common::WallClock::CPUTickToGPUTick(cpu_ticks);
 }
 
-std::optional<s64> CoreTiming::Advance() {
-    std::scoped_lock lock{advance_lock, basic_lock};
-    global_timer = GetGlobalTimeNs().count();
+void CoreTiming::PushPendingEvent(Event&& new_event) {
+    PendingEvent* node;
+    {
+        std::scoped_lock lk{free_pending_lock};
+        node = free_pending_events;
+        if (node) [[likely]] {
+            free_pending_events = node->next;
+        }
+    }
+    if (node) [[likely]] {
+        node->event = std::move(new_event);
+    } else {
+        // The pool only grows until it covers the most events ever in flight at once
+        node = new PendingEvent{std::move(new_event), nullptr};
+    }
+    node->next = pending_events.load(std::memory_order_relaxed);
+    while (!pending_events.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+    }
+}
 
-    while (!event_queue.empty() && event_queue.top().time <= global_timer) {
-        const Event& evt = event_queue.top();
+void CoreTiming::DrainPendingEvents() {
+    PendingEvent* const first = pending_events.exchange(nullptr, std::memory_order_acquire);
+    if (!first) {
+        return;
+    }
+    PendingEvent* last = first;
+    while (true) {
+        HeapPush(event_queue, std::move(last->event));
+        if (!last->next) {
+            break;
+        }
+        last = last->next;
+    }
+    RecyclePendingEvents(first, last);
+}
 
-        if (const auto event_type{evt.type.lock()}) {
-            const auto evt_time = evt.time;
-            const auto evt_sequence_num = event_type->sequence_number;
+void CoreTiming::ClearPendingList() {
+    PendingEvent* const first = pending_events.exchange(nullptr, std::memory_order_acquire);
+    if (!first) {
+        return;
+    }
+    PendingEvent* last = first;
+    while (true) {
+        last->event.type.reset();
+        if (!last->next) {
+            break;
+        }
+        last = last->next;
+    }
+    RecyclePendingEvents(first, last);
+}
 
-            if (evt.reschedule_time == 0) {
-                event_queue.pop();
+void CoreTiming::RecyclePendingEvents(PendingEvent* first, PendingEvent* last) {
+    std::scoped_lock lk{free_pending_lock};
+    last->next = free_pending_events;
+    free_pending_events = first;
+}
 
-                basic_lock.unlock();
+void CoreTiming::PruneStaleEvents() {
+    while (!event_queue.empty() && !event_queue.front().LiveType()) {
+        HeapPop(event_queue);
+    }
+}
 
-                event_type->callback(
-                    evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time});
+std::optional<s64> CoreTiming::Advance() {
+    std::scoped_lock lock{advance_lock, basic_lock};
+    DrainPendingEvents();
+    global_timer = GetGlobalTimeNs().count();
 
-                basic_lock.lock();
-            } else {
-                basic_lock.unlock();
+    while (!event_queue.empty() && event_queue.front().time <= global_timer) {
+        const Event evt = std::move(event_queue.front());
+        HeapPop(event_queue);
 
-                const auto new_schedule_time{event_type->callback(
-                    evt_time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt_time})};
+        if (const auto event_type{evt.LiveType()}) {
+            basic_lock.unlock();
 
-                basic_lock.lock();
+            const auto new_schedule_time{event_type->callback(
+                evt.time, std::chrono::nanoseconds{GetGlobalTimeNs().count() - evt.time})};
 
-                if (evt_sequence_num != event_type->sequence_number) {
-                    // Heap handle is invalidated after external modification.
-                    continue;
-                }
+            basic_lock.lock();
 
+            if (evt.reschedule_time != 0 &&
+                evt.sequence_number == event_type->sequence_number.load()) {
                 const auto next_schedule_time{new_schedule_time.has_value()
                                                   ? new_schedule_time.value().count()
                                                   : evt.reschedule_time};
@@ -241,16 +345,19 @@ std::optional<s64> CoreTiming::Advance() {
                     next_time = pause_end_time + next_schedule_time;
                 }
 
-                event_queue.update(evt.handle, Event{next_time, event_fifo_id++, evt.type,
-                                                     next_schedule_time, evt.handle});
+                HeapPush(event_queue, Event{next_time, event_fifo_id.fetch_add(1), evt.type,
+                                            next_schedule_time, evt.sequence_number});
             }
+            // Callbacks commonly schedule follow-up events, pick them up in this pass
+            DrainPendingEvents();
         }
 
         global_timer = GetGlobalTimeNs().count();
     }
 
+    PruneStaleEvents();
     if (!event_queue.empty()) {
-        return event_queue.top().time;
+        return event_queue.front().time;
     } else {
         return std::nullopt;
     }
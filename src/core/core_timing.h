@@ -11,10 +11,10 @@
 #include <optional>
 #include <string>
 #include <thread>
-
-#include <boost/heap/fibonacci_heap.hpp>
+#include <vector>
 
 #include "common/common_types.h"
+#include "common/spin_lock.h"
 #include "common/thread.h"
 #include "common/wall_clock.h"
 
@@ -34,8 +34,8 @@ struct EventType {
     /// A pointer to the name of the event.
     const std::string name;
     /// A monotonic sequence number, incremented when this event is
-    /// changed externally.
-    size_t sequence_number;
+    /// changed externally. Scheduled instances carrying an older number are stale.
+    std::atomic<size_t> sequence_number;
 };
 
 enum class UnscheduleEventType {
@@ -140,12 +140,28 @@ public:
 
 private:
     struct Event;
+    struct PendingEvent;
 
     static void ThreadEntry(CoreTiming& instance);
     void ThreadLoop();
 
     void Reset();
 
+    /// Hands an event to the timer without taking any lock
+    void PushPendingEvent(Event&& new_event);
+
+    /// Moves the events scheduled since the last call into the queue, basic_lock must be held
+    void DrainPendingEvents();
+
+    /// Drops the events that were never drained
+    void ClearPendingList();
+
+    /// Returns the nodes from first to last to the pool PushPendingEvent takes them from
+    void RecyclePendingEvents(PendingEvent* first, PendingEvent* last);
+
+    /// Pops stale events off the top of the queue, basic_lock must be held
+    void PruneStaleEvents();
+
     std::unique_ptr<Common::WallClock> clock;
 
     s64 global_timer = 0;
@@ -154,11 +170,16 @@ private:
     s64 timer_resolution_ns;
 #endif
 
-    using heap_t =
-        boost::heap::fibonacci_heap<CoreTiming::Event, boost::heap::compare<std::greater<>>>;
+    /// Min-heap of events ordered by time, laid out as a flat 4-ary tree
+    std::vector<Event> event_queue;
+    std::atomic<u64> event_fifo_id = 0;
+
+    /// Lock-free list of events scheduled from any thread, drained when the timer advances
+    std::atomic<PendingEvent*> pending_events{};
 
-    heap_t event_queue;
-    u64 event_fifo_id = 0;
+    /// Nodes of drained events, reused so scheduling an event does not allocate
+    PendingEvent* free_pending_events{};
+    Common::SpinLock free_pending_lock;
 
     Common::Event event{};
     Common::Event pause_event{};
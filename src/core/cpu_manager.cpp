@@ -20,6 +20,28 @@ namespace Core {
 CpuManager::CpuManager(System& system_) : system{system_} {}
 CpuManager::~CpuManager() = default;
 
+void CpuManager::SetHostThreadPerGuestThread(bool enabled) {
+    if (!enabled) {
+        Common::Fiber::SetUseHostThreads(false);
+        return;
+    }
+
+    // Guest threads find their core and themselves through thread locals of the kernel, so carry
+    // them over from the scheduler thread that switched to them. Only one of the threads of a
+    // core runs at a time, the emulated scheduler still decides which one.
+    auto& kernel = system.Kernel();
+    Common::Fiber::HostThreadHandoff handoff;
+    handoff.save = [&kernel](Common::Fiber::HandoffState& state) {
+        state[0] = kernel.GetCurrentHostThreadID();
+        state[1] = reinterpret_cast<u64>(kernel.GetCurrentEmuThread());
+    };
+    handoff.restore = [&kernel](const Common::Fiber::HandoffState& state) {
+        kernel.TakeOverCoreThread(static_cast<std::size_t>(state[0]));
+        kernel.SetCurrentEmuThread(reinterpret_cast<Kernel::KThread*>(state[1]));
+    };
+    Common::Fiber::SetUseHostThreads(true, std::move(handoff));
+}
+
 void CpuManager::Initialize() {
     num_cores = is_multicore ? Core::Hardware::NUM_CPU_CORES : 1;
     gpu_barrier = std::make_unique<Common::Barrier>(num_cores + 1);
@@ -44,6 +44,10 @@ public:
         is_async_gpu = is_async;
     }
 
+    /// Sets if each guest thread runs on a host thread of its own instead of a fiber of a core
+    /// thread, must be set before the kernel is initialized
+    void SetHostThreadPerGuestThread(bool enabled);
+
     void OnGpuReady() {
         gpu_barrier->Sync();
     }
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/settings.h"
 #include "core/device_memory.h"
 #include "hle/kernel/board/nintendo/nx/k_system_control.h"
 
@@ -14,7 +15,11 @@ constexpr size_t VirtualReserveSize = 1ULL << 39;
 
 DeviceMemory::DeviceMemory()
     : buffer{Kernel::Board::Nintendo::Nx::KSystemControl::Init::GetIntendedMemorySize(),
-             VirtualReserveSize} {}
+             VirtualReserveSize} {
+    if (Settings::values.use_huge_pages.GetValue()) {
+        buffer.EnableHugePages();
+    }
+}
 
 DeviceMemory::~DeviceMemory() = default;
 
@@ -15,6 +15,10 @@
 #include "common/scratch_buffer.h"
 #include "common/virtual_buffer.h"
 
+namespace Common {
+class HostMemory;
+}
+
 namespace Core {
 
 constexpr size_t DEVICE_PAGEBITS = 12ULL;
@@ -150,6 +154,12 @@ private:
 
     void InnerGatherDeviceAddresses(Common::ScratchBuffer<u32>& buffer, PAddr address);
 
+    /// Returns true when every page of the range has physical memory behind it
+    bool IsRangeMapped(DAddr address, size_t size) const;
+
+    /// Mirrors the page table entries of the given pages into the fastmem view
+    void MapFastmem(size_t start_page, size_t num_pages);
+
     std::unique_ptr<DeviceMemoryManagerAllocator<Traits>> impl;
 
     const uintptr_t physical_base;
@@ -158,6 +168,11 @@ private:
     Common::VirtualBuffer<u32> compressed_device_addr;
     Common::VirtualBuffer<u32> continuity_tracker;
 
+    // Host mapping of the whole device address space, null when unavailable or disabled.
+    // Only block copies go through it, pointers handed out always point into the backing.
+    std::unique_ptr<Common::HostMemory> fastmem_view;
+    u8* fastmem_base{};
+
     // Process memory interfaces
 
     std::deque<size_t> id_pool;
@@ -179,6 +179,7 @@ public:
         if constexpr (!(FLAGS & GuestMemoryFlags::Read)) {
             if (!this->TrySetSpan()) {
                 if (backup) {
+                    backup->resize_destructive(this->size());
                     this->m_data_span = *backup;
                     this->m_span_valid = true;
                     this->m_is_data_copy = true;
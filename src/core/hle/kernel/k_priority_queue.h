@@ -160,6 +160,7 @@ public:
 
             if (m_queues[priority].PushBack(core, member)) {
                 m_available_priorities[core].SetBit(priority);
+                m_available_cores |= UINT64_C(1) << core;
             }
         }
 
@@ -173,6 +174,7 @@ public:
 
             if (m_queues[priority].PushFront(core, member)) {
                 m_available_priorities[core].SetBit(priority);
+                m_available_cores |= UINT64_C(1) << core;
             }
         }
 
@@ -186,9 +188,17 @@ public:
 
             if (m_queues[priority].Remove(core, member)) {
                 m_available_priorities[core].ClearBit(priority);
+                if (m_available_priorities[core].CountLeadingZero() > LowestPriority) {
+                    m_available_cores &= ~(UINT64_C(1) << core);
+                }
             }
         }
 
+        /// Returns a mask with a bit set for each core that has a member queued
+        constexpr u64 GetAvailableCores() const {
+            return m_available_cores;
+        }
+
         constexpr Member* GetFront(s32 core) const {
             ASSERT(IsValidCore(core));
 
@@ -251,6 +261,7 @@ public:
     private:
         std::array<KPerCoreQueue, NumPriority> m_queues{};
         std::array<Common::BitSet64<NumPriority>, NumCores> m_available_priorities{};
+        u64 m_available_cores{};
     };
 
 private:
@@ -337,6 +348,16 @@ public:
         return m_suggested_queue.GetFront(priority, core);
     }
 
+    /// Returns a mask of the cores that have a thread scheduled on them
+    constexpr u64 GetScheduledCores() const {
+        return m_scheduled_queue.GetAvailableCores();
+    }
+
+    /// Returns a mask of the cores that have a thread suggested for migration to them
+    constexpr u64 GetSuggestedCores() const {
+        return m_suggested_queue.GetAvailableCores();
+    }
+
     constexpr Member* GetScheduledNext(s32 core, const Member* member) const {
         return m_scheduled_queue.GetNext(core, member);
     }
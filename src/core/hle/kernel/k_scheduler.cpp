@@ -216,9 +216,12 @@ u64 KScheduler::UpdateHighestPriorityThreadsImpl(KernelCore& kernel) {
     auto& priority_queue = GetPriorityQueue(kernel);
 
     // We want to go over all cores, finding the highest priority thread and determining if
-    // scheduling is needed for that core.
+    // scheduling is needed for that core. Cores without scheduled threads skip the lookup.
+    const u64 scheduled_cores = priority_queue.GetScheduledCores();
     for (size_t core_id = 0; core_id < Core::Hardware::NUM_CPU_CORES; core_id++) {
-        KThread* top_thread = priority_queue.GetScheduledFront(static_cast<s32>(core_id));
+        KThread* top_thread = (scheduled_cores & (1ULL << core_id)) != 0
+                                  ? priority_queue.GetScheduledFront(static_cast<s32>(core_id))
+                                  : nullptr;
         if (top_thread != nullptr) {
             // We need to check if the thread's process has a pinned thread.
             if (KProcess* parent = top_thread->GetOwnerProcess()) {
@@ -247,6 +250,9 @@ u64 KScheduler::UpdateHighestPriorityThreadsImpl(KernelCore& kernel) {
     }
 
     // Idle cores are bad. We're going to try to migrate threads to each idle core in turn.
+    // Migrations only add suggestions to cores that weren't idle, so idle cores without a
+    // suggested thread can be dropped up front.
+    idle_cores &= priority_queue.GetSuggestedCores();
     while (idle_cores != 0) {
         const s32 core_id = static_cast<s32>(std::countr_zero(idle_cores));
 
@@ -1146,10 +1146,16 @@ Result KServerSession::ReceiveRequest(uintptr_t server_message, uintptr_t server
         }
         Core::Memory::Memory& memory{client_thread->GetOwnerProcess()->GetMemory()};
         u32* cmd_buf{reinterpret_cast<u32*>(memory.GetPointer(client_message))};
-        *out_context =
-            std::make_shared<Service::HLERequestContext>(m_kernel, memory, this, client_thread);
-        (*out_context)->SetSessionRequestManager(manager);
-        (*out_context)->PopulateFromIncomingCommandBuffer(cmd_buf);
+        auto& context = *out_context;
+        if (context && context.use_count() == 1 && &context->GetMemory() == &memory) {
+            // Recycle the context of the previous request, along with its storage
+            context->Reset(this, client_thread);
+        } else {
+            context =
+                std::make_shared<Service::HLERequestContext>(m_kernel, memory, this, client_thread);
+        }
+        context->SetSessionRequestManager(manager);
+        context->PopulateFromIncomingCommandBuffer(cmd_buf);
         // We succeeded.
         R_SUCCEED();
     } else {
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <boost/container/small_vector.hpp>
+
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/scratch_buffer.h"
@@ -76,7 +78,9 @@ Result KSynchronizationObject::Wait(KernelCore& kernel, s32* out_index,
                                     KSynchronizationObject** objects, const s32 num_objects,
                                     s64 timeout) {
     // Allocate space on stack for thread nodes.
-    std::array<ThreadListNode, Svc::ArgumentHandleCountMax> thread_nodes;
+    // HLE servers sharing host threads may wait on more objects than an SVC can pass.
+    boost::container::small_vector<ThreadListNode, Svc::ArgumentHandleCountMax> thread_nodes(
+        num_objects);
 
     // Prepare for wait.
     KThread* thread = GetCurrentThreadPointer(kernel);
@@ -43,6 +43,7 @@
 #include "core/hle/kernel/physical_core.h"
 #include "core/hle/result.h"
 #include "core/hle/service/server_manager.h"
+#include "core/hle/service/service_thread_pool.h"
 #include "core/hle/service/sm/sm.h"
 #include "core/memory.h"
 
@@ -187,6 +188,10 @@ struct KernelCore::Impl {
         // Ensures all servers gracefully shutdown.
         std::scoped_lock lk{server_lock};
         server_managers.clear();
+
+        // The servers let go of the pool when they are destroyed.
+        std::scoped_lock pl{service_thread_pool_lock};
+        service_thread_pool.reset();
     }
 
     void InitializePhysicalCores() {
@@ -395,6 +400,14 @@ struct KernelCore::Impl {
         }
     }
 
+    /// Makes the caller stand in for the CPU core thread of a core, for guest threads that run on
+    /// host threads of their own
+    void TakeOverCoreThread(std::size_t core_id) {
+        ASSERT(is_multicore);
+        ASSERT(core_id < Core::Hardware::NUM_CPU_CORES);
+        host_thread_id = static_cast<u8>(core_id);
+    }
+
     /// Registers a new host thread by allocating a host thread ID for it
     void RegisterHostThread(KThread* existing_thread) {
         [[maybe_unused]] const auto dummy_thread = GetHostDummyThread(existing_thread);
@@ -800,6 +813,10 @@ struct KernelCore::Impl {
     std::mutex server_lock;
     std::vector<std::unique_ptr<Service::ServerManager>> server_managers;
 
+    // Not guarded by server_lock, servers unregister from the pool while it is held.
+    std::mutex service_thread_pool_lock;
+    std::unique_ptr<Service::ServiceThreadPool> service_thread_pool;
+
     std::array<std::unique_ptr<Kernel::PhysicalCore>, Core::Hardware::NUM_CPU_CORES> cores;
 
     // Next host thead ID to use, 0-3 IDs represent core threads, >3 represent others
@@ -1013,6 +1030,14 @@ void KernelCore::RunServer(std::unique_ptr<Service::ServerManager>&& server_mana
     manager->LoopProcess();
 }
 
+Service::ServiceThreadPool& KernelCore::GetServiceThreadPool() {
+    std::scoped_lock lk{impl->service_thread_pool_lock};
+    if (!impl->service_thread_pool) {
+        impl->service_thread_pool = std::make_unique<Service::ServiceThreadPool>(impl->system);
+    }
+    return *impl->service_thread_pool;
+}
+
 u32 KernelCore::CreateNewObjectID() {
     return impl->next_object_id++;
 }
@@ -1033,6 +1058,10 @@ void KernelCore::RegisterCoreThread(std::size_t core_id) {
     impl->RegisterCoreThread(core_id);
 }
 
+void KernelCore::TakeOverCoreThread(std::size_t core_id) {
+    impl->TakeOverCoreThread(core_id);
+}
+
 void KernelCore::RegisterHostThread(KThread* existing_thread) {
     impl->RegisterHostThread(existing_thread);
 
@@ -30,7 +30,8 @@ struct EventType;
 
 namespace Service {
 class ServerManager;
-}
+class ServiceThreadPool;
+} // namespace Service
 
 namespace Service::SM {
 class ServiceManager;
@@ -192,6 +193,9 @@ public:
     // Runs the given server manager until shutdown.
     void RunServer(std::unique_ptr<Service::ServerManager>&& server_manager);
 
+    /// Gets the host threads shared by servers, creating them on first use.
+    Service::ServiceThreadPool& GetServiceThreadPool();
+
     /// Gets the current host_thread/guest_thread pointer.
     KThread* GetCurrentEmuThread() const;
 
@@ -204,6 +208,9 @@ public:
     /// Register the current thread as a CPU Core Thread.
     void RegisterCoreThread(std::size_t core_id);
 
+    /// Makes the current thread act as the CPU Core Thread of a core it was switched to from.
+    void TakeOverCoreThread(std::size_t core_id);
+
     /// Register the current thread as a non CPU core thread.
     void RegisterHostThread(KThread* existing_thread = nullptr);
 
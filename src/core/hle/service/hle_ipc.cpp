@@ -134,6 +134,39 @@ HLERequestContext::HLERequestContext(Kernel::KernelCore& kernel_, Core::Memory::
 
 HLERequestContext::~HLERequestContext() = default;
 
+void HLERequestContext::Reset(Kernel::KServerSession* session, Kernel::KThread* thread_) {
+    cmd_buf[0] = 0;
+    server_session = session;
+    client_handle_table = nullptr;
+    thread = thread_;
+
+    incoming_move_handles.clear();
+    incoming_copy_handles.clear();
+    outgoing_move_objects.clear();
+    outgoing_copy_objects.clear();
+    outgoing_domain_objects.clear();
+
+    command_header.reset();
+    handle_descriptor_header.reset();
+    data_payload_header.reset();
+    domain_message_header.reset();
+    buffer_x_descriptors.clear();
+    buffer_a_descriptors.clear();
+    buffer_b_descriptors.clear();
+    buffer_w_descriptors.clear();
+    buffer_c_descriptors.clear();
+
+    command = 0;
+    pid = 0;
+    write_size = 0;
+    data_payload_offset = 0;
+    handles_offset = 0;
+    domain_offset = 0;
+
+    manager.reset();
+    is_deferred = false;
+}
+
 void HLERequestContext::ParseCommandBuffer(u32_le* src_cmdbuf, bool incoming) {
     IPC::RequestParser rp(src_cmdbuf);
     command_header = rp.PopRaw<IPC::CommandHeader>();
@@ -335,28 +368,24 @@ std::vector<u8> HLERequestContext::ReadBufferCopy(std::size_t buffer_index) cons
 }
 
 std::span<const u8> HLERequestContext::ReadBufferA(std::size_t buffer_index) const {
-    Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> gm(memory, 0, 0);
-
     ASSERT_OR_EXECUTE_MSG(
         BufferDescriptorA().size() > buffer_index, { return {}; },
         "BufferDescriptorA invalid buffer_index {}", buffer_index);
-    return gm.Read(BufferDescriptorA()[buffer_index].Address(),
-                   BufferDescriptorA()[buffer_index].Size(), &read_buffer_data_a[buffer_index]);
+    return memory.GetContiguousSpan(BufferDescriptorA()[buffer_index].Address(),
+                                    BufferDescriptorA()[buffer_index].Size(),
+                                    read_buffer_data_a[buffer_index]);
 }
 
 std::span<const u8> HLERequestContext::ReadBufferX(std::size_t buffer_index) const {
-    Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> gm(memory, 0, 0);
-
     ASSERT_OR_EXECUTE_MSG(
         BufferDescriptorX().size() > buffer_index, { return {}; },
         "BufferDescriptorX invalid buffer_index {}", buffer_index);
-    return gm.Read(BufferDescriptorX()[buffer_index].Address(),
-                   BufferDescriptorX()[buffer_index].Size(), &read_buffer_data_x[buffer_index]);
+    return memory.GetContiguousSpan(BufferDescriptorX()[buffer_index].Address(),
+                                    BufferDescriptorX()[buffer_index].Size(),
+                                    read_buffer_data_x[buffer_index]);
 }
 
 std::span<const u8> HLERequestContext::ReadBuffer(std::size_t buffer_index) const {
-    Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> gm(memory, 0, 0);
-
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
     const bool is_buffer_x{BufferDescriptorX().size() > buffer_index &&
@@ -372,14 +401,16 @@ std::span<const u8> HLERequestContext::ReadBuffer(std::size_t buffer_index) cons
         ASSERT_OR_EXECUTE_MSG(
             BufferDescriptorA().size() > buffer_index, { return {}; },
             "BufferDescriptorA invalid buffer_index {}", buffer_index);
-        return gm.Read(BufferDescriptorA()[buffer_index].Address(),
-                       BufferDescriptorA()[buffer_index].Size(), &read_buffer_data_a[buffer_index]);
+        return memory.GetContiguousSpan(BufferDescriptorA()[buffer_index].Address(),
+                                        BufferDescriptorA()[buffer_index].Size(),
+                                        read_buffer_data_a[buffer_index]);
     } else {
         ASSERT_OR_EXECUTE_MSG(
             BufferDescriptorX().size() > buffer_index, { return {}; },
             "BufferDescriptorX invalid buffer_index {}", buffer_index);
-        return gm.Read(BufferDescriptorX()[buffer_index].Address(),
-                       BufferDescriptorX()[buffer_index].Size(), &read_buffer_data_x[buffer_index]);
+        return memory.GetContiguousSpan(BufferDescriptorX()[buffer_index].Address(),
+                                        BufferDescriptorX()[buffer_index].Size(),
+                                        read_buffer_data_x[buffer_index]);
     }
 }
 
@@ -483,6 +514,19 @@ std::size_t HLERequestContext::GetWriteBufferSize(std::size_t buffer_index) cons
     return 0;
 }
 
+VAddr HLERequestContext::GetWriteBufferAddress(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        return BufferDescriptorB()[buffer_index].Address();
+    } else {
+        ASSERT_OR_EXECUTE_MSG(
+            BufferDescriptorC().size() > buffer_index, { return 0; },
+            "BufferDescriptorC invalid buffer_index {}", buffer_index);
+        return BufferDescriptorC()[buffer_index].Address();
+    }
+}
+
 bool HLERequestContext::CanReadBuffer(std::size_t buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
                            BufferDescriptorA()[buffer_index].Size()};
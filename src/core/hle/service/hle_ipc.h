@@ -12,6 +12,8 @@
 #include <type_traits>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/concepts.h"
@@ -185,6 +187,12 @@ public:
                                Kernel::KServerSession* session, Kernel::KThread* thread);
     ~HLERequestContext();
 
+    /**
+     * Clears the context so it can hold a new request, keeping the storage it already allocated.
+     * Used to recycle the context of a session instead of creating one for each request.
+     */
+    void Reset(Kernel::KServerSession* session, Kernel::KThread* thread);
+
     /// Returns a pointer to the IPC command buffer for this request.
     [[nodiscard]] u32* CommandBuffer() {
         return cmd_buf.data();
@@ -233,20 +241,20 @@ public:
         return data_payload_offset;
     }
 
-    [[nodiscard]] const std::vector<IPC::BufferDescriptorX>& BufferDescriptorX() const {
-        return buffer_x_descriptors;
+    [[nodiscard]] std::span<const IPC::BufferDescriptorX> BufferDescriptorX() const {
+        return {buffer_x_descriptors.data(), buffer_x_descriptors.size()};
     }
 
-    [[nodiscard]] const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorA() const {
-        return buffer_a_descriptors;
+    [[nodiscard]] std::span<const IPC::BufferDescriptorABW> BufferDescriptorA() const {
+        return {buffer_a_descriptors.data(), buffer_a_descriptors.size()};
     }
 
-    [[nodiscard]] const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorB() const {
-        return buffer_b_descriptors;
+    [[nodiscard]] std::span<const IPC::BufferDescriptorABW> BufferDescriptorB() const {
+        return {buffer_b_descriptors.data(), buffer_b_descriptors.size()};
     }
 
-    [[nodiscard]] const std::vector<IPC::BufferDescriptorC>& BufferDescriptorC() const {
-        return buffer_c_descriptors;
+    [[nodiscard]] std::span<const IPC::BufferDescriptorC> BufferDescriptorC() const {
+        return {buffer_c_descriptors.data(), buffer_c_descriptors.size()};
     }
 
     [[nodiscard]] const IPC::DomainMessageHeader& GetDomainMessageHeader() const {
@@ -309,6 +317,9 @@ public:
     /// Helper function to get the size of the output buffer
     [[nodiscard]] std::size_t GetWriteBufferSize(std::size_t buffer_index = 0) const;
 
+    /// Helper function to get the guest address of the output buffer
+    [[nodiscard]] VAddr GetWriteBufferAddress(std::size_t buffer_index = 0) const;
+
     /// Helper function to derive the number of elements able to be contained in the read buffer
     template <typename T>
     [[nodiscard]] std::size_t GetReadBufferNumElements(std::size_t buffer_index = 0) const {
@@ -392,6 +403,10 @@ public:
 private:
     friend class IPC::ResponseBuilder;
 
+    /// Most requests carry a handful of descriptors and objects, they are stored inline
+    template <typename T>
+    using InlineVector = boost::container::small_vector<T, 4>;
+
     void ParseCommandBuffer(u32_le* src_cmdbuf, bool incoming);
 
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
@@ -399,22 +414,22 @@ private:
     Kernel::KHandleTable* client_handle_table{};
     Kernel::KThread* thread{};
 
-    std::vector<Handle> incoming_move_handles;
-    std::vector<Handle> incoming_copy_handles;
+    InlineVector<Handle> incoming_move_handles;
+    InlineVector<Handle> incoming_copy_handles;
 
-    std::vector<Kernel::KAutoObject*> outgoing_move_objects;
-    std::vector<Kernel::KAutoObject*> outgoing_copy_objects;
-    std::vector<SessionRequestHandlerPtr> outgoing_domain_objects;
+    InlineVector<Kernel::KAutoObject*> outgoing_move_objects;
+    InlineVector<Kernel::KAutoObject*> outgoing_copy_objects;
+    InlineVector<SessionRequestHandlerPtr> outgoing_domain_objects;
 
     std::optional<IPC::CommandHeader> command_header;
     std::optional<IPC::HandleDescriptorHeader> handle_descriptor_header;
     std::optional<IPC::DataPayloadHeader> data_payload_header;
     std::optional<IPC::DomainMessageHeader> domain_message_header;
-    std::vector<IPC::BufferDescriptorX> buffer_x_descriptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_a_descriptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_b_descriptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_w_descriptors;
-    std::vector<IPC::BufferDescriptorC> buffer_c_descriptors;
+    InlineVector<IPC::BufferDescriptorX> buffer_x_descriptors;
+    InlineVector<IPC::BufferDescriptorABW> buffer_a_descriptors;
+    InlineVector<IPC::BufferDescriptorABW> buffer_b_descriptors;
+    InlineVector<IPC::BufferDescriptorABW> buffer_w_descriptors;
+    InlineVector<IPC::BufferDescriptorC> buffer_c_descriptors;
 
     u32_le command{};
     u64 pid{};
@@ -0,0 +1,300 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/hle/service/hle_ipc.h"
+#include "core/hle/service/ipc_profiler.h"
+
+namespace Service::IpcProfiler {
+
+namespace {
+
+constexpr size_t TABLE_BITS = 10;
+constexpr size_t TABLE_SIZE = size_t{1} << TABLE_BITS;
+
+/// Counters are only written by the thread owning the table, so plain stores are enough
+void Add(std::atomic<u64>& counter, u64 value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+struct Entry {
+    /// (service_id + 1) << 32 | command, zero marks an empty slot
+    std::atomic<u64> key;
+    std::atomic<const char*> function_name;
+    std::atomic<u64> calls;
+    std::atomic<u64> total_ns;
+    std::atomic<u64> max_ns;
+    std::atomic<u64> read_bytes;
+    std::atomic<u64> write_bytes;
+    std::array<std::atomic<u64>, HISTOGRAM_BUCKETS> histogram;
+};
+
+struct ThreadTable {
+    std::array<Entry, TABLE_SIZE> entries{};
+    std::atomic<u64> dropped_calls{};
+
+    Entry* Find(u64 key) {
+        size_t index = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> (64 - TABLE_BITS));
+        for (size_t probe = 0; probe < TABLE_SIZE; ++probe) {
+            Entry& entry = entries[index];
+            const u64 slot_key = entry.key.load(std::memory_order_relaxed);
+            if (slot_key == key) {
+                return &entry;
+            }
+            if (slot_key == 0) {
+                return nullptr;
+            }
+            index = (index + 1) % TABLE_SIZE;
+        }
+        return nullptr;
+    }
+
+    Entry* Insert(u64 key, const char* function_name) {
+        size_t index = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> (64 - TABLE_BITS));
+        for (size_t probe = 0; probe < TABLE_SIZE; ++probe) {
+            Entry& entry = entries[index];
+            if (entry.key.load(std::memory_order_relaxed) == 0) {
+                entry.function_name.store(function_name, std::memory_order_relaxed);
+                // Publish the key last, readers skip slots without a key
+                entry.key.store(key, std::memory_order_release);
+                return &entry;
+            }
+            index = (index + 1) % TABLE_SIZE;
+        }
+        return nullptr;
+    }
+};
+
+struct Registry {
+    std::atomic_bool enabled{};
+
+    std::mutex mutex;
+    std::unordered_map<std::string, u32> service_ids;
+    std::deque<std::string> service_names;
+    std::vector<std::shared_ptr<ThreadTable>> tables;
+};
+
+Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+ThreadTable& GetThreadTable() {
+    // Tables are shared with the registry so the statistics survive their thread
+    thread_local std::shared_ptr<ThreadTable> table = [] {
+        auto new_table = std::make_shared<ThreadTable>();
+        Registry& registry = GetRegistry();
+        std::scoped_lock lk{registry.mutex};
+        registry.tables.push_back(new_table);
+        return new_table;
+    }();
+    return *table;
+}
+
+size_t GetBucket(u64 duration_ns) {
+    const size_t bucket = static_cast<size_t>(std::bit_width(duration_ns >> 10));
+    return std::min(bucket, HISTOGRAM_BUCKETS - 1);
+}
+
+u64 SumSizes(const auto& descriptors) {
+    u64 size = 0;
+    for (const auto& descriptor : descriptors) {
+        size += descriptor.Size();
+    }
+    return size;
+}
+
+u64 DroppedCalls() {
+    Registry& registry = GetRegistry();
+    std::scoped_lock lk{registry.mutex};
+    u64 dropped = 0;
+    for (const auto& table : registry.tables) {
+        dropped += table->dropped_calls.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+} // Anonymous namespace
+
+void SetEnabled(bool enabled) {
+    GetRegistry().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool IsEnabled() {
+    return GetRegistry().enabled.load(std::memory_order_relaxed);
+}
+
+u32 RegisterService(std::string_view service_name) {
+    Registry& registry = GetRegistry();
+    std::scoped_lock lk{registry.mutex};
+    const auto [it, is_new] = registry.service_ids.try_emplace(
+        std::string(service_name), static_cast<u32>(registry.service_names.size()));
+    if (is_new) {
+        registry.service_names.emplace_back(service_name);
+    }
+    return it->second;
+}
+
+void Record(u32 service_id, u32 command, const char* function_name, u64 duration_ns,
+            u64 read_bytes, u64 write_bytes) {
+    ThreadTable& table = GetThreadTable();
+    const u64 key = (u64{service_id} + 1) << 32 | command;
+    Entry* entry = table.Find(key);
+    if (!entry) {
+        entry = table.Insert(key, function_name);
+        if (!entry) {
+            Add(table.dropped_calls, 1);
+            return;
+        }
+    }
+    Add(entry->calls, 1);
+    Add(entry->total_ns, duration_ns);
+    Add(entry->read_bytes, read_bytes);
+    Add(entry->write_bytes, write_bytes);
+    Add(entry->histogram[GetBucket(duration_ns)], 1);
+    if (duration_ns > entry->max_ns.load(std::memory_order_relaxed)) {
+        entry->max_ns.store(duration_ns, std::memory_order_relaxed);
+    }
+}
+
+std::vector<CommandStats> Snapshot() {
+    Registry& registry = GetRegistry();
+    std::map<u64, CommandStats> merged;
+    {
+        std::scoped_lock lk{registry.mutex};
+        for (const auto& table : registry.tables) {
+            for (const Entry& entry : table->entries) {
+                const u64 key = entry.key.load(std::memory_order_acquire);
+                const u64 calls = entry.calls.load(std::memory_order_relaxed);
+                if (key == 0 || calls == 0) {
+                    continue;
+                }
+                CommandStats& stats = merged[key];
+                if (stats.calls == 0) {
+                    const char* const function_name =
+                        entry.function_name.load(std::memory_order_relaxed);
+                    stats.service_name = registry.service_names[(key >> 32) - 1];
+                    stats.function_name = function_name ? function_name : "";
+                    stats.command = static_cast<u32>(key);
+                }
+                stats.calls += calls;
+                stats.total_ns += entry.total_ns.load(std::memory_order_relaxed);
+                stats.max_ns = std::max(stats.max_ns, entry.max_ns.load(std::memory_order_relaxed));
+                stats.read_bytes += entry.read_bytes.load(std::memory_order_relaxed);
+                stats.write_bytes += entry.write_bytes.load(std::memory_order_relaxed);
+                for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+                    stats.histogram[bucket] +=
+                        entry.histogram[bucket].load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+    std::vector<CommandStats> result;
+    result.reserve(merged.size());
+    for (auto& [key, stats] : merged) {
+        result.push_back(std::move(stats));
+    }
+    std::ranges::stable_sort(result, std::ranges::greater{}, &CommandStats::total_ns);
+    return result;
+}
+
+bool DumpJson(const std::filesystem::path& path) {
+    using nlohmann::json;
+
+    json limits = json::array();
+    for (size_t bucket = 0; bucket + 1 < HISTOGRAM_BUCKETS; ++bucket) {
+        limits.push_back(BucketLimit(bucket));
+    }
+    json commands = json::array();
+    for (const CommandStats& stats : Snapshot()) {
+        commands.push_back({
+            {"service", stats.service_name},
+            {"command", stats.command},
+            {"function", stats.function_name},
+            {"calls", stats.calls},
+            {"total_ns", stats.total_ns},
+            {"mean_ns", stats.total_ns / stats.calls},
+            {"max_ns", stats.max_ns},
+            {"read_bytes", stats.read_bytes},
+            {"write_bytes", stats.write_bytes},
+            {"histogram", stats.histogram},
+        });
+    }
+    const json out{
+        {"histogram_limits_ns", std::move(limits)},
+        {"dropped_calls", DroppedCalls()},
+        {"commands", std::move(commands)},
+    };
+
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(Service, "Failed to create path for '{}' to save the IPC profile",
+                  Common::FS::PathToUTF8String(path));
+        return false;
+    }
+    std::ofstream file;
+    Common::FS::OpenFileStream(file, path, std::ios_base::out | std::ios_base::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR(Service, "Failed to open '{}' to save the IPC profile",
+                  Common::FS::PathToUTF8String(path));
+        return false;
+    }
+    file << std::setw(4) << out << std::endl;
+    return file.good();
+}
+
+void Reset() {
+    Registry& registry = GetRegistry();
+    std::scoped_lock lk{registry.mutex};
+    for (const auto& table : registry.tables) {
+        // Keys are kept, the owning threads may be probing through them
+        for (Entry& entry : table->entries) {
+            entry.calls.store(0, std::memory_order_relaxed);
+            entry.total_ns.store(0, std::memory_order_relaxed);
+            entry.max_ns.store(0, std::memory_order_relaxed);
+            entry.read_bytes.store(0, std::memory_order_relaxed);
+            entry.write_bytes.store(0, std::memory_order_relaxed);
+            for (auto& bucket : entry.histogram) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+        table->dropped_calls.store(0, std::memory_order_relaxed);
+    }
+}
+
+ScopedCall::ScopedCall(u32 service_id_, const HLERequestContext& ctx_, const char* function_name_)
+    : ctx{ctx_}, function_name{function_name_}, service_id{service_id_}, enabled{IsEnabled()} {
+    if (enabled) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedCall::~ScopedCall() {
+    if (!enabled) {
+        return;
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+    const u64 duration_ns =
+        static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    const u64 read_bytes = SumSizes(ctx.BufferDescriptorA()) + SumSizes(ctx.BufferDescriptorX());
+    const u64 write_bytes = SumSizes(ctx.BufferDescriptorB()) + SumSizes(ctx.BufferDescriptorC());
+    Record(service_id, ctx.GetCommand(), function_name, duration_ns, read_bytes, write_bytes);
+}
+
+} // namespace Service::IpcProfiler
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Service {
+class HLERequestContext;
+}
+
+/**
+ * Per service command statistics of the HLE IPC dispatch. Every thread that dispatches requests
+ * records into a table of its own, so recording takes no locks and shares no cache lines.
+ * Tables are only merged when a snapshot is taken. Recording is disabled by default.
+ */
+namespace Service::IpcProfiler {
+
+/// Number of host time histogram buckets, the last one also holds every slower call
+constexpr size_t HISTOGRAM_BUCKETS = 16;
+
+/// Bucket i holds the calls that took less than (1024 << i) nanoseconds
+constexpr u64 BucketLimit(size_t bucket) {
+    return u64{1024} << bucket;
+}
+
+struct CommandStats {
+    std::string service_name;
+    std::string function_name;
+    u32 command{};
+    u64 calls{};
+    u64 total_ns{};
+    u64 max_ns{};
+    u64 read_bytes{};
+    u64 write_bytes{};
+    std::array<u64, HISTOGRAM_BUCKETS> histogram{};
+};
+
+/// Starts or stops recording. Statistics recorded so far are kept.
+void SetEnabled(bool enabled);
+
+[[nodiscard]] bool IsEnabled();
+
+/// Returns the identifier of a service name, services sharing a name share an identifier
+[[nodiscard]] u32 RegisterService(std::string_view service_name);
+
+/**
+ * Accounts a single dispatched command to the calling thread's table.
+ * The function name must outlive the profiler, handler tables use string literals.
+ */
+void Record(u32 service_id, u32 command, const char* function_name, u64 duration_ns,
+            u64 read_bytes, u64 write_bytes);
+
+/// Merges the tables of every thread, sorted by total host time in descending order
+[[nodiscard]] std::vector<CommandStats> Snapshot();
+
+/// Writes a snapshot as JSON to the given path, returns false when the file can't be written
+bool DumpJson(const std::filesystem::path& path);
+
+/// Clears the statistics of every thread
+void Reset();
+
+/// Measures a request from construction to destruction, does nothing while disabled
+class ScopedCall {
+public:
+    explicit ScopedCall(u32 service_id_, const HLERequestContext& ctx_,
+                        const char* function_name_);
+    ~ScopedCall();
+
+    ScopedCall(const ScopedCall&) = delete;
+    ScopedCall& operator=(const ScopedCall&) = delete;
+
+private:
+    const HLERequestContext& ctx;
+    const char* function_name;
+    u32 service_id;
+    bool enabled;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace Service::IpcProfiler
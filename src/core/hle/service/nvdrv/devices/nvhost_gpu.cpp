@@ -2,6 +2,9 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <cstring>
+
+#include <boost/container/small_vector.hpp>
+
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/core.h"
@@ -251,13 +254,16 @@ NvResult nvhost_gpu::SubmitGPFIFOImpl(IoctlSubmitGpfifo& params, Tegra::CommandL
 
     auto& flags = params.flags;
 
+    // The lists of a submission reach the GPU thread together, so it is woken once for them
+    boost::container::small_vector<Tegra::CommandList, 3> lists;
+
     if (flags.fence_wait.Value()) {
         if (flags.increment_value.Value()) {
             return NvResult::BadParameter;
         }
 
         if (!syncpoint_manager.IsFenceSignalled(params.fence)) {
-            gpu.PushGPUEntries(bind_id, Tegra::CommandList{BuildWaitCommandList(params.fence)});
+            lists.emplace_back(BuildWaitCommandList(params.fence));
         }
     }
 
@@ -266,17 +272,16 @@ NvResult nvhost_gpu::SubmitGPFIFOImpl(IoctlSubmitGpfifo& params, Tegra::CommandL
     u32 increment{(flags.fence_increment.Value() != 0 ? 2 : 0) +
                   (flags.increment_value.Value() != 0 ? params.fence.value : 0)};
     params.fence.value = syncpoint_manager.IncrementSyncpointMaxExt(channel_syncpoint, increment);
-    gpu.PushGPUEntries(bind_id, std::move(entries));
+    lists.push_back(std::move(entries));
 
     if (flags.fence_increment.Value()) {
         if (flags.suppress_wfi.Value()) {
-            gpu.PushGPUEntries(bind_id,
-                               Tegra::CommandList{BuildIncrementCommandList(params.fence)});
+            lists.emplace_back(BuildIncrementCommandList(params.fence));
         } else {
-            gpu.PushGPUEntries(bind_id,
-                               Tegra::CommandList{BuildIncrementWithWfiCommandList(params.fence)});
+            lists.emplace_back(BuildIncrementWithWfiCommandList(params.fence));
         }
     }
+    gpu.PushGPUEntries(bind_id, std::span(lists.data(), lists.size()));
 
     flags.raw = 0;
 
@@ -2,6 +2,9 @@
 // SPDX-FileCopyrightText: 2021 Skyline Team and Contributors
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <optional>
+#include <span>
+
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
 #include "common/string_util.h"
@@ -13,9 +16,43 @@
 #include "core/hle/service/nvdrv/nvdata.h"
 #include "core/hle/service/nvdrv/nvdrv.h"
 #include "core/hle/service/nvdrv/nvdrv_interface.h"
+#include "core/memory.h"
 
 namespace Service::Nvidia {
 
+namespace {
+
+using GuestOutput =
+    Core::Memory::CpuGuestMemoryScoped<u8, Core::Memory::GuestMemoryFlags::SafeWrite>;
+
+/// Output buffer of an ioctl. Outputs that are copied back to the guest are written in place when
+/// the guest buffer is contiguous in host memory, the scratch buffer stages everything else.
+class IoctlOutput {
+public:
+    explicit IoctlOutput(HLERequestContext& ctx, Ioctl command, std::size_t buffer_index,
+                         Common::ScratchBuffer<u8>& scratch) {
+        const std::size_t size = ctx.GetWriteBufferSize(buffer_index);
+        if (command.is_out != 0 && size != 0) {
+            guest.emplace(ctx.GetMemory(), ctx.GetWriteBufferAddress(buffer_index), size,
+                          &scratch);
+            span = std::span<u8>(guest->data(), guest->size());
+        } else {
+            scratch.resize_destructive(size);
+            span = scratch;
+        }
+    }
+
+    [[nodiscard]] std::span<u8> Span() const noexcept {
+        return span;
+    }
+
+private:
+    std::optional<GuestOutput> guest; ///< Writes the output back when it goes out of scope
+    std::span<u8> span;
+};
+
+} // Anonymous namespace
+
 void NVDRV::Open(HLERequestContext& ctx) {
     LOG_DEBUG(Service_NVDRV, "called");
     IPC::ResponseBuilder rb{ctx, 4};
@@ -65,13 +102,10 @@ void NVDRV::Ioctl1(HLERequestContext& ctx) {
     }
 
     // Check device
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
+    IoctlOutput output{ctx, command, 0, output_buffer};
     const auto input_buffer = ctx.ReadBuffer(0);
 
-    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output_buffer);
-    if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
-    }
+    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output.Span());
 
     IPC::ResponseBuilder rb{ctx, 3};
     rb.Push(ResultSuccess);
@@ -92,13 +126,10 @@ void NVDRV::Ioctl2(HLERequestContext& ctx) {
 
     const auto input_buffer = ctx.ReadBuffer(0);
     const auto input_inlined_buffer = ctx.ReadBuffer(1);
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
+    IoctlOutput output{ctx, command, 0, output_buffer};
 
     const auto nv_result =
-        nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output_buffer);
-    if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
-    }
+        nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output.Span());
 
     IPC::ResponseBuilder rb{ctx, 3};
     rb.Push(ResultSuccess);
@@ -118,15 +149,12 @@ void NVDRV::Ioctl3(HLERequestContext& ctx) {
     }
 
     const auto input_buffer = ctx.ReadBuffer(0);
-    output_buffer.resize_destructive(ctx.GetWriteBufferSize(0));
-    inline_output_buffer.resize_destructive(ctx.GetWriteBufferSize(1));
+    // Declared in reverse so staged outputs are written back in buffer order
+    IoctlOutput inline_output{ctx, command, 1, inline_output_buffer};
+    IoctlOutput output{ctx, command, 0, output_buffer};
 
     const auto nv_result =
-        nvdrv->Ioctl3(fd, command, input_buffer, output_buffer, inline_output_buffer);
-    if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer, 0);
-        ctx.WriteBuffer(inline_output_buffer, 1);
-    }
+        nvdrv->Ioctl3(fd, command, input_buffer, output.Span(), inline_output.Span());
 
     IPC::ResponseBuilder rb{ctx, 3};
     rb.Push(ResultSuccess);
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <boost/container/small_vector.hpp>
+
 #include "core/hle/kernel/k_hardware_timer.h"
 #include "core/hle/kernel/k_synchronization_object.h"
 #include "core/hle/kernel/kernel.h"
@@ -48,6 +50,27 @@ MultiWaitHolder* MultiWait::TimedWaitImpl(Kernel::KernelCore& kernel, s64 timeou
     }
 }
 
+MultiWaitHolder* MultiWait::WaitAny(Kernel::KernelCore& kernel,
+                                    std::span<MultiWaitHolder* const> holders) {
+    boost::container::small_vector<Kernel::KSynchronizationObject*,
+                                   Kernel::Svc::ArgumentHandleCountMax>
+        objects;
+    objects.reserve(holders.size());
+    for (MultiWaitHolder* const holder : holders) {
+        objects.push_back(holder->GetNativeHandle());
+    }
+
+    s32 out_index = -1;
+    Kernel::KSynchronizationObject::Wait(kernel, std::addressof(out_index), objects.data(),
+                                         static_cast<s32>(objects.size()), -1);
+
+    if (out_index == -1) {
+        return nullptr;
+    } else {
+        return holders[out_index];
+    }
+}
+
 void MultiWait::MoveAll(MultiWait* other) {
     while (!other->m_wait_list.empty()) {
         MultiWaitHolder& holder = other->m_wait_list.front();
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <span>
+
 #include "core/hle/service/os/multi_wait_holder.h"
 
 namespace Kernel {
@@ -22,8 +24,19 @@ public:
     MultiWaitHolder* TimedWaitAny(Kernel::KernelCore& kernel, s64 timeout_ns);
     // TODO: SdkReplyAndReceive?
 
+    /// Waits on holders gathered from several lists, there may be more than an SVC accepts
+    static MultiWaitHolder* WaitAny(Kernel::KernelCore& kernel,
+                                    std::span<MultiWaitHolder* const> holders);
+
     void MoveAll(MultiWait* other);
 
+    template <typename Func>
+    void ForEachHolder(Func&& func) {
+        for (MultiWaitHolder& holder : m_wait_list) {
+            func(std::addressof(holder));
+        }
+    }
+
 private:
     MultiWaitHolder* TimedWaitImpl(Kernel::KernelCore& kernel, s64 timeout_tick);
 
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "common/scope_exit.h"
+#include "common/settings.h"
 
 #include "core/core.h"
 #include "core/hle/kernel/k_client_port.h"
@@ -12,10 +13,12 @@
 #include "core/hle/kernel/k_server_port.h"
 #include "core/hle/kernel/k_server_session.h"
 #include "core/hle/kernel/k_synchronization_object.h"
+#include "core/hle/kernel/k_thread.h"
 #include "core/hle/kernel/svc_results.h"
 #include "core/hle/service/hle_ipc.h"
 #include "core/hle/service/ipc_helpers.h"
 #include "core/hle/service/server_manager.h"
+#include "core/hle/service/service_thread_pool.h"
 #include "core/hle/service/sm/sm.h"
 
 namespace Service {
@@ -81,6 +84,10 @@ ServerManager::ServerManager(Core::System& system) : m_system{system}, m_selecti
     // Link to holder.
     m_wakeup_holder.emplace(std::addressof(m_wakeup_event->GetReadableEvent()));
     m_wakeup_holder->LinkToMultiWait(std::addressof(m_deferred_list));
+
+    // Servers on guest cores keep being scheduled by the emulated kernel.
+    m_use_thread_pool = Settings::values.use_shared_service_threads.GetValue() &&
+                        Kernel::GetCurrentThread(system.Kernel()).IsDummyThread();
 }
 
 ServerManager::~ServerManager() {
@@ -91,6 +98,9 @@ ServerManager::~ServerManager() {
     // Wait for processing to stop.
     m_stopped.Wait();
     m_threads.clear();
+    if (m_thread_pool) {
+        m_thread_pool->Unregister(this);
+    }
 
     // Clean up ports.
     auto port_it = m_servers.begin();
@@ -235,6 +245,12 @@ Result ServerManager::ManageDeferral(Kernel::KEvent** out_event) {
 }
 
 void ServerManager::StartAdditionalHostThreads(const char* name, size_t num_threads) {
+    if (m_use_thread_pool) {
+        // Let the pool process this many more requests of the server at once instead.
+        m_max_threads += num_threads;
+        return;
+    }
+
     for (size_t i = 0; i < num_threads; i++) {
         auto thread_name = fmt::format("{}:{}", name, i + 1);
         m_threads.emplace_back(m_system.Kernel().RunOnHostCoreThread(
@@ -247,9 +263,19 @@ Result ServerManager::LoopProcess() {
         m_stopped.Set();
     };
 
+    if (m_use_thread_pool) {
+        // The pool threads serve our requests from now on, so this thread can exit.
+        m_thread_pool = std::addressof(m_system.Kernel().GetServiceThreadPool());
+        m_thread_pool->Register(this);
+        R_SUCCEED();
+    }
     R_RETURN(this->LoopProcessImpl());
 }
 
+void ServerManager::KeepAlive(std::shared_ptr<void> object) {
+    m_kept_alive.push_back(std::move(object));
+}
+
 void ServerManager::LinkToDeferredList(MultiWaitHolder* holder) {
     // Link.
     {
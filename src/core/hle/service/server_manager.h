@@ -28,6 +28,7 @@ class KServerSession;
 namespace Service {
 
 class Port;
+class ServiceThreadPool;
 class Session;
 
 class ServerManager {
@@ -50,9 +51,15 @@ public:
     Result LoopProcess();
     void StartAdditionalHostThreads(const char* name, size_t num_threads);
 
+    /// Keeps an object alive as long as the server. The thread that runs the server exits early
+    /// when the server is served by the ServiceThreadPool, so state can't live on its stack.
+    void KeepAlive(std::shared_ptr<void> object);
+
     static void RunServer(std::unique_ptr<ServerManager>&& server);
 
 private:
+    friend class ServiceThreadPool;
+
     void LinkToDeferredList(MultiWaitHolder* holder);
     void LinkDeferred();
     MultiWaitHolder* WaitSignaled();
@@ -90,8 +97,12 @@ private:
 
     // Host state tracking
     Common::Event m_stopped{};
+    bool m_use_thread_pool{};
+    ServiceThreadPool* m_thread_pool{};
+    size_t m_max_threads{1};
     std::vector<std::jthread> m_threads{};
     std::stop_source m_stop_source{};
+    std::vector<std::shared_ptr<void>> m_kept_alive{};
 };
 
 } // namespace Service
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "common/assert.h"
+#include "common/common_types.h"
+
+namespace Service {
+
+/**
+ * Tracks how many requests of each server the shared service threads are processing, so no
+ * server gets more threads than it asked for. Not thread safe, the owner serializes access.
+ */
+template <typename Server>
+class ServerThreadSlots {
+public:
+    /// Starts tracking a server that may process up to max_threads requests at once
+    void Add(Server* server, size_t max_threads) {
+        ASSERT(max_threads > 0 && !this->Contains(server));
+        m_entries.push_back(Entry{server, max_threads, 0, false});
+    }
+
+    /// Stops handing out slots of a server, it is forgotten once its requests are released
+    void Remove(Server* server) {
+        const auto it = this->Find(server);
+        ASSERT(it != m_entries.end() && !it->removed);
+        it->removed = true;
+        if (it->active_threads == 0) {
+            m_entries.erase(it);
+        }
+    }
+
+    /// Takes a slot of a registered server, fails if it is processing max_threads requests
+    [[nodiscard]] bool TryAcquire(Server* server) {
+        const auto it = this->Find(server);
+        if (it == m_entries.end() || it->removed || it->active_threads >= it->max_threads) {
+            return false;
+        }
+        ++it->active_threads;
+        return true;
+    }
+
+    /// Returns a slot of a server, returns true if the server was using all of its slots
+    bool Release(Server* server) {
+        const auto it = this->Find(server);
+        ASSERT(it != m_entries.end() && it->active_threads > 0);
+        const bool was_busy = it->active_threads-- == it->max_threads;
+        if (it->removed && it->active_threads == 0) {
+            m_entries.erase(it);
+        }
+        return was_busy;
+    }
+
+    /// Returns true while a server is tracked, including removed ones with requests in flight
+    [[nodiscard]] bool Contains(const Server* server) const {
+        return std::ranges::any_of(m_entries,
+                                   [server](const Entry& entry) { return entry.server == server; });
+    }
+
+    /// Returns true if a server is processing max_threads requests
+    [[nodiscard]] bool IsBusy(const Server* server) const {
+        return std::ranges::any_of(m_entries, [server](const Entry& entry) {
+            return entry.server == server && entry.active_threads >= entry.max_threads;
+        });
+    }
+
+    /// Calls func with each server that was added and not removed
+    template <typename Func>
+    void ForEachRegistered(Func&& func) const {
+        for (const Entry& entry : m_entries) {
+            if (!entry.removed) {
+                func(entry.server);
+            }
+        }
+    }
+
+    /**
+     * Returns how many threads are needed to serve the tracked servers on a host with the given
+     * thread count. A server may block every thread it has in host calls (bsdsocket waits on
+     * host sockets), so there is always one thread more than the largest server can hold.
+     */
+    [[nodiscard]] size_t NumThreads(size_t host_threads) const {
+        size_t requested_threads{};
+        size_t largest_server{};
+        for (const Entry& entry : m_entries) {
+            requested_threads += entry.max_threads;
+            largest_server = std::max(largest_server, entry.max_threads);
+        }
+        return std::min(requested_threads, std::max(host_threads, largest_server + 1));
+    }
+
+private:
+    struct Entry {
+        Server* server;
+        size_t max_threads;
+        size_t active_threads;
+        bool removed;
+    };
+
+    auto Find(const Server* server) {
+        return std::ranges::find(m_entries, server, &Entry::server);
+    }
+
+    std::vector<Entry> m_entries;
+};
+
+} // namespace Service
@@ -9,6 +9,7 @@
 #include "core/hle/ipc.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/service/ipc_helpers.h"
+#include "core/hle/service/ipc_profiler.h"
 #include "core/hle/service/service.h"
 #include "core/hle/service/sm/sm.h"
 #include "core/reporter.h"
@@ -35,7 +36,9 @@ namespace Service {
 ServiceFrameworkBase::ServiceFrameworkBase(Core::System& system_, const char* service_name_,
                                            u32 max_sessions_, InvokerFn* handler_invoker_)
     : SessionRequestHandler(system_.Kernel(), service_name_), system{system_},
-      service_name{service_name_}, max_sessions{max_sessions_}, handler_invoker{handler_invoker_} {}
+      service_name{service_name_}, max_sessions{max_sessions_},
+      profiler_id{IpcProfiler::RegisterService(service_name_)},
+      handler_invoker{handler_invoker_} {}
 
 ServiceFrameworkBase::~ServiceFrameworkBase() {
     // Wait for other threads to release access before destroying
@@ -86,6 +89,7 @@ void ServiceFrameworkBase::ReportUnimplementedFunction(HLERequestContext& ctx,
 void ServiceFrameworkBase::InvokeRequest(HLERequestContext& ctx) {
     auto itr = handlers.find(ctx.GetCommand());
     const FunctionInfoBase* info = itr == handlers.end() ? nullptr : &itr->second;
+    const IpcProfiler::ScopedCall profile{profiler_id, ctx, info ? info->name : nullptr};
     if (info == nullptr || info->handler_callback == nullptr) {
         return ReportUnimplementedFunction(ctx, info);
     }
@@ -100,6 +104,7 @@ void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
     itr = handlers_tipc.find(ctx.GetCommand());
 
     const FunctionInfoBase* info = itr == handlers_tipc.end() ? nullptr : &itr->second;
+    const IpcProfiler::ScopedCall profile{profiler_id, ctx, info ? info->name : nullptr};
     if (info == nullptr || info->handler_callback == nullptr) {
         return ReportUnimplementedFunction(ctx, info);
     }
@@ -108,6 +108,9 @@ private:
     /// Maximum number of concurrent sessions that this service can handle.
     u32 max_sessions;
 
+    /// Identifier of the service name in the IPC profiler.
+    u32 profiler_id;
+
     /// Flag to store if a port was already create/installed to detect multiple install attempts,
     /// which is not supported.
     bool service_registered = false;
@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "core/core.h"
+#include "core/hle/kernel/k_event.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/result.h"
+#include "core/hle/service/os/multi_wait.h"
+#include "core/hle/service/server_manager.h"
+#include "core/hle/service/service_thread_pool.h"
+
+namespace Service {
+
+ServiceThreadPool::ServiceThreadPool(Core::System& system)
+    : m_system{system}, m_selection_mutex{system} {
+    // Initialize event.
+    m_wakeup_event = Kernel::KEvent::Create(system.Kernel());
+    m_wakeup_event->Initialize(nullptr);
+
+    // Register event.
+    Kernel::KEvent::Register(system.Kernel(), m_wakeup_event);
+
+    m_wakeup_holder.emplace(std::addressof(m_wakeup_event->GetReadableEvent()));
+}
+
+ServiceThreadPool::~ServiceThreadPool() {
+    // Signal stop.
+    m_stop_source.request_stop();
+    m_wakeup_event->Signal();
+
+    // Wait for the threads to exit.
+    m_threads.clear();
+
+    // Close wakeup event.
+    m_wakeup_event->GetReadableEvent().Close();
+    m_wakeup_event->Close();
+}
+
+void ServiceThreadPool::Register(ServerManager* manager) {
+    {
+        std::scoped_lock lk{m_managers_mutex};
+        m_slots.Add(manager, manager->m_max_threads);
+
+        const size_t host_threads = std::max(std::thread::hardware_concurrency(), 1U);
+        const size_t num_threads = m_slots.NumThreads(host_threads);
+        while (m_threads.size() < num_threads) {
+            auto thread_name = fmt::format("ServicePool:{}", m_threads.size() + 1);
+            m_threads.emplace_back(m_system.Kernel().RunOnHostCoreProcess(
+                std::move(thread_name), [this] { this->LoopProcess(); }));
+        }
+    }
+
+    // Make the waiting thread include the new server.
+    m_wakeup_event->Signal();
+}
+
+void ServiceThreadPool::Unregister(ServerManager* manager) {
+    std::unique_lock lk{m_managers_mutex};
+    m_slots.Remove(manager);
+    const u64 generation = ++m_generation;
+    lk.unlock();
+
+    // Make the waiting thread drop the objects of the server.
+    m_wakeup_event->Signal();
+
+    lk.lock();
+    m_released.wait(lk, [&] {
+        return m_waiting_generation >= generation && !m_slots.Contains(manager);
+    });
+}
+
+void ServiceThreadPool::LoopProcess() {
+    while (const auto selection = this->WaitSignaled()) {
+        R_ASSERT(selection->manager->Process(selection->holder));
+        this->FinishProcessing(selection->manager);
+    }
+}
+
+std::optional<ServiceThreadPool::Selection> ServiceThreadPool::WaitSignaled() {
+    // Ensure we are the only thread waiting for the servers.
+    std::scoped_lock lk{m_selection_mutex};
+
+    std::vector<ServerManager*> managers;
+    std::vector<bool> busy;
+    std::vector<MultiWaitHolder*> holders;
+    std::vector<ServerManager*> owners;
+
+    while (true) {
+        // If we're done, return before we start waiting.
+        if (m_stop_source.stop_requested()) {
+            return std::nullopt;
+        }
+
+        // Take the servers to wait on, unregistering ones wait for this to let go of them.
+        {
+            std::scoped_lock ml{m_managers_mutex};
+            managers.clear();
+            busy.clear();
+            m_slots.ForEachRegistered([&](ServerManager* manager) {
+                managers.push_back(manager);
+                busy.push_back(m_slots.IsBusy(manager));
+            });
+            m_waiting_generation = m_generation;
+        }
+        m_released.notify_all();
+
+        holders.assign(1, std::addressof(*m_wakeup_holder));
+        owners.assign(1, nullptr);
+        for (size_t i = 0; i < managers.size(); ++i) {
+            ServerManager* const manager = managers[i];
+            if (manager->m_stop_source.stop_requested()) {
+                continue;
+            }
+            manager->LinkDeferred();
+
+            // Servers at their thread count only wake us up when they are done with a request.
+            if (busy[i]) {
+                holders.push_back(std::addressof(*manager->m_wakeup_holder));
+                owners.push_back(manager);
+                continue;
+            }
+            manager->m_multi_wait.ForEachHolder([&](MultiWaitHolder* holder) {
+                holders.push_back(holder);
+                owners.push_back(manager);
+            });
+        }
+
+        auto* const selected = MultiWait::WaitAny(m_system.Kernel(), holders);
+        const auto it = std::ranges::find(holders, selected);
+        if (it == holders.end() || selected == std::addressof(*m_wakeup_holder)) {
+            // Clear and restart if we were woken up.
+            m_wakeup_event->Clear();
+            continue;
+        }
+
+        ServerManager* const owner = owners[std::distance(holders.begin(), it)];
+        if (selected == std::addressof(*owner->m_wakeup_holder)) {
+            owner->m_wakeup_event->Clear();
+            continue;
+        }
+        {
+            std::scoped_lock ml{m_managers_mutex};
+            if (!m_slots.TryAcquire(owner)) {
+                // The server was unregistered while we were waiting.
+                continue;
+            }
+        }
+
+        // Unlink and handle the event.
+        selected->UnlinkFromMultiWait();
+        return Selection{owner, selected};
+    }
+}
+
+void ServiceThreadPool::FinishProcessing(ServerManager* manager) {
+    bool was_busy{};
+    {
+        std::scoped_lock lk{m_managers_mutex};
+        was_busy = m_slots.Release(manager);
+    }
+    m_released.notify_all();
+
+    // The server may be gone now, so wake the waiting thread up through our own event.
+    if (was_busy) {
+        m_wakeup_event->Signal();
+    }
+}
+
+} // namespace Service
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/polyfill_thread.h"
+#include "core/hle/service/os/multi_wait_holder.h"
+#include "core/hle/service/os/mutex.h"
+#include "core/hle/service/server_thread_slots.h"
+
+namespace Core {
+class System;
+}
+
+namespace Kernel {
+class KEvent;
+}
+
+namespace Service {
+
+class ServerManager;
+
+/**
+ * Host threads shared by the servers running on host cores. Instead of each server waiting on
+ * its own objects, the pool threads take turns waiting on the objects of every registered server
+ * and process whichever request is signaled first. A server never has more requests in flight
+ * than the thread count it asked for, so servers written for a single thread stay serialized.
+ * The thread that runs a server exits once the server is registered, the pool replaces it.
+ */
+class ServiceThreadPool {
+public:
+    explicit ServiceThreadPool(Core::System& system);
+    ~ServiceThreadPool();
+
+    /// Starts serving a server, growing the pool to the thread count the servers need
+    void Register(ServerManager* manager);
+
+    /// Stops serving a server, returns once no pool thread references it anymore
+    void Unregister(ServerManager* manager);
+
+private:
+    struct Selection {
+        ServerManager* manager;
+        MultiWaitHolder* holder;
+    };
+
+    void LoopProcess();
+    std::optional<Selection> WaitSignaled();
+    void FinishProcessing(ServerManager* manager);
+
+    Core::System& m_system;
+    Mutex m_selection_mutex;
+
+    Kernel::KEvent* m_wakeup_event{};
+    std::optional<MultiWaitHolder> m_wakeup_holder{};
+
+    std::mutex m_managers_mutex;
+    std::condition_variable m_released;
+    ServerThreadSlots<ServerManager> m_slots;
+    u64 m_generation{};
+    u64 m_waiting_generation{};
+
+    std::vector<std::jthread> m_threads;
+    std::stop_source m_stop_source;
+};
+
+} // namespace Service
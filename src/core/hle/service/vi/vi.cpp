@@ -23,7 +23,10 @@ void LoopProcess(Core::System& system, std::stop_token token) {
     server_manager->RegisterNamedService(
         "vi:u", std::make_shared<IApplicationRootService>(system, container));
 
-    std::stop_callback cb(token, [=] { container->OnTerminate(); });
+    // The server may outlive this thread, so it holds on to the callback.
+    const auto on_terminate = [=] { container->OnTerminate(); };
+    server_manager->KeepAlive(
+        std::make_shared<std::stop_callback<decltype(on_terminate)>>(token, on_terminate));
 
     ServerManager::RunServer(std::move(server_manager));
 }
@@ -63,6 +63,11 @@ struct Memory::Impl {
 #endif
     }
 
+    void SetCurrentPageTable(Common::PageTable& page_table) {
+        current_page_table = &page_table;
+        current_page_table->fastmem_arena = nullptr;
+    }
+
     void MapMemoryRegion(Common::PageTable& page_table, Common::ProcessAddress base, u64 size,
                          Common::PhysicalAddress target, Common::MemoryPermission perms,
                          bool separate_heap) {
@@ -335,20 +340,55 @@ struct Memory::Impl {
         return ReadBlockImpl<true>(src_addr, dest_buffer, size);
     }
 
-    const u8* GetSpan(const VAddr src_addr, const std::size_t size) const {
-        if (current_page_table->blocks[src_addr >> YUZU_PAGEBITS] ==
-            current_page_table->blocks[(src_addr + size) >> YUZU_PAGEBITS]) {
-            return GetPointerSilent(src_addr);
+    /**
+     * Returns the host pointer of a range when it is backed by contiguous host memory, or nullptr
+     * when any page is unmapped, debug memory or backed by a different physical block.
+     */
+    [[nodiscard]] u8* GetContiguousPointer(const Common::ProcessAddress src_addr,
+                                           const std::size_t size) const {
+        const auto& page_table = *current_page_table;
+        const u64 vaddr = GetInteger(src_addr);
+        if (size == 0 || !AddressSpaceContains(page_table, vaddr, size)) [[unlikely]] {
+            return nullptr;
         }
-        return nullptr;
+        // Pages store their physical address relative to the virtual page, a range is contiguous
+        // in host memory exactly when every page repeats the value of the first one.
+        const std::size_t first_page = vaddr >> YUZU_PAGEBITS;
+        const std::size_t last_page = (vaddr + size - 1) >> YUZU_PAGEBITS;
+        const u64 backing = page_table.backing_addr[first_page];
+        for (std::size_t page = first_page; page <= last_page; ++page) {
+            const auto type = page_table.pointers[page].Type();
+            if (type != Common::PageType::Memory &&
+                type != Common::PageType::RasterizerCachedMemory) {
+                return nullptr;
+            }
+            if (page_table.backing_addr[page] != backing) {
+                return nullptr;
+            }
+        }
+        return system.DeviceMemory().GetPointer<u8>(Common::PhysicalAddress{backing} + vaddr);
+    }
+
+    const u8* GetSpan(const VAddr src_addr, const std::size_t size) const {
+        return GetContiguousPointer(src_addr, size);
     }
 
     u8* GetSpan(const VAddr src_addr, const std::size_t size) {
-        if (current_page_table->blocks[src_addr >> YUZU_PAGEBITS] ==
-            current_page_table->blocks[(src_addr + size) >> YUZU_PAGEBITS]) {
-            return GetPointerSilent(src_addr);
+        return GetContiguousPointer(src_addr, size);
+    }
+
+    std::span<const u8> GetContiguousSpan(const Common::ProcessAddress src_addr,
+                                          const std::size_t size,
+                                          Common::ScratchBuffer<u8>& scratch) {
+        if (size == 0) {
+            return {};
         }
-        return nullptr;
+        if (const u8* const pointer = GetContiguousPointer(src_addr, size)) {
+            return {pointer, size};
+        }
+        scratch.resize_destructive(size);
+        ReadBlockUnsafe(src_addr, scratch.data(), size);
+        return scratch;
     }
 
     template <bool UNSAFE>
@@ -407,6 +447,15 @@ struct Memory::Impl {
             [](const std::size_t copy_amount) {});
     }
 
+    void InvalidateRegion(const Common::ProcessAddress dest_addr, const std::size_t size) {
+        WalkBlock(
+            dest_addr, size, [](const std::size_t, const Common::ProcessAddress) {},
+            [](const std::size_t, u8* const) {},
+            [&](const Common::ProcessAddress current_vaddr, const std::size_t copy_amount,
+                u8* const) { HandleRasterizerWrite(GetInteger(current_vaddr), copy_amount); },
+            [](const std::size_t) {});
+    }
+
     bool CopyBlock(Common::ProcessAddress dest_addr, Common::ProcessAddress src_addr,
                    const std::size_t size) {
         return WalkBlock(
@@ -649,11 +698,9 @@ struct Memory::Impl {
             while (base != end) {
                 page_table.pointers[base].Store(0, type);
                 page_table.backing_addr[base] = 0;
-                page_table.blocks[base] = 0;
                 base += 1;
             }
         } else {
-            auto orig_base = base;
             while (base != end) {
                 auto host_ptr =
                     reinterpret_cast<uintptr_t>(system.DeviceMemory().GetPointer<u8>(target)) -
@@ -661,7 +708,6 @@ struct Memory::Impl {
                 auto backing = GetInteger(target) - (base << YUZU_PAGEBITS);
                 page_table.pointers[base].Store(host_ptr, type);
                 page_table.backing_addr[base] = backing;
-                page_table.blocks[base] = orig_base << YUZU_PAGEBITS;
 
                 ASSERT_MSG(page_table.pointers[base].Pointer(),
                            "memory mapping base yield a nullptr within the table");
@@ -907,6 +953,10 @@ void Memory::SetCurrentPageTable(Kernel::KProcess& process) {
     impl->SetCurrentPageTable(process);
 }
 
+void Memory::SetCurrentPageTable(Common::PageTable& page_table) {
+    impl->SetCurrentPageTable(page_table);
+}
+
 void Memory::MapMemoryRegion(Common::PageTable& page_table, Common::ProcessAddress base, u64 size,
                              Common::PhysicalAddress target, Common::MemoryPermission perms,
                              bool separate_heap) {
@@ -1033,6 +1083,12 @@ u8* Memory::GetSpan(const VAddr src_addr, const std::size_t size) {
     return impl->GetSpan(src_addr, size);
 }
 
+std::span<const u8> Memory::GetContiguousSpan(const Common::ProcessAddress src_addr,
+                                              const std::size_t size,
+                                              Common::ScratchBuffer<u8>& scratch) {
+    return impl->GetContiguousSpan(src_addr, size, scratch);
+}
+
 bool Memory::WriteBlock(const Common::ProcessAddress dest_addr, const void* src_buffer,
                         const std::size_t size) {
     return impl->WriteBlock(dest_addr, src_buffer, size);
@@ -1052,6 +1108,10 @@ bool Memory::ZeroBlock(Common::ProcessAddress dest_addr, const std::size_t size)
     return impl->ZeroBlock(dest_addr, size);
 }
 
+void Memory::InvalidateRegion(Common::ProcessAddress dest_addr, const std::size_t size) {
+    impl->InvalidateRegion(dest_addr, size);
+}
+
 void Memory::SetGPUDirtyManagers(std::span<Core::GPUDirtyMemoryManager> managers) {
     impl->gpu_dirty_managers = managers;
 }
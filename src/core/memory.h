@@ -76,6 +76,14 @@ public:
      */
     void SetCurrentPageTable(Kernel::KProcess& process);
 
+    /**
+     * Changes the currently active page table to one that no process owns, for tools that map
+     * guest memory by hand. Fastmem is not used with it.
+     *
+     * @param page_table The page table to use.
+     */
+    void SetCurrentPageTable(Common::PageTable& page_table);
+
     /**
      * Maps an allocated buffer onto a region of the emulated process address space.
      *
@@ -369,6 +377,21 @@ public:
     const u8* GetSpan(const VAddr src_addr, const std::size_t size) const;
     u8* GetSpan(const VAddr src_addr, const std::size_t size);
 
+    /**
+     * Returns a view of a range of the current process' address space without copying it when
+     * the range is backed by contiguous host memory. Any other range is read into the scratch
+     * buffer. This unsafe version does not trigger GPU flushing.
+     *
+     * @param src_addr The virtual address to begin reading from.
+     * @param size     The amount of data to read, in bytes.
+     * @param scratch  The buffer holding the data when the range has to be copied.
+     *
+     * @returns A view of the range. It points either into guest memory or into the scratch buffer,
+     *          and is invalidated by unmapping the range or by reusing the scratch buffer.
+     */
+    std::span<const u8> GetContiguousSpan(Common::ProcessAddress src_addr, std::size_t size,
+                                          Common::ScratchBuffer<u8>& scratch);
+
     /**
      * Writes a range of bytes into the current process' address space at the specified
      * virtual address.
@@ -435,6 +458,15 @@ public:
      */
     bool ZeroBlock(Common::ProcessAddress dest_addr, std::size_t size);
 
+    /**
+     * Notifies the GPU caches that a range of the current process' address space was written
+     * in place, through a pointer obtained from GetSpan.
+     *
+     * @param dest_addr The virtual address of the written range.
+     * @param size      The size of the written range, in bytes.
+     */
+    void InvalidateRegion(Common::ProcessAddress dest_addr, std::size_t size);
+
     /**
      * Invalidates a range of bytes within the current process' address space at the specified
      * virtual address.
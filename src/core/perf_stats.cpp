@@ -105,6 +105,12 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
         .frametime = duration_cast<DoubleSecs>(accumulated_frametime).count() /
                      static_cast<double>(system_frames),
         .emulation_speed = system_us_per_second.count() / 1'000'000.0,
+        .gpu_queue_depth = 0.0,
+        .gpu_queue_latency_us = 0.0,
+        .gpu_download_bytes = 0,
+        .gpu_download_latency_us = 0.0,
+        .gpu_texture_evictions = 0,
+        .gpu_texture_thrash_rate = 0.0,
     };
 
     // Reset counters
@@ -21,6 +21,18 @@ struct PerfStatsResults {
     double frametime;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
+    /// Average number of commands pending in the GPU thread queue when a command is pushed
+    double gpu_queue_depth;
+    /// Average time a command waits in the GPU thread queue, in microseconds
+    double gpu_queue_latency_us;
+    /// Bytes written back to guest memory by asynchronous GPU downloads in the last frame
+    u64 gpu_download_bytes;
+    /// Average time an asynchronous GPU download took to reach guest memory, in microseconds
+    double gpu_download_latency_us;
+    /// Images evicted by the texture cache since the last stats reset
+    u64 gpu_texture_evictions;
+    /// Fraction of the texture cache evictions that had to be uploaded again
+    double gpu_texture_thrash_rate;
 };
 
 /**
@@ -0,0 +1,311 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/fs/path_util.h"
+#include "common/literals.h"
+#include "common/logging/backend.h"
+#include "common/logging/log.h"
+#include "common/page_table.h"
+#include "common/scm_rev.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/device_memory.h"
+#include "core/frontend/emu_window.h"
+#include "core/frontend/graphics_context.h"
+#include "core/hle/kernel/board/nintendo/nx/k_system_control.h"
+#include "core/memory.h"
+#include "video_core/command_capture.h"
+#include "video_core/control/channel_state.h"
+#include "video_core/dma_pusher.h"
+#include "video_core/gpu.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/host1x/host1x.h"
+#include "video_core/memory_manager.h"
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using namespace Common::Literals;
+using namespace Tegra::CommandCapture;
+
+/// Granularity of the mappings made for captured memory, the GPU big page size
+constexpr size_t MAPPING_SIZE = 64_KiB;
+
+/// Width of the CPU page table, enough to map all of DRAM at its physical addresses
+constexpr size_t PAGE_TABLE_BITS = 36;
+
+struct Statistics {
+    u64 lists{};
+    u64 methods{};
+    u64 memory_reads{};
+    u64 memory_bytes{};
+};
+
+class DummyContext final : public Core::Frontend::GraphicsContext {};
+
+/// Window that is never shown, renderer_null only needs one to exist
+class HeadlessWindow final : public Core::Frontend::EmuWindow {
+public:
+    std::unique_ptr<Core::Frontend::GraphicsContext> CreateSharedContext() const override {
+        return std::make_unique<DummyContext>();
+    }
+    bool IsShown() const override {
+        return false;
+    }
+};
+
+/**
+ * GPU address space of the replay. Captured memory is placed in emulated DRAM on demand and
+ * mapped through a page table of its own, the device memory manager and the GPU MMU, the same
+ * layers nvdrv maps application buffers through.
+ */
+class AddressSpace {
+public:
+    explicit AddressSpace(Core::System& system)
+        : device_memory{system.Host1x().MemoryManager()}, process_memory{system},
+          memory_manager{std::make_shared<Tegra::MemoryManager>(system)},
+          dram_size{Kernel::Board::Nintendo::Nx::KSystemControl::Init::GetIntendedMemorySize()} {
+        page_table.Resize(PAGE_TABLE_BITS, Core::Memory::YUZU_PAGEBITS);
+        process_memory.SetCurrentPageTable(page_table);
+        asid = device_memory.RegisterProcess(&process_memory);
+        system.GPU().InitAddressSpace(*memory_manager);
+    }
+
+    ~AddressSpace() {
+        device_memory.UnregisterProcess(asid);
+    }
+
+    [[nodiscard]] std::shared_ptr<Tegra::MemoryManager> MemoryManager() const {
+        return memory_manager;
+    }
+
+    /// Writes captured memory back, returns false when DRAM has been exhausted
+    bool Restore(GPUVAddr gpu_addr, std::span<const u8> data) {
+        const GPUVAddr end = gpu_addr + data.size();
+        for (GPUVAddr page = Common::AlignDown(gpu_addr, MAPPING_SIZE); page < end;
+             page += MAPPING_SIZE) {
+            if (!memory_manager->GpuToCpuAddress(page) && !Map(page)) {
+                return false;
+            }
+        }
+        memory_manager->WriteBlock(gpu_addr, data.data(), data.size());
+        return true;
+    }
+
+private:
+    bool Map(GPUVAddr gpu_addr) {
+        if (mapped_size + MAPPING_SIZE > dram_size) {
+            LOG_ERROR(HW_GPU, "Out of emulated DRAM to map GPU address 0x{:X}", gpu_addr);
+            return false;
+        }
+        // DRAM is mapped at its physical addresses, no other address space shares the table
+        const PAddr physical_addr = Core::DramMemoryMap::Base + mapped_size;
+        mapped_size += MAPPING_SIZE;
+        process_memory.MapMemoryRegion(page_table, physical_addr, MAPPING_SIZE, physical_addr,
+                                       Common::MemoryPermission::ReadWrite, false);
+        const DAddr device_addr = device_memory.Allocate(MAPPING_SIZE);
+        device_memory.Map(device_addr, physical_addr, MAPPING_SIZE, asid);
+        memory_manager->Map(gpu_addr, device_addr, MAPPING_SIZE);
+        return true;
+    }
+
+    Tegra::MaxwellDeviceMemoryManager& device_memory;
+    Common::PageTable page_table;
+    Core::Memory::Memory process_memory;
+    Core::Asid asid{};
+    std::shared_ptr<Tegra::MemoryManager> memory_manager;
+    const size_t dram_size;
+    size_t mapped_size{};
+};
+
+/// Replays a capture on a channel, returns false when it could not be replayed to the end
+bool Replay(Tegra::DmaPusher& dma_pusher, AddressSpace& address_space, Reader& reader,
+            Statistics& statistics, Clock::duration& wall_time) {
+    const auto start{Clock::now()};
+    GPUVAddr segment{};
+    Record record;
+    bool succeeded = true;
+    while (succeeded && reader.Next(record)) {
+        switch (record.type) {
+        case RecordType::Method:
+            ++statistics.methods;
+            dma_pusher.ReplayMethod(record.subchannel, record.method, record.arguments[0],
+                                    record.is_last_call, segment);
+            break;
+        case RecordType::MultiMethod:
+            statistics.methods += record.arguments.size();
+            dma_pusher.ReplayMultiMethod(record.subchannel, record.method, record.arguments,
+                                         record.methods_pending, segment);
+            break;
+        case RecordType::DmaSegment:
+            segment = record.segment;
+            break;
+        case RecordType::ListEnd:
+            ++statistics.lists;
+            dma_pusher.ReplayListEnd();
+            break;
+        case RecordType::MemoryRead:
+            ++statistics.memory_reads;
+            statistics.memory_bytes += record.data.size();
+            succeeded = address_space.Restore(record.address, record.data);
+            break;
+        }
+    }
+    wall_time += Clock::now() - start;
+    if (!succeeded) {
+        return false;
+    }
+    if (!reader.AtEnd()) {
+        LOG_ERROR(HW_GPU, "Replay stopped on a malformed record");
+        return false;
+    }
+    return true;
+}
+
+void PrintHelp(const char* argv0) {
+    fmt::print("Usage: {} [options] <capture file>\n"
+               "Replays a GPU command capture (.ygcs, written when dump_gpu_commands is enabled)\n"
+               "through the puller and engines of a GPU using renderer_null, without a game.\n"
+               "Captures hold the memory the engines read, not what a renderer reads on its own\n"
+               "(vertex, index and uniform buffers, texture handles), so other renderers can't\n"
+               "replay them.\n"
+               "-n, --iterations  Number of times the capture is replayed (defaults to 1)\n"
+               "-h, --help        Display this help and exit\n"
+               "-v, --version     Output version information and exit\n",
+               argv0);
+}
+
+void PrintVersion() {
+    fmt::print("yuzu GPU replay {} {}\n", Common::g_scm_branch, Common::g_scm_desc);
+}
+
+void InitializeLogging() {
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+}
+
+std::vector<u32> LoadCapture(const std::filesystem::path& path) {
+    const Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                                  Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        return {};
+    }
+    std::vector<u32> words(file.GetSize() / sizeof(u32));
+    if (file.ReadSpan(std::span<u32>(words)) != words.size()) {
+        return {};
+    }
+    return words;
+}
+
+void PrintReport(const Statistics& statistics, Clock::duration wall_time, u32 iterations) {
+    const double seconds{std::chrono::duration<double>(wall_time).count()};
+    const double methods_per_second{seconds > 0.0 ? statistics.methods / seconds : 0.0};
+    fmt::print("Replayed {} command lists {} times in {:.3f} s\n", statistics.lists / iterations,
+               iterations, seconds);
+    fmt::print("Methods:        {} ({:.2f} M/s)\n", statistics.methods, methods_per_second / 1e6);
+    fmt::print("Memory reads:   {} ({} bytes)\n", statistics.memory_reads,
+               statistics.memory_bytes);
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    u32 iterations = 1;
+    int option_index = 0;
+    char* endarg;
+
+    static struct option long_options[] = {
+        {"iterations", required_argument, 0, 'n'},
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'v'},
+        {0, 0, 0, 0},
+    };
+
+    InitializeLogging();
+
+    std::filesystem::path input;
+    while (optind < argc) {
+        int arg = getopt_long(argc, argv, "n:hv", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'n':
+                iterations = static_cast<u32>(strtoul(optarg, &endarg, 0));
+                break;
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            case 'v':
+                PrintVersion();
+                return 0;
+            default:
+                PrintHelp(argv[0]);
+                return -1;
+            }
+        } else {
+            input.assign(argv[optind]);
+            ++optind;
+        }
+    }
+    if (input.empty() || iterations == 0) {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+    const std::vector<u32> words{LoadCapture(input)};
+    if (!Reader{words}.IsValid()) {
+        LOG_ERROR(HW_GPU, "{} is not a GPU command capture", Common::FS::PathToUTF8String(input));
+        return -1;
+    }
+
+    Settings::values.renderer_backend.SetValue(Settings::RendererBackend::Null);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(false);
+
+    Core::System system;
+    system.Initialize();
+    HeadlessWindow emu_window;
+    if (system.InitializeGPU(emu_window) != Core::SystemResultStatus::Success) {
+        LOG_ERROR(HW_GPU, "Failed to create the GPU");
+        return -1;
+    }
+
+    Statistics statistics;
+    Clock::duration wall_time{};
+    bool succeeded = true;
+    {
+        AddressSpace address_space{system};
+
+        // Channels can't be released, every iteration continues on the state the last one left
+        Tegra::GPU& gpu = system.GPU();
+        const auto channel = gpu.AllocateChannel();
+        channel->memory_manager = address_space.MemoryManager();
+        gpu.InitChannel(*channel, 0);
+        gpu.BindChannel(channel->bind_id);
+
+        for (u32 iteration = 0; iteration < iterations && succeeded; ++iteration) {
+            Reader reader{words};
+            succeeded = Replay(*channel->dma_pusher, address_space, reader, statistics, wall_time);
+        }
+    }
+    system.ShutdownGPU();
+
+    PrintReport(statistics, wall_time, iterations);
+    return succeeded ? 0 : 1;
+}
@@ -0,0 +1,644 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/fs/path_util.h"
+#include "common/logging/backend.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "common/thread_worker.h"
+#include "shader_recompiler/arena.h"
+#include "shader_recompiler/backend/glasm/emit_glasm.h"
+#include "shader_recompiler/backend/glsl/emit_glsl.h"
+#include "shader_recompiler/backend/spirv/emit_spirv.h"
+#include "shader_recompiler/exception.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/frontend/maxwell/control_flow.h"
+#include "shader_recompiler/frontend/maxwell/translate_program.h"
+#include "shader_recompiler/host_translate_info.h"
+#include "shader_recompiler/object_pool.h"
+#include "shader_recompiler/profile.h"
+#include "shader_recompiler/program_header.h"
+#include "shader_recompiler/runtime_info.h"
+#include "video_core/renderer_opengl/gl_shader_cache.h"
+#include "video_core/renderer_vulkan/vk_pipeline_cache.h"
+#include "video_core/shader_environment.h"
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using VideoCommon::FileEnvironment;
+
+constexpr size_t NUM_PROGRAMS = 6;
+
+enum class CacheType {
+    Vulkan,
+    OpenGL,
+};
+
+enum class Backend {
+    Default,
+    SPIRV,
+    GLSL,
+    GLASM,
+};
+
+struct ShaderPools {
+    void ReleaseContents() {
+        flow_block.ReleaseContents();
+        block.ReleaseContents();
+        inst.ReleaseContents();
+        arena.Reset();
+    }
+
+    Shader::ObjectPool<Shader::IR::Inst> inst{8192};
+    Shader::ObjectPool<Shader::IR::Block> block{32};
+    Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
+    Shader::Arena arena;
+};
+
+using PrecompileWorker = Common::StatefulThreadWorker<ShaderPools>;
+
+/// Timing of a single shader stage going through the recompiler
+struct ShaderRecord {
+    std::string cache_name;
+    u64 unique_hash;
+    Shader::Stage stage;
+    Clock::duration translate_time;
+    Clock::duration emit_time;
+    size_t output_size;
+};
+
+struct Statistics {
+    std::mutex mutex;
+    std::vector<ShaderRecord> records;
+    std::atomic<size_t> pipelines{};
+    std::atomic<size_t> failed_pipelines{};
+    u64 arena_allocations{};
+    u64 arena_bytes{};
+    u64 arena_peak_bytes{};
+};
+
+struct Options {
+    Backend backend{Backend::Default};
+    size_t num_threads{};
+    std::string csv_file;
+};
+
+void PrintHelp(const char* argv0) {
+    fmt::print("Usage: {} [options] <cache file or directory>...\n"
+               "Replays every pipeline stored in yuzu pipeline cache files (vulkan.bin,\n"
+               "opengl.bin) through the shader recompiler without a game or a GPU.\n"
+               "Directories are searched recursively for pipeline cache files.\n"
+               "-b, --backend  Backend to emit: spirv, glsl or glasm\n"
+               "               (defaults to spirv for Vulkan caches and glsl for OpenGL caches)\n"
+               "-j, --threads  Number of worker threads (defaults to all host threads)\n"
+               "-o, --output   Write per-shader timings as CSV to the given file\n"
+               "-h, --help     Display this help and exit\n"
+               "-v, --version  Output version information and exit\n",
+               argv0);
+}
+
+void PrintVersion() {
+    fmt::print("yuzu shader precompiler {} {}\n", Common::g_scm_branch, Common::g_scm_desc);
+}
+
+void InitializeLogging() {
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+}
+
+std::optional<Backend> ParseBackend(std::string_view name) {
+    if (name == "spirv") {
+        return Backend::SPIRV;
+    }
+    if (name == "glsl") {
+        return Backend::GLSL;
+    }
+    if (name == "glasm") {
+        return Backend::GLASM;
+    }
+    return std::nullopt;
+}
+
+std::optional<CacheType> DetectCacheType(const std::filesystem::path& path) {
+    const auto filename{path.filename()};
+    if (filename == "vulkan.bin") {
+        return CacheType::Vulkan;
+    }
+    if (filename == "opengl.bin") {
+        return CacheType::OpenGL;
+    }
+    return std::nullopt;
+}
+
+u32 ExpectedCacheVersion(CacheType type) {
+    return type == CacheType::Vulkan ? Vulkan::CACHE_VERSION : OpenGL::CACHE_VERSION;
+}
+
+/// Host capabilities of a modern desktop GPU, so every backend feature path gets exercised
+Shader::Profile MakeProfile(Backend backend) {
+    return Shader::Profile{
+        .supported_spirv = 0x00010600,
+        .unified_descriptor_binding = backend == Backend::SPIRV,
+        .support_descriptor_aliasing = true,
+        .support_int8 = true,
+        .support_int16 = true,
+        .support_int64 = true,
+        .support_vertex_instance_id = backend != Backend::SPIRV,
+        .support_float_controls = true,
+        .support_separate_denorm_behavior = true,
+        .support_separate_rounding_mode = true,
+        .support_fp16_denorm_preserve = true,
+        .support_fp32_denorm_preserve = true,
+        .support_fp16_denorm_flush = true,
+        .support_fp32_denorm_flush = true,
+        .support_fp16_signed_zero_nan_preserve = true,
+        .support_fp32_signed_zero_nan_preserve = true,
+        .support_fp64_signed_zero_nan_preserve = true,
+        .support_explicit_workgroup_layout = true,
+        .support_vote = true,
+        .support_viewport_index_layer_non_geometry = true,
+        .support_viewport_mask = true,
+        .support_typeless_image_loads = true,
+        .support_demote_to_helper_invocation = true,
+        .support_int64_atomics = true,
+        .support_derivative_control = true,
+        .support_geometry_shader_passthrough = true,
+        .support_native_ndc = true,
+        .support_gl_nv_gpu_shader_5 = true,
+        .support_gl_amd_gpu_shader_half_float = false,
+        .support_gl_texture_shadow_lod = true,
+        .support_gl_warp_intrinsics = true,
+        .support_gl_variable_aoffi = true,
+        .support_gl_sparse_textures = true,
+        .support_gl_derivative_control = true,
+        .support_scaled_attributes = true,
+        .support_multi_viewport = true,
+        .support_geometry_streams = true,
+
+        .warp_size_potentially_larger_than_guest = false,
+
+        .lower_left_origin_mode = backend != Backend::SPIRV,
+        .need_declared_frag_colors = backend != Backend::SPIRV,
+
+        .gl_max_compute_smem_size = 0xc000,
+        .min_ssbo_alignment = 16,
+        .max_user_clip_distances = 8,
+    };
+}
+
+Shader::HostTranslateInfo MakeHostInfo() {
+    return Shader::HostTranslateInfo{
+        .support_float64 = true,
+        .support_float16 = true,
+        .support_int64 = true,
+        .needs_demote_reorder = false,
+        .support_snorm_render_buffer = true,
+        .support_viewport_index_layer = true,
+        .min_ssbo_alignment = 16,
+        .support_geometry_shader_passthrough = true,
+        .support_conditional_barrier = true,
+    };
+}
+
+/// Replays pipelines through the recompiler, recording the time spent on each stage
+class Precompiler {
+public:
+    explicit Precompiler(Backend backend_, Statistics& statistics_)
+        : backend{backend_}, profile{MakeProfile(backend_)}, host_info{MakeHostInfo()},
+          statistics{statistics_} {}
+
+    void CompileGraphics(ShaderPools& pools, const std::string& cache_name,
+                         const std::array<u64, NUM_PROGRAMS>& unique_hashes,
+                         std::span<FileEnvironment> envs) const try {
+        pools.ReleaseContents();
+
+        std::array<Shader::IR::Program, NUM_PROGRAMS> programs;
+        std::array<Clock::duration, NUM_PROGRAMS> translate_times{};
+        const bool uses_vertex_a{unique_hashes[0] != 0};
+        const bool uses_vertex_b{unique_hashes[1] != 0};
+        size_t env_index{};
+        for (size_t index = 0; index < NUM_PROGRAMS; ++index) {
+            if (unique_hashes[index] == 0) {
+                continue;
+            }
+            FileEnvironment& env{envs[env_index++]};
+            const auto start{Clock::now()};
+            const u32 cfg_offset{
+                static_cast<u32>(env.StartAddress() + sizeof(Shader::ProgramHeader))};
+            Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0);
+            if (!uses_vertex_a || index != 1) {
+                programs[index] = Shader::Maxwell::TranslateProgram(pools.inst, pools.block,
+                                                                    pools.arena, env, cfg, host_info);
+            } else {
+                auto program_vb{Shader::Maxwell::TranslateProgram(pools.inst, pools.block,
+                                                                  pools.arena, env, cfg, host_info)};
+                programs[index] =
+                    Shader::Maxwell::MergeDualVertexPrograms(programs[0], program_vb, env);
+            }
+            translate_times[index] = Clock::now() - start;
+        }
+        const Shader::IR::Program* previous_program{};
+        Shader::Backend::Bindings bindings;
+        for (size_t index = uses_vertex_a && uses_vertex_b ? 1 : 0; index < NUM_PROGRAMS;
+             ++index) {
+            if (unique_hashes[index] == 0) {
+                continue;
+            }
+            Shader::IR::Program& program{programs[index]};
+            const auto start{Clock::now()};
+            const Shader::RuntimeInfo runtime_info{MakeRuntimeInfo(previous_program)};
+            Shader::Maxwell::ConvertLegacyToGeneric(program, runtime_info);
+            const size_t output_size{Emit(runtime_info, program, bindings)};
+
+            Record(ShaderRecord{
+                .cache_name = cache_name,
+                .unique_hash = unique_hashes[index],
+                .stage = program.stage,
+                .translate_time = translate_times[index],
+                .emit_time = Clock::now() - start,
+                .output_size = output_size,
+            });
+            previous_program = &program;
+        }
+        RecordArena(pools.arena);
+        ++statistics.pipelines;
+
+    } catch (const Shader::Exception& exception) {
+        LOG_ERROR(Shader, "Failed to recompile graphics pipeline from {}: {}", cache_name,
+                  exception.what());
+        ++statistics.pipelines;
+        ++statistics.failed_pipelines;
+    }
+
+    void CompileCompute(ShaderPools& pools, const std::string& cache_name, u64 unique_hash,
+                        FileEnvironment& env) const try {
+        pools.ReleaseContents();
+
+        const auto translate_start{Clock::now()};
+        Shader::Maxwell::Flow::CFG cfg{env, pools.flow_block, env.StartAddress()};
+        auto program{Shader::Maxwell::TranslateProgram(pools.inst, pools.block, pools.arena, env,
+                                                       cfg, host_info)};
+        const auto emit_start{Clock::now()};
+        Shader::Backend::Bindings bindings;
+        const size_t output_size{Emit({}, program, bindings)};
+
+        Record(ShaderRecord{
+            .cache_name = cache_name,
+            .unique_hash = unique_hash,
+            .stage = program.stage,
+            .translate_time = emit_start - translate_start,
+            .emit_time = Clock::now() - emit_start,
+            .output_size = output_size,
+        });
+        RecordArena(pools.arena);
+        ++statistics.pipelines;
+
+    } catch (const Shader::Exception& exception) {
+        LOG_ERROR(Shader, "Failed to recompile compute pipeline from {}: {}", cache_name,
+                  exception.what());
+        ++statistics.pipelines;
+        ++statistics.failed_pipelines;
+    }
+
+    void RecordCorruptedPipeline(const std::string& cache_name) const {
+        LOG_ERROR(Shader, "Corrupted pipeline in {}", cache_name);
+        ++statistics.pipelines;
+        ++statistics.failed_pipelines;
+    }
+
+private:
+    static Shader::RuntimeInfo MakeRuntimeInfo(const Shader::IR::Program* previous_program) {
+        Shader::RuntimeInfo info;
+        if (previous_program) {
+            info.previous_stage_stores = previous_program->info.stores;
+            info.previous_stage_legacy_stores_mapping =
+                previous_program->info.legacy_stores_mapping;
+        } else {
+            info.previous_stage_stores.mask.set();
+        }
+        return info;
+    }
+
+    size_t Emit(const Shader::RuntimeInfo& runtime_info, Shader::IR::Program& program,
+                Shader::Backend::Bindings& bindings) const {
+        switch (backend) {
+        case Backend::GLSL:
+            return Shader::Backend::GLSL::EmitGLSL(profile, runtime_info, program, bindings)
+                .size();
+        case Backend::GLASM:
+            return Shader::Backend::GLASM::EmitGLASM(profile, runtime_info, program, bindings)
+                .size();
+        case Backend::SPIRV:
+        case Backend::Default:
+            break;
+        }
+        return Shader::Backend::SPIRV::EmitSPIRV(profile, runtime_info, program, bindings).size() *
+               sizeof(u32);
+    }
+
+    void Record(ShaderRecord&& record) const {
+        std::scoped_lock lock{statistics.mutex};
+        statistics.records.push_back(std::move(record));
+    }
+
+    void RecordArena(const Shader::Arena& arena) const {
+        const Shader::Arena::Statistics& arena_statistics{arena.GetStatistics()};
+        std::scoped_lock lock{statistics.mutex};
+        statistics.arena_allocations += arena_statistics.num_allocations;
+        statistics.arena_bytes += arena_statistics.bytes_allocated;
+        statistics.arena_peak_bytes =
+            std::max(statistics.arena_peak_bytes, arena_statistics.peak_bytes_allocated);
+    }
+
+    Backend backend;
+    Shader::Profile profile;
+    Shader::HostTranslateInfo host_info;
+    Statistics& statistics;
+};
+
+/// Queues every pipeline of a cache file on the workers, returns the number of pipelines queued
+size_t QueueCacheFile(PrecompileWorker& workers, const Precompiler& glsl_precompiler,
+                      const Precompiler& spirv_precompiler, const std::filesystem::path& path,
+                      CacheType type) {
+    const auto cache_version{VideoCommon::ReadPipelineCacheVersion(path)};
+    if (!cache_version) {
+        LOG_ERROR(Shader, "{} is not a valid pipeline cache", Common::FS::PathToUTF8String(path));
+        return 0;
+    }
+    if (*cache_version != ExpectedCacheVersion(type)) {
+        LOG_ERROR(Shader, "{} has cache version {}, expected {}",
+                  Common::FS::PathToUTF8String(path), *cache_version, ExpectedCacheVersion(type));
+        return 0;
+    }
+    const Precompiler* const precompiler{type == CacheType::Vulkan ? &spirv_precompiler
+                                                                   : &glsl_precompiler};
+    const std::string cache_name{Common::FS::PathToUTF8String(path)};
+    size_t num_queued{};
+
+    const auto queue_compute{[&](u64 unique_hash, VideoCommon::PipelineCacheEntry entry) {
+        workers.QueueWork([precompiler, cache_name, unique_hash,
+                           entry_ = std::move(entry)](ShaderPools* pools) mutable {
+            std::vector<FileEnvironment> envs{entry_.LoadEnvironments()};
+            if (envs.empty()) {
+                precompiler->RecordCorruptedPipeline(cache_name);
+                return;
+            }
+            precompiler->CompileCompute(*pools, cache_name, unique_hash, envs.front());
+        });
+        ++num_queued;
+    }};
+    const auto queue_graphics{[&](const std::array<u64, NUM_PROGRAMS>& unique_hashes,
+                                  VideoCommon::PipelineCacheEntry entry) {
+        workers.QueueWork([precompiler, cache_name, unique_hashes,
+                           entry_ = std::move(entry)](ShaderPools* pools) mutable {
+            std::vector<FileEnvironment> envs{entry_.LoadEnvironments()};
+            // Every stage in use reads its own environment
+            const auto num_stages{
+                std::ranges::count_if(unique_hashes, [](u64 hash) { return hash != 0; })};
+            if (envs.size() != static_cast<size_t>(num_stages)) {
+                precompiler->RecordCorruptedPipeline(cache_name);
+                return;
+            }
+            precompiler->CompileGraphics(*pools, cache_name, unique_hashes, envs);
+        });
+        ++num_queued;
+    }};
+    if (type == CacheType::Vulkan) {
+        VideoCommon::LoadPipelines<Vulkan::ComputePipelineCacheKey,
+                                   Vulkan::GraphicsPipelineCacheKey>(
+            {}, path, *cache_version,
+            [&](const Vulkan::ComputePipelineCacheKey& key,
+                VideoCommon::PipelineCacheEntry entry) {
+                queue_compute(key.unique_hash, std::move(entry));
+            },
+            [&](const Vulkan::GraphicsPipelineCacheKey& key,
+                VideoCommon::PipelineCacheEntry entry) {
+                queue_graphics(key.unique_hashes, std::move(entry));
+            },
+            VideoCommon::PipelineCacheAccess::ReadOnly);
+    } else {
+        VideoCommon::LoadPipelines<OpenGL::ComputePipelineKey, OpenGL::GraphicsPipelineKey>(
+            {}, path, *cache_version,
+            [&](const OpenGL::ComputePipelineKey& key, VideoCommon::PipelineCacheEntry entry) {
+                queue_compute(key.unique_hash, std::move(entry));
+            },
+            [&](const OpenGL::GraphicsPipelineKey& key, VideoCommon::PipelineCacheEntry entry) {
+                queue_graphics(key.unique_hashes, std::move(entry));
+            },
+            VideoCommon::PipelineCacheAccess::ReadOnly);
+    }
+    return num_queued;
+}
+
+std::vector<std::pair<std::filesystem::path, CacheType>> CollectCacheFiles(
+    const std::vector<std::filesystem::path>& inputs) {
+    std::vector<std::pair<std::filesystem::path, CacheType>> files;
+    for (const auto& input : inputs) {
+        std::error_code ec;
+        if (!std::filesystem::is_directory(input, ec)) {
+            if (const auto type{DetectCacheType(input)}) {
+                files.emplace_back(input, *type);
+            } else {
+                LOG_ERROR(Shader, "Unknown pipeline cache file {}, expected vulkan.bin or "
+                                  "opengl.bin",
+                          Common::FS::PathToUTF8String(input));
+            }
+            continue;
+        }
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(input, ec)) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+            if (const auto type{DetectCacheType(entry.path())}) {
+                files.emplace_back(entry.path(), *type);
+            }
+        }
+    }
+    return files;
+}
+
+double ToMilliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void WriteCsv(const std::string& filename, const std::vector<ShaderRecord>& records) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        LOG_ERROR(Shader, "Failed to open {} for writing", filename);
+        return;
+    }
+    file << "cache,hash,stage,output_bytes,translate_ms,emit_ms\n";
+    for (const ShaderRecord& record : records) {
+        file << fmt::format("{},{:016x},{},{},{:.4f},{:.4f}\n", record.cache_name,
+                            record.unique_hash, static_cast<u32>(record.stage), record.output_size,
+                            ToMilliseconds(record.translate_time),
+                            ToMilliseconds(record.emit_time));
+    }
+}
+
+void PrintReport(const Statistics& statistics, Clock::duration wall_time, size_t num_threads) {
+    Clock::duration translate_time{};
+    Clock::duration emit_time{};
+    for (const ShaderRecord& record : statistics.records) {
+        translate_time += record.translate_time;
+        emit_time += record.emit_time;
+    }
+    const size_t num_shaders{statistics.records.size()};
+    const double wall_seconds{std::chrono::duration<double>(wall_time).count()};
+    fmt::print("Pipelines: {} ({} failed)\n", statistics.pipelines.load(),
+               statistics.failed_pipelines.load());
+    fmt::print("Shaders:   {}\n", num_shaders);
+    fmt::print("Threads:   {}\n", num_threads);
+    fmt::print("Wall time: {:.3f} s ({:.1f} shaders/s)\n", wall_seconds,
+               wall_seconds > 0.0 ? static_cast<double>(num_shaders) / wall_seconds : 0.0);
+    if (num_shaders == 0) {
+        return;
+    }
+    fmt::print("Translate: {:.3f} ms total, {:.4f} ms per shader\n",
+               ToMilliseconds(translate_time),
+               ToMilliseconds(translate_time) / static_cast<double>(num_shaders));
+    fmt::print("Emit:      {:.3f} ms total, {:.4f} ms per shader\n", ToMilliseconds(emit_time),
+               ToMilliseconds(emit_time) / static_cast<double>(num_shaders));
+    fmt::print("Arena:     {} allocations, {} KiB total, {} KiB peak per pipeline\n",
+               statistics.arena_allocations, statistics.arena_bytes / 1024,
+               statistics.arena_peak_bytes / 1024);
+
+    std::vector<const ShaderRecord*> slowest;
+    slowest.reserve(num_shaders);
+    for (const ShaderRecord& record : statistics.records) {
+        slowest.push_back(&record);
+    }
+    const size_t num_slowest{std::min<size_t>(10, slowest.size())};
+    std::partial_sort(slowest.begin(), slowest.begin() + num_slowest, slowest.end(),
+                      [](const ShaderRecord* lhs, const ShaderRecord* rhs) {
+                          return lhs->translate_time + lhs->emit_time >
+                                 rhs->translate_time + rhs->emit_time;
+                      });
+    fmt::print("Slowest shaders:\n");
+    for (size_t index = 0; index < num_slowest; ++index) {
+        const ShaderRecord& record{*slowest[index]};
+        fmt::print("  {:016x} stage={} translate={:.3f} ms emit={:.3f} ms\n", record.unique_hash,
+                   static_cast<u32>(record.stage), ToMilliseconds(record.translate_time),
+                   ToMilliseconds(record.emit_time));
+    }
+}
+
+} // Anonymous namespace
+
+/// Application entry point
+int main(int argc, char** argv) {
+    Options options;
+    int option_index = 0;
+    char* endarg;
+
+    static struct option long_options[] = {
+        {"backend", required_argument, 0, 'b'},
+        {"threads", required_argument, 0, 'j'},
+        {"output", required_argument, 0, 'o'},
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'v'},
+        {0, 0, 0, 0},
+    };
+
+    InitializeLogging();
+
+    std::vector<std::filesystem::path> inputs;
+    while (optind < argc) {
+        int arg = getopt_long(argc, argv, "b:j:o:hv", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'b': {
+                const auto backend{ParseBackend(optarg)};
+                if (!backend) {
+                    LOG_ERROR(Shader, "Unknown backend {}", optarg);
+                    PrintHelp(argv[0]);
+                    return -1;
+                }
+                options.backend = *backend;
+                break;
+            }
+            case 'j':
+                options.num_threads = strtoul(optarg, &endarg, 0);
+                break;
+            case 'o':
+                options.csv_file.assign(optarg);
+                break;
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            case 'v':
+                PrintVersion();
+                return 0;
+            default:
+                PrintHelp(argv[0]);
+                return -1;
+            }
+        } else {
+            inputs.emplace_back(argv[optind]);
+            ++optind;
+        }
+    }
+    if (inputs.empty()) {
+        PrintHelp(argv[0]);
+        return -1;
+    }
+    const auto files{CollectCacheFiles(inputs)};
+    if (files.empty()) {
+        LOG_ERROR(Shader, "No pipeline cache files found");
+        return -1;
+    }
+    if (options.num_threads == 0) {
+        options.num_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    Statistics statistics;
+    const Backend gl_backend{options.backend == Backend::Default ? Backend::GLSL : options.backend};
+    const Backend vk_backend{options.backend == Backend::Default ? Backend::SPIRV
+                                                                : options.backend};
+    const Precompiler glsl_precompiler{gl_backend, statistics};
+    const Precompiler spirv_precompiler{vk_backend, statistics};
+
+    const auto start{Clock::now()};
+    {
+        PrecompileWorker workers(options.num_threads, "ShaderPrecompiler",
+                                 [] { return ShaderPools{}; });
+        for (const auto& [path, type] : files) {
+            const size_t num_queued{
+                QueueCacheFile(workers, glsl_precompiler, spirv_precompiler, path, type)};
+            LOG_INFO(Shader, "Queued {} pipelines from {}", num_queued,
+                     Common::FS::PathToUTF8String(path));
+        }
+        workers.WaitForRequests();
+    }
+    const auto wall_time{Clock::now() - start};
+
+    PrintReport(statistics, wall_time, options.num_threads);
+    if (!options.csv_file.empty()) {
+        WriteCsv(options.csv_file, statistics.records);
+    }
+    return statistics.failed_pipelines == 0 ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstdint>
+
+#include "common/alignment.h"
+#include "shader_recompiler/arena.h"
+
+namespace Shader {
+
+void Arena::Reset() noexcept {
+    if (blocks.size() > 1) {
+        // More than one block was needed, squash the memory into a single block that fits the
+        // whole working set of the largest program seen so far
+        const size_t total_size{static_cast<size_t>(statistics.reserved_bytes)};
+        blocks.clear();
+        statistics.reserved_bytes = 0;
+        AllocateBlock(total_size);
+    }
+    current_block = 0;
+    current_offset = 0;
+    statistics.num_allocations = 0;
+    statistics.bytes_allocated = 0;
+    ++statistics.num_resets;
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment) {
+    while (current_block < blocks.size()) {
+        Block& block{blocks[current_block]};
+        const uintptr_t base{reinterpret_cast<uintptr_t>(block.data.get())};
+        const size_t offset{Common::AlignUp(base + current_offset, alignment) - base};
+        if (offset + bytes <= block.size) {
+            current_offset = offset + bytes;
+            ++statistics.num_allocations;
+            statistics.bytes_allocated += bytes;
+            statistics.peak_bytes_allocated =
+                std::max(statistics.peak_bytes_allocated, statistics.bytes_allocated);
+            return block.data.get() + offset;
+        }
+        ++current_block;
+        current_offset = 0;
+    }
+    AllocateBlock(bytes + alignment);
+    return do_allocate(bytes, alignment);
+}
+
+void Arena::AllocateBlock(size_t min_size) {
+    const size_t size{std::max(block_size, min_size)};
+    blocks.push_back(Block{
+        .data = std::make_unique_for_overwrite<std::byte[]>(size),
+        .size = size,
+    });
+    ++statistics.num_upstream_allocations;
+    statistics.reserved_bytes += size;
+}
+
+} // namespace Shader
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Shader {
+
+/// Monotonic memory resource for the transient allocations made while translating a program.
+/// Individual deallocations are no-ops, memory is recycled for the next program by Reset(), so
+/// once the arena has grown to the working set of the largest program translation no longer
+/// touches the global heap.
+class Arena final : public std::pmr::memory_resource {
+public:
+    struct Statistics {
+        u64 num_allocations{};          ///< Allocations served since the last reset
+        u64 bytes_allocated{};          ///< Bytes served since the last reset
+        u64 peak_bytes_allocated{};     ///< Highest number of bytes served between two resets
+        u64 num_upstream_allocations{}; ///< Blocks requested from the global heap
+        u64 num_resets{};               ///< Number of times the arena has been reset
+        u64 reserved_bytes{};           ///< Bytes currently owned by the arena
+    };
+
+    explicit Arena(size_t block_size_ = 64 * 1024) : block_size{block_size_} {}
+    ~Arena() override = default;
+
+    Arena& operator=(Arena&&) noexcept = default;
+    Arena(Arena&&) noexcept = default;
+
+    Arena& operator=(const Arena&) = delete;
+    Arena(const Arena&) = delete;
+
+    /// Releases every allocation, keeping the memory for the next program
+    void Reset() noexcept;
+
+    [[nodiscard]] const Statistics& GetStatistics() const noexcept {
+        return statistics;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size{};
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+
+    void do_deallocate(void*, size_t, size_t) noexcept override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void AllocateBlock(size_t min_size);
+
+    std::vector<Block> blocks;
+    size_t current_block{};
+    size_t current_offset{};
+    size_t block_size{};
+    Statistics statistics{};
+};
+
+} // namespace Shader
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -13,13 +14,13 @@
 #include <boost/intrusive/list.hpp>
 
 #include "common/polyfill_ranges.h"
+#include "shader_recompiler/arena.h"
 #include "shader_recompiler/environment.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
 #include "shader_recompiler/frontend/ir/ir_emitter.h"
 #include "shader_recompiler/frontend/maxwell/structured_control_flow.h"
 #include "shader_recompiler/frontend/maxwell/translate/translate.h"
 #include "shader_recompiler/host_translate_info.h"
-#include "shader_recompiler/object_pool.h"
 
 namespace Shader::Maxwell {
 namespace {
@@ -148,6 +149,21 @@ struct Statement : ListBaseHook {
 #pragma warning(pop)
 #endif
 
+/// Allocates statements from the translation arena.
+/// Statements are never destroyed, their hooks use normal_link so the tree can be dropped as is.
+class StatementPool {
+public:
+    explicit StatementPool(Arena& arena) : allocator{&arena} {}
+
+    template <typename... Args>
+    [[nodiscard]] Statement* Create(Args&&... args) {
+        return allocator.new_object<Statement>(std::forward<Args>(args)...);
+    }
+
+private:
+    std::pmr::polymorphic_allocator<Statement> allocator;
+};
+
 std::string DumpExpr(const Statement* stmt) {
     switch (stmt->type) {
     case StatementType::Identity:
@@ -311,8 +327,9 @@ bool NeedsLift(Node goto_stmt, Node label_stmt) noexcept {
 
 class GotoPass {
 public:
-    explicit GotoPass(Flow::CFG& cfg, ObjectPool<Statement>& stmt_pool) : pool{stmt_pool} {
-        std::vector gotos{BuildTree(cfg)};
+    explicit GotoPass(Flow::CFG& cfg, StatementPool& stmt_pool, Arena& arena_)
+        : pool{stmt_pool}, arena{arena_} {
+        const std::pmr::vector<Node> gotos{BuildTree(cfg)};
         const auto end{gotos.rend()};
         for (auto goto_stmt = gotos.rbegin(); goto_stmt != end; ++goto_stmt) {
             RemoveGoto(*goto_stmt);
@@ -374,20 +391,20 @@ private:
         }
     }
 
-    std::vector<Node> BuildTree(Flow::CFG& cfg) {
+    std::pmr::vector<Node> BuildTree(Flow::CFG& cfg) {
         u32 label_id{0};
-        std::vector<Node> gotos;
+        std::pmr::vector<Node> gotos{&arena};
         Flow::Function& first_function{cfg.Functions().front()};
         BuildTree(cfg, first_function, label_id, gotos, root_stmt.children.end(), std::nullopt);
         return gotos;
     }
 
     void BuildTree(Flow::CFG& cfg, Flow::Function& function, u32& label_id,
-                   std::vector<Node>& gotos, Node function_insert_point,
+                   std::pmr::vector<Node>& gotos, Node function_insert_point,
                    std::optional<Node> return_label) {
         Statement* const false_stmt{pool.Create(Identity{}, IR::Condition{false}, &root_stmt)};
         Tree& root{root_stmt.children};
-        std::unordered_map<Flow::Block*, Node> local_labels;
+        std::pmr::unordered_map<Flow::Block*, Node> local_labels{&arena};
         local_labels.reserve(function.blocks.size());
 
         for (Flow::Block& block : function.blocks) {
@@ -613,7 +630,8 @@ private:
         return parent_tree.insert(std::next(loop), *new_goto);
     }
 
-    ObjectPool<Statement>& pool;
+    StatementPool& pool;
+    Arena& arena;
     Statement root_stmt{FunctionTag{}};
 };
 
@@ -650,10 +668,10 @@ private:
 class TranslatePass {
 public:
     TranslatePass(ObjectPool<IR::Inst>& inst_pool_, ObjectPool<IR::Block>& block_pool_,
-                  ObjectPool<Statement>& stmt_pool_, Environment& env_, Statement& root_stmt,
+                  StatementPool& stmt_pool_, Arena& arena_, Environment& env_, Statement& root_stmt,
                   IR::AbstractSyntaxList& syntax_list_, const HostTranslateInfo& host_info)
-        : stmt_pool{stmt_pool_}, inst_pool{inst_pool_}, block_pool{block_pool_}, env{env_},
-          syntax_list{syntax_list_} {
+        : stmt_pool{stmt_pool_}, inst_pool{inst_pool_}, block_pool{block_pool_}, arena{arena_},
+          env{env_}, syntax_list{syntax_list_} {
         Visit(root_stmt, nullptr, nullptr);
 
         IR::Block& first_block{*syntax_list.front().data.block};
@@ -867,8 +885,8 @@ private:
 
     void DemoteCombinationPass() {
         using Type = IR::AbstractSyntaxNode::Type;
-        std::vector<IR::Block*> demote_blocks;
-        std::vector<IR::U1> demote_conds;
+        std::pmr::vector<IR::Block*> demote_blocks{&arena};
+        std::pmr::vector<IR::U1> demote_conds{&arena};
         u32 num_epilogues{};
         u32 branch_depth{};
         for (const IR::AbstractSyntaxNode& node : syntax_list) {
@@ -970,9 +988,10 @@ private:
         asl.insert(next_it_2, demote_if_node);
     }
 
-    ObjectPool<Statement>& stmt_pool;
+    StatementPool& stmt_pool;
     ObjectPool<IR::Inst>& inst_pool;
     ObjectPool<IR::Block>& block_pool;
+    Arena& arena;
     Environment& env;
     IR::AbstractSyntaxList& syntax_list;
     bool uses_demote_to_helper{};
@@ -981,13 +1000,13 @@ private:
 } // Anonymous namespace
 
 IR::AbstractSyntaxList BuildASL(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
-                                Environment& env, Flow::CFG& cfg,
+                                Arena& arena, Environment& env, Flow::CFG& cfg,
                                 const HostTranslateInfo& host_info) {
-    ObjectPool<Statement> stmt_pool{64};
-    GotoPass goto_pass{cfg, stmt_pool};
+    StatementPool stmt_pool{arena};
+    GotoPass goto_pass{cfg, stmt_pool, arena};
     Statement& root{goto_pass.RootStatement()};
     IR::AbstractSyntaxList syntax_list;
-    TranslatePass{inst_pool, block_pool, stmt_pool, env, root, syntax_list, host_info};
+    TranslatePass{inst_pool, block_pool, stmt_pool, arena, env, root, syntax_list, host_info};
     return syntax_list;
 }
 
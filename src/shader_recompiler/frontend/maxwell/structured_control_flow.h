@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "shader_recompiler/arena.h"
 #include "shader_recompiler/environment.h"
 #include "shader_recompiler/frontend/ir/abstract_syntax_list.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
@@ -15,8 +16,9 @@ struct HostTranslateInfo;
 namespace Maxwell {
 
 [[nodiscard]] IR::AbstractSyntaxList BuildASL(ObjectPool<IR::Inst>& inst_pool,
-                                              ObjectPool<IR::Block>& block_pool, Environment& env,
-                                              Flow::CFG& cfg, const HostTranslateInfo& host_info);
+                                              ObjectPool<IR::Block>& block_pool, Arena& arena,
+                                              Environment& env, Flow::CFG& cfg,
+                                              const HostTranslateInfo& host_info);
 
 } // namespace Maxwell
 } // namespace Shader
@@ -238,9 +238,10 @@ void LowerGeometryPassthrough(const IR::Program& program, const HostTranslateInf
 } // Anonymous namespace
 
 IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
-                             Environment& env, Flow::CFG& cfg, const HostTranslateInfo& host_info) {
+                             Arena& arena, Environment& env, Flow::CFG& cfg,
+                             const HostTranslateInfo& host_info) {
     IR::Program program;
-    program.syntax_list = BuildASL(inst_pool, block_pool, env, cfg, host_info);
+    program.syntax_list = BuildASL(inst_pool, block_pool, arena, env, cfg, host_info);
     program.blocks = GenerateBlocks(program.syntax_list);
     program.post_order_blocks = PostOrder(program.syntax_list.front());
     program.stage = env.ShaderStage();
@@ -292,7 +293,7 @@ IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Blo
     if (!host_info.support_conditional_barrier) {
         Optimization::ConditionalBarrierPass(program);
     }
-    Optimization::SsaRewritePass(program);
+    Optimization::SsaRewritePass(program, arena);
 
     Optimization::ConstantPropagationPass(env, program);
 
@@ -411,7 +412,7 @@ void ConvertLegacyToGeneric(IR::Program& program, const Shader::RuntimeInfo& run
 }
 
 IR::Program GenerateGeometryPassthrough(ObjectPool<IR::Inst>& inst_pool,
-                                        ObjectPool<IR::Block>& block_pool,
+                                        ObjectPool<IR::Block>& block_pool, Arena& arena,
                                         const HostTranslateInfo& host_info,
                                         IR::Program& source_program,
                                         Shader::OutputTopology output_topology) {
@@ -446,7 +447,7 @@ IR::Program GenerateGeometryPassthrough(ObjectPool<IR::Inst>& inst_pool,
 
     program.blocks = GenerateBlocks(program.syntax_list);
     program.post_order_blocks = PostOrder(program.syntax_list.front());
-    Optimization::SsaRewritePass(program);
+    Optimization::SsaRewritePass(program, arena);
 
     return program;
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "shader_recompiler/arena.h"
 #include "shader_recompiler/environment.h"
 #include "shader_recompiler/frontend/ir/program.h"
 
@@ -22,7 +23,7 @@ void LowerFp64ToFp32(IR::Program& program);
 void LowerFp16ToFp32(IR::Program& program);
 void LowerInt64ToInt32(IR::Program& program);
 void RescalingPass(IR::Program& program);
-void SsaRewritePass(IR::Program& program);
+void SsaRewritePass(IR::Program& program, Arena& arena);
 void PositionPass(Environment& env, IR::Program& program);
 void TexturePass(Environment& env, IR::Program& program, const HostTranslateInfo& host_info);
 void LayerPass(IR::Program& program, const HostTranslateInfo& host_info);
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/bounded_threadsafe_queue.h"
+#include "common/common_types.h"
+
+namespace Common {
+
+TEST_CASE("SPSCQueue: Single thread", "[common]") {
+    SPSCQueue<u32, 4> queue;
+    for (u32 i = 0; i < 4; ++i) {
+        REQUIRE(queue.TryEmplace(i));
+    }
+    REQUIRE(!queue.TryEmplace(4U));
+
+    u32 value{};
+    for (u32 i = 0; i < 4; ++i) {
+        REQUIRE(queue.TryPop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE(!queue.TryPop(value));
+}
+
+TEST_CASE("SPSCQueue: Parked threads are woken", "[common]") {
+    // A tiny ring makes both sides park repeatedly, on an empty and on a full queue
+    static constexpr u32 COUNT = 200'000;
+    SPSCQueue<u32, 2> queue;
+
+    std::jthread producer{[&queue] {
+        for (u32 i = 0; i < COUNT; ++i) {
+            queue.EmplaceWait(i);
+        }
+    }};
+    bool in_order = true;
+    for (u32 i = 0; i < COUNT; ++i) {
+        in_order &= queue.PopWait() == i;
+    }
+    REQUIRE(in_order);
+}
+
+TEST_CASE("SPSCQueue: Stop token wakes a parked consumer", "[common]") {
+    SPSCQueue<u32, 4> queue;
+    std::stop_source stop_source;
+    std::jthread consumer{[&queue, token = stop_source.get_token()] {
+        u32 value{};
+        queue.PopWait(value, token);
+    }};
+    stop_source.request_stop();
+    consumer.join();
+    SUCCEED();
+}
+
+TEST_CASE("SPSCQueue: Deferred emplaces reach a parked consumer", "[common]") {
+    static constexpr u32 COUNT = 60'000;
+    static constexpr u32 BATCH = 5;
+    SPSCQueue<u32, 4> queue;
+
+    std::jthread producer{[&queue] {
+        for (u32 i = 0; i < COUNT; i += BATCH) {
+            for (u32 j = i; j < i + BATCH; ++j) {
+                queue.EmplaceWaitDeferred(j);
+            }
+            queue.Flush();
+        }
+    }};
+    bool in_order = true;
+    for (u32 i = 0; i < COUNT; ++i) {
+        in_order &= queue.PopWait() == i;
+    }
+    REQUIRE(in_order);
+}
+
+} // namespace Common
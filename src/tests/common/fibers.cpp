@@ -11,6 +11,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "common/common_types.h"
@@ -310,4 +311,106 @@ TEST_CASE("Fibers::Rewind", "[common]") {
     REQUIRE(test_control.rewinded);
 }
 
+thread_local u64 handed_over_value = 0;
+
+class TestControl5 {
+public:
+    explicit TestControl5(bool use_host_threads) {
+        Fiber::HostThreadHandoff handoff;
+        handoff.save = [](Fiber::HandoffState& state) { state[0] = handed_over_value; };
+        handoff.restore = [](const Fiber::HandoffState& state) { handed_over_value = state[0]; };
+        Fiber::SetUseHostThreads(use_host_threads, std::move(handoff));
+        thread_fiber = Fiber::ThreadToFiber();
+        fiber1 = std::make_shared<Fiber>([this] { DoWork(); });
+    }
+
+    ~TestControl5() {
+        thread_fiber->Exit();
+        Fiber::SetUseHostThreads(false);
+    }
+
+    void Switch() {
+        Fiber::YieldTo(thread_fiber, *fiber1);
+    }
+
+    void DoWork() {
+        while (true) {
+            fiber_thread_id = std::this_thread::get_id();
+            seen_value = handed_over_value;
+            handed_over_value = seen_value + 1;
+            if (on_work) {
+                on_work();
+            }
+            Fiber::YieldTo(fiber1, *thread_fiber);
+        }
+    }
+
+    std::shared_ptr<Common::Fiber> fiber1;
+    std::shared_ptr<Common::Fiber> thread_fiber;
+    std::function<void()> on_work;
+    std::thread::id fiber_thread_id;
+    u64 seen_value{};
+};
+
+/** This test checks that fibers backed by host threads run on a thread of their own, and that
+ *  the handoff carries thread local state along with each switch.
+ */
+TEST_CASE("Fibers::HostThreads", "[common]") {
+    TestControl5 test_control{true};
+    handed_over_value = 10;
+    test_control.Switch();
+    REQUIRE(test_control.fiber_thread_id != std::this_thread::get_id());
+    REQUIRE(test_control.seen_value == 10);
+    REQUIRE(handed_over_value == 11);
+
+    handed_over_value = 20;
+    test_control.Switch();
+    REQUIRE(test_control.seen_value == 20);
+    REQUIRE(handed_over_value == 21);
+}
+
+/// Raises a flag when the thread that last set it exits
+struct ThreadExitFlag {
+    ~ThreadExitFlag() {
+        if (flag) {
+            *flag = true;
+        }
+    }
+
+    std::atomic_bool* flag{};
+};
+
+thread_local ThreadExitFlag thread_exit_flag;
+
+/** This test checks that destroying a fiber whose host thread is parked in the middle of it
+ *  ends that thread instead of leaving it behind.
+ */
+TEST_CASE("Fibers::HostThreadsDestroyParked", "[common]") {
+    std::atomic_bool exited{};
+    TestControl5 test_control{true};
+    test_control.on_work = [&exited] { thread_exit_flag.flag = &exited; };
+    test_control.Switch();
+    REQUIRE(!exited);
+
+    test_control.fiber1.reset();
+    REQUIRE(exited);
+}
+
+TEST_CASE("Fibers: Benchmark", "[.benchmark]") {
+    {
+        TestControl5 test_control{false};
+        BENCHMARK("Switch to a fiber and back") {
+            test_control.Switch();
+            return handed_over_value;
+        };
+    }
+    {
+        TestControl5 test_control{true};
+        BENCHMARK("Wake up a host thread and back") {
+            test_control.Switch();
+            return handed_over_value;
+        };
+    }
+}
+
 } // namespace Common
@@ -1,6 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "common/host_memory.h"
@@ -184,3 +190,132 @@ TEST_CASE("HostMemory: Partial sparse middle unmap and check bindings", "[common
     REQUIRE(ptr[0x0000] == 19);
     REQUIRE(ptr[0x3fff] == 12);
 }
+
+TEST_CASE("HostMemory: View aliases the owner backing", "[common]") {
+    HostMemory mem(BACKING_SIZE, VIRTUAL_SIZE);
+    HostMemory view(mem, 16_GiB);
+    mem.Map(0x5000, 0x8000, 0x1000, PERMS, HEAP);
+    view.Map(0x20000, 0x7000, 0x2000, PERMS, HEAP);
+
+    REQUIRE(view.BackingBasePointer() == nullptr);
+    volatile u8* const data = mem.VirtualBasePointer() + 0x5000;
+    volatile u8* const alias = view.VirtualBasePointer() + 0x21000;
+    alias[0x10] = 33;
+    REQUIRE(data[0x10] == 33);
+    REQUIRE(mem.BackingBasePointer()[0x8010] == 33);
+
+    view.Unmap(0x20000, 0x2000, HEAP);
+    data[0x20] = 44;
+    REQUIRE(mem.BackingBasePointer()[0x8020] == 44);
+}
+
+#ifndef _WIN32
+TEST_CASE("HostMemory: View mappings are replaced in place", "[common]") {
+    HostMemory mem(BACKING_SIZE, VIRTUAL_SIZE);
+    HostMemory view(mem, 16_GiB);
+    mem.Map(0x4000, 0x2000, 0x2000, PERMS, HEAP);
+    volatile u8* const data = mem.VirtualBasePointer() + 0x4000;
+    data[0x0010] = 21;
+    data[0x1010] = 42;
+
+    volatile u8* const alias = view.VirtualBasePointer() + 0x10000;
+    view.Map(0x10000, 0x2000, 0x1000, PERMS, HEAP);
+    REQUIRE(alias[0x10] == 21);
+    view.Map(0x10000, 0x3000, 0x1000, PERMS, HEAP);
+    REQUIRE(alias[0x10] == 42);
+}
+#endif
+
+TEST_CASE("HostMemory: View outlives its owner", "[common]") {
+    auto mem = std::make_unique<HostMemory>(BACKING_SIZE, VIRTUAL_SIZE);
+    HostMemory view(*mem, 16_GiB);
+    view.Map(0x3000, 0x1000, 0x1000, PERMS, HEAP);
+    mem.reset();
+
+    volatile u8* const data = view.VirtualBasePointer() + 0x3000;
+    data[0] = 12;
+    REQUIRE(data[0] == 12);
+}
+
+TEST_CASE("HostMemory: Benchmark", "[.benchmark]") {
+    // Models a device DMA copy of 1 MiB whose pages are scattered over physical memory
+    static constexpr size_t PAGE_SIZE = 0x1000;
+    static constexpr size_t NUM_PAGES = 1_MiB / PAGE_SIZE;
+    static constexpr size_t PHYSICAL_PAGES = 64_MiB / PAGE_SIZE;
+    HostMemory mem(BACKING_SIZE, VIRTUAL_SIZE);
+    HostMemory view(mem, 16_GiB);
+    std::vector<size_t> page_table(NUM_PAGES);
+    for (size_t page = 0; page < NUM_PAGES; ++page) {
+        page_table[page] = (page * 7919) % PHYSICAL_PAGES;
+        view.Map(page * PAGE_SIZE, page_table[page] * PAGE_SIZE, PAGE_SIZE, PERMS, HEAP);
+    }
+    std::vector<u8> destination(1_MiB);
+
+    BENCHMARK("Copy walking the page table") {
+        const u8* const backing = mem.BackingBasePointer();
+        for (size_t page = 0; page < NUM_PAGES; ++page) {
+            std::memcpy(destination.data() + page * PAGE_SIZE,
+                        backing + page_table[page] * PAGE_SIZE, PAGE_SIZE);
+        }
+        return destination[PAGE_SIZE];
+    };
+    BENCHMARK("Copy through the view") {
+        std::memcpy(destination.data(), view.VirtualBasePointer(), 1_MiB);
+        return destination[PAGE_SIZE];
+    };
+}
+
+TEST_CASE("HostMemory: Huge pages keep the mappings intact", "[common]") {
+    HostMemory mem(BACKING_SIZE, VIRTUAL_SIZE);
+    mem.EnableHugePages();
+    mem.Map(0x200000, 0x400000, 0x400000, PERMS, HEAP);
+    mem.Map(0x1000, 0x3000, 0x1000, PERMS, HEAP);
+
+    volatile u8* const data = mem.VirtualBasePointer();
+    data[0x200000 + 0x1234] = 21;
+    data[0x1000] = 22;
+    REQUIRE(mem.BackingBasePointer()[0x401234] == 21);
+    REQUIRE(mem.BackingBasePointer()[0x3000] == 22);
+
+    mem.Unmap(0x300000, 0x100000, HEAP);
+    REQUIRE(data[0x200000 + 0x1234] == 21);
+}
+
+TEST_CASE("HostMemory: Huge page benchmark", "[.benchmark]") {
+    // Random reads over a large working set are bound by TLB misses with 4 KiB pages
+    static constexpr size_t WORKING_SET = 512_MiB;
+    static constexpr size_t NUM_READS = 1 << 20;
+    std::mt19937_64 rng{0x5eed};
+    std::vector<size_t> offsets(NUM_READS);
+    for (size_t& offset : offsets) {
+        offset = (rng() % WORKING_SET) & ~size_t{7};
+    }
+    const auto make_memory = [](bool huge_pages) {
+        auto mem = std::make_unique<HostMemory>(BACKING_SIZE, VIRTUAL_SIZE);
+        if (huge_pages) {
+            mem->EnableHugePages();
+        }
+        mem->Map(0, 0, WORKING_SET, PERMS, HEAP);
+        std::memset(mem->VirtualBasePointer(), 1, WORKING_SET);
+        return mem;
+    };
+    const auto random_reads = [&offsets](const HostMemory& mem) {
+        const u8* const base = mem.VirtualBasePointer();
+        u64 sum = 0;
+        for (const size_t offset : offsets) {
+            u64 value;
+            std::memcpy(&value, base + offset, sizeof(value));
+            sum += value;
+        }
+        return sum;
+    };
+
+    const auto small_pages = make_memory(false);
+    BENCHMARK("Random reads with 4 KiB pages") {
+        return random_reads(*small_pages);
+    };
+    const auto huge_pages = make_memory(true);
+    BENCHMARK("Random reads with huge pages") {
+        return random_reads(*huge_pages);
+    };
+}
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2016 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include <array>
@@ -10,6 +11,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -40,6 +42,37 @@ struct ScopeInit final {
     Core::Timing::CoreTiming core_timing;
 };
 
+/// Core timing without a host timer thread, time only moves when ticks are added
+struct ManualInit final {
+    ManualInit() {
+        core_timing.SetMulticore(false);
+        core_timing.Initialize([]() {});
+    }
+
+    /// Moves emulated time forward and runs every event that became due
+    void Run(u64 ticks) {
+        core_timing.AddTicks(ticks);
+        core_timing.Advance();
+    }
+
+    Core::Timing::CoreTiming core_timing;
+};
+
+std::vector<std::shared_ptr<Core::Timing::EventType>> MakeCountingEvents(size_t count,
+                                                                         u64& counter) {
+    std::vector<std::shared_ptr<Core::Timing::EventType>> events;
+    events.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        events.push_back(Core::Timing::CreateEvent(
+            "counter", [&counter](s64, std::chrono::nanoseconds)
+                           -> std::optional<std::chrono::nanoseconds> {
+                ++counter;
+                return std::nullopt;
+            }));
+    }
+    return events;
+}
+
 u64 TestTimerSpeed(Core::Timing::CoreTiming& core_timing) {
     const u64 start = core_timing.GetGlobalTimeNs().count();
     volatile u64 placebo = 0;
@@ -139,3 +172,80 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
            timer_time / 1000000.f);
 }
+
+TEST_CASE("CoreTiming[Unschedule]", "[core]") {
+    ManualInit guard;
+    auto& core_timing = guard.core_timing;
+    u64 fired = 0;
+    const auto events = MakeCountingEvents(4, fired);
+
+    for (const auto& event : events) {
+        core_timing.ScheduleEvent(std::chrono::microseconds{1}, event);
+    }
+    core_timing.UnscheduleEvent(events[1], Core::Timing::UnscheduleEventType::NoWait);
+    core_timing.UnscheduleEvent(events[2], Core::Timing::UnscheduleEventType::NoWait);
+    // Scheduling again after unscheduling must not be affected by the earlier unschedule
+    core_timing.ScheduleEvent(std::chrono::microseconds{1}, events[2]);
+
+    guard.Run(100'000);
+    REQUIRE(fired == 3);
+    REQUIRE(!core_timing.Advance().has_value());
+}
+
+TEST_CASE("CoreTiming[LoopingEvent]", "[core]") {
+    ManualInit guard;
+    auto& core_timing = guard.core_timing;
+    u64 fired = 0;
+    const auto events = MakeCountingEvents(1, fired);
+
+    core_timing.ScheduleLoopingEvent(std::chrono::microseconds{1}, std::chrono::microseconds{1},
+                                     events[0]);
+    for (int i = 0; i < 10; ++i) {
+        guard.Run(100'000);
+    }
+    REQUIRE(fired >= 10);
+    REQUIRE(core_timing.Advance().has_value());
+
+    core_timing.UnscheduleEvent(events[0], Core::Timing::UnscheduleEventType::NoWait);
+    const u64 fired_before = fired;
+    guard.Run(100'000);
+    REQUIRE(fired == fired_before);
+    REQUIRE(!core_timing.Advance().has_value());
+}
+
+TEST_CASE("CoreTiming[Benchmark]", "[.benchmark]") {
+    static constexpr size_t NUM_EVENTS = 4096;
+    u64 fired = 0;
+    const auto events = MakeCountingEvents(NUM_EVENTS, fired);
+
+    // One instance serves every iteration, so the figures exclude creating the timer and
+    // include the reuse of its queue storage. Each iteration starts from an empty queue.
+    ManualInit guard;
+    auto& core_timing = guard.core_timing;
+    const auto schedule_all = [&events, &core_timing] {
+        core_timing.ClearPendingEvents();
+        for (size_t i = 0; i < events.size(); ++i) {
+            // Spread the events over 1 to 4 ms, out of order
+            const auto delay = std::chrono::nanoseconds{1'000'000 + (i * 7919) % 3'000'000};
+            core_timing.ScheduleEvent(delay, events[i]);
+        }
+    };
+
+    BENCHMARK("Schedule 4096 events") {
+        schedule_all();
+        return core_timing.Advance();
+    };
+    BENCHMARK("Schedule and unschedule 4096 events") {
+        schedule_all();
+        core_timing.Advance();
+        for (const auto& event : events) {
+            core_timing.UnscheduleEvent(event, Core::Timing::UnscheduleEventType::NoWait);
+        }
+        return core_timing.Advance();
+    };
+    BENCHMARK("Schedule and fire 4096 events") {
+        schedule_all();
+        guard.Run(10'000'000);
+        return fired;
+    };
+}
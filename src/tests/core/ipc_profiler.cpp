@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/hle/service/ipc_profiler.h"
+
+namespace Service::IpcProfiler {
+
+TEST_CASE("IpcProfiler: Services sharing a name share an identifier", "[core]") {
+    const u32 id = RegisterService("test:same");
+    REQUIRE(RegisterService("test:same") == id);
+    REQUIRE(RegisterService("test:other") != id);
+}
+
+TEST_CASE("IpcProfiler: Tables of every thread are merged", "[core]") {
+    Reset();
+    const u32 fast = RegisterService("test:fast");
+    const u32 slow = RegisterService("test:slow");
+
+    std::jthread worker{[&] {
+        Record(fast, 1, "Ping", 100, 16, 0);
+        Record(slow, 2, "Flush", 1'000'000, 0, 64);
+    }};
+    worker.join();
+    Record(fast, 1, "Ping", 5'000, 32, 8);
+
+    const std::vector<CommandStats> stats = Snapshot();
+    REQUIRE(stats.size() == 2);
+
+    // Sorted by total host time
+    REQUIRE(stats[0].service_name == "test:slow");
+    REQUIRE(stats[0].function_name == "Flush");
+    REQUIRE(stats[0].command == 2);
+    REQUIRE(stats[0].calls == 1);
+    REQUIRE(stats[0].write_bytes == 64);
+
+    REQUIRE(stats[1].service_name == "test:fast");
+    REQUIRE(stats[1].calls == 2);
+    REQUIRE(stats[1].total_ns == 5'100);
+    REQUIRE(stats[1].max_ns == 5'000);
+    REQUIRE(stats[1].read_bytes == 48);
+    REQUIRE(stats[1].write_bytes == 8);
+    REQUIRE(stats[1].histogram[0] == 1);
+    REQUIRE(stats[1].histogram[3] == 1);
+
+    Reset();
+    REQUIRE(Snapshot().empty());
+}
+
+} // namespace Service::IpcProfiler
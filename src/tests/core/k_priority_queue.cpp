@@ -0,0 +1,247 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/hardware_properties.h"
+#include "core/hle/kernel/k_affinity_mask.h"
+#include "core/hle/kernel/k_priority_queue.h"
+
+namespace {
+
+constexpr s32 NumCores = static_cast<s32>(Core::Hardware::NUM_CPU_CORES);
+constexpr s32 LowestPriority = 63;
+
+/// Minimal stand-in for KThread, only holding what the priority queue looks at
+class TestThread {
+public:
+    class QueueEntry {
+    public:
+        constexpr QueueEntry() = default;
+
+        constexpr void Initialize() {
+            m_prev = nullptr;
+            m_next = nullptr;
+        }
+
+        constexpr TestThread* GetPrev() const {
+            return m_prev;
+        }
+        constexpr TestThread* GetNext() const {
+            return m_next;
+        }
+        constexpr void SetPrev(TestThread* thread) {
+            m_prev = thread;
+        }
+        constexpr void SetNext(TestThread* thread) {
+            m_next = thread;
+        }
+
+    private:
+        TestThread* m_prev{};
+        TestThread* m_next{};
+    };
+
+    QueueEntry& GetPriorityQueueEntry(s32 core) {
+        return m_entries[core];
+    }
+    const QueueEntry& GetPriorityQueueEntry(s32 core) const {
+        return m_entries[core];
+    }
+
+    const Kernel::KAffinityMask& GetAffinityMask() const {
+        return m_affinity;
+    }
+    s32 GetActiveCore() const {
+        return m_active_core;
+    }
+    s32 GetPriority() const {
+        return m_priority;
+    }
+    bool IsDummyThread() const {
+        return false;
+    }
+
+    void Set(s32 priority, s32 active_core, u64 affinity) {
+        m_priority = priority;
+        m_active_core = active_core;
+        m_affinity.SetAffinityMask(affinity);
+    }
+    void SetPriority(s32 priority) {
+        m_priority = priority;
+    }
+    void SetActiveCore(s32 core) {
+        m_active_core = core;
+    }
+
+private:
+    std::array<QueueEntry, Core::Hardware::NUM_CPU_CORES> m_entries{};
+    Kernel::KAffinityMask m_affinity{};
+    s32 m_priority{};
+    s32 m_active_core{};
+};
+
+using TestQueue =
+    Kernel::KPriorityQueue<TestThread, Core::Hardware::NUM_CPU_CORES, LowestPriority, 0>;
+
+/// Picks a random priority, affinity and an active core within the affinity
+void Randomize(TestThread& thread, std::mt19937& rng) {
+    const u64 affinity = std::uniform_int_distribution<u64>{1, (1ULL << NumCores) - 1}(rng);
+    std::vector<s32> cores;
+    for (s32 core = 0; core < NumCores; ++core) {
+        if ((affinity >> core) & 1) {
+            cores.push_back(core);
+        }
+    }
+    const s32 active_core = cores[std::uniform_int_distribution<size_t>{0, cores.size() - 1}(rng)];
+    const s32 priority = std::uniform_int_distribution<s32>{0, LowestPriority}(rng);
+    thread.Set(priority, active_core, affinity);
+}
+
+/// Compares the queue fronts and core masks against the threads known to be queued
+void Validate(const TestQueue& queue, const std::vector<TestThread>& threads,
+              const std::vector<bool>& queued) {
+    for (s32 core = 0; core < NumCores; ++core) {
+        s32 best_scheduled = LowestPriority + 1;
+        s32 best_suggested = LowestPriority + 1;
+        for (size_t i = 0; i < threads.size(); ++i) {
+            if (!queued[i]) {
+                continue;
+            }
+            const TestThread& thread = threads[i];
+            if (thread.GetActiveCore() == core) {
+                best_scheduled = std::min(best_scheduled, thread.GetPriority());
+            } else if (thread.GetAffinityMask().GetAffinity(core)) {
+                best_suggested = std::min(best_suggested, thread.GetPriority());
+            }
+        }
+
+        const TestThread* const scheduled = queue.GetScheduledFront(core);
+        const TestThread* const suggested = queue.GetSuggestedFront(core);
+        REQUIRE((scheduled == nullptr) == (best_scheduled > LowestPriority));
+        REQUIRE((suggested == nullptr) == (best_suggested > LowestPriority));
+        if (scheduled != nullptr) {
+            REQUIRE(scheduled->GetPriority() == best_scheduled);
+        }
+        if (suggested != nullptr) {
+            REQUIRE(suggested->GetPriority() == best_suggested);
+        }
+
+        const u64 core_bit = 1ULL << core;
+        REQUIRE(((queue.GetScheduledCores() & core_bit) != 0) == (scheduled != nullptr));
+        REQUIRE(((queue.GetSuggestedCores() & core_bit) != 0) == (suggested != nullptr));
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("KPriorityQueue: Core masks follow the queues", "[core]") {
+    std::mt19937 rng{1234};
+    std::vector<TestThread> threads(64);
+    std::vector<bool> queued(threads.size());
+    TestQueue queue;
+
+    REQUIRE(queue.GetScheduledCores() == 0);
+    REQUIRE(queue.GetSuggestedCores() == 0);
+
+    std::uniform_int_distribution<size_t> pick{0, threads.size() - 1};
+    for (int step = 0; step < 4096; ++step) {
+        const size_t index = pick(rng);
+        TestThread& thread = threads[index];
+        if (!queued[index]) {
+            Randomize(thread, rng);
+            queue.PushBack(&thread);
+            queued[index] = true;
+        } else {
+            switch (rng() % 4) {
+            case 0:
+                queue.Remove(&thread);
+                queued[index] = false;
+                break;
+            case 1: {
+                const s32 prev_priority = thread.GetPriority();
+                thread.SetPriority(std::uniform_int_distribution<s32>{0, LowestPriority}(rng));
+                queue.ChangePriority(prev_priority, false, &thread);
+                break;
+            }
+            case 2: {
+                // Affinity changes keep the priority the thread was queued with.
+                const s32 prev_core = thread.GetActiveCore();
+                const Kernel::KAffinityMask prev_affinity = thread.GetAffinityMask();
+                const s32 priority = thread.GetPriority();
+                Randomize(thread, rng);
+                thread.SetPriority(priority);
+                queue.ChangeAffinityMask(prev_core, prev_affinity, &thread);
+                break;
+            }
+            case 3: {
+                const s32 prev_core = thread.GetActiveCore();
+                const u64 affinity = thread.GetAffinityMask().GetAffinityMask();
+                thread.SetActiveCore(std::countr_zero(affinity));
+                queue.ChangeCore(prev_core, &thread);
+                break;
+            }
+            }
+        }
+        Validate(queue, threads, queued);
+    }
+}
+
+TEST_CASE("KPriorityQueue: Benchmark", "[.benchmark]") {
+    constexpr size_t NumThreads = 4096;
+
+    std::mt19937 rng{5678};
+    std::vector<TestThread> threads(NumThreads);
+    TestQueue queue;
+    for (TestThread& thread : threads) {
+        Randomize(thread, rng);
+        queue.PushBack(&thread);
+    }
+
+    // Priority changes through the queue, followed by the top thread selection of the scheduler.
+    std::vector<s32> new_priorities(NumThreads);
+    for (s32& priority : new_priorities) {
+        priority = std::uniform_int_distribution<s32>{0, LowestPriority}(rng);
+    }
+    size_t index = 0;
+    BENCHMARK("Reschedule 4096 threads") {
+        index = (index + 1) % NumThreads;
+        TestThread& thread = threads[index];
+        const s32 prev_priority = thread.GetPriority();
+        thread.SetPriority(new_priorities[index]);
+        new_priorities[index] = prev_priority;
+        queue.ChangePriority(prev_priority, false, &thread);
+
+        u64 selected = 0;
+        const u64 scheduled_cores = queue.GetScheduledCores();
+        for (s32 core = 0; core < NumCores; ++core) {
+            if ((scheduled_cores & (1ULL << core)) != 0) {
+                selected += queue.GetScheduledFront(core)->GetPriority();
+            }
+        }
+        return selected;
+    };
+
+    // The same selection with only a few runnable threads, leaving most cores idle.
+    for (size_t i = 2; i < NumThreads; ++i) {
+        queue.Remove(&threads[i]);
+    }
+    BENCHMARK("Select with idle cores") {
+        u64 selected = 0;
+        u64 idle_cores = ~queue.GetScheduledCores() & ((1ULL << NumCores) - 1);
+        idle_cores &= queue.GetSuggestedCores();
+        while (idle_cores != 0) {
+            const s32 core = std::countr_zero(idle_cores);
+            selected += queue.GetSuggestedFront(core)->GetPriority();
+            idle_cores &= idle_cores - 1;
+        }
+        return selected;
+    };
+}
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/hle/service/server_thread_slots.h"
+
+namespace {
+
+/// Stand-in for ServerManager, the slots only compare server addresses
+struct TestServer {
+    int id;
+};
+
+std::vector<TestServer*> Registered(const Service::ServerThreadSlots<TestServer>& slots) {
+    std::vector<TestServer*> servers;
+    slots.ForEachRegistered([&](TestServer* server) { servers.push_back(server); });
+    return servers;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ServerThreadSlots: Register and unregister", "[core]") {
+    Service::ServerThreadSlots<TestServer> slots;
+    TestServer first{1};
+    TestServer second{2};
+
+    slots.Add(&first, 1);
+    slots.Add(&second, 1);
+    REQUIRE(Registered(slots) == std::vector<TestServer*>{&first, &second});
+
+    slots.Remove(&first);
+    REQUIRE(!slots.Contains(&first));
+    REQUIRE(Registered(slots) == std::vector<TestServer*>{&second});
+    REQUIRE(!slots.TryAcquire(&first));
+
+    // A server with requests in flight is only forgotten once they are released.
+    REQUIRE(slots.TryAcquire(&second));
+    slots.Remove(&second);
+    REQUIRE(Registered(slots).empty());
+    REQUIRE(slots.Contains(&second));
+    REQUIRE(!slots.TryAcquire(&second));
+    slots.Release(&second);
+    REQUIRE(!slots.Contains(&second));
+
+    // Servers can be registered again after they are gone.
+    slots.Add(&first, 2);
+    REQUIRE(Registered(slots) == std::vector<TestServer*>{&first});
+}
+
+TEST_CASE("ServerThreadSlots: Servers stay within their thread count", "[core]") {
+    Service::ServerThreadSlots<TestServer> slots;
+    TestServer single{1};
+    TestServer sockets{2};
+    slots.Add(&single, 1);
+    slots.Add(&sockets, 3);
+
+    REQUIRE(slots.TryAcquire(&single));
+    REQUIRE(slots.IsBusy(&single));
+    REQUIRE(!slots.TryAcquire(&single));
+
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(!slots.IsBusy(&sockets));
+        REQUIRE(slots.TryAcquire(&sockets));
+    }
+    REQUIRE(slots.IsBusy(&sockets));
+    REQUIRE(!slots.TryAcquire(&sockets));
+
+    // Only releasing a slot of a busy server reports that it can take requests again.
+    REQUIRE(slots.Release(&sockets));
+    REQUIRE(!slots.Release(&sockets));
+    REQUIRE(slots.TryAcquire(&sockets));
+    REQUIRE(slots.Release(&single));
+    REQUIRE(slots.TryAcquire(&single));
+}
+
+TEST_CASE("ServerThreadSlots: Pool outgrows the largest server", "[core]") {
+    Service::ServerThreadSlots<TestServer> slots;
+    TestServer single{1};
+    TestServer other{2};
+    TestServer sockets{3};
+
+    slots.Add(&single, 1);
+    REQUIRE(slots.NumThreads(8) == 1);
+
+    slots.Add(&sockets, 3);
+    REQUIRE(slots.NumThreads(8) == 4);
+    REQUIRE(slots.NumThreads(2) == 4);
+
+    slots.Add(&other, 1);
+    REQUIRE(slots.NumThreads(2) == 4);
+    REQUIRE(slots.NumThreads(4) == 4);
+    REQUIRE(slots.NumThreads(8) == 5);
+}
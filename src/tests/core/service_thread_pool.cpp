@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/hle/kernel/k_client_port.h"
+#include "core/hle/kernel/k_client_session.h"
+#include "core/hle/kernel/k_object_name.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/service/hle_ipc.h"
+#include "core/hle/service/server_manager.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/// What the pool threads did with the sessions of one server
+struct SessionLog {
+    std::mutex mutex;
+    std::condition_variable changed;
+    int created{};
+    int destroyed{};
+    int creating{};
+    int max_creating{};
+    bool blocked{};
+
+    template <typename Pred>
+    bool WaitUntil(Pred&& pred) {
+        std::unique_lock lk{mutex};
+        return changed.wait_for(lk, 5s, [&] { return pred(*this); });
+    }
+
+    void Unblock() {
+        std::scoped_lock lk{mutex};
+        blocked = false;
+        changed.notify_all();
+    }
+};
+
+class TestHandler final : public Service::SessionRequestHandler {
+public:
+    explicit TestHandler(Kernel::KernelCore& kernel_, SessionLog& log_)
+        : SessionRequestHandler{kernel_, "test"}, log{log_} {}
+
+    ~TestHandler() override {
+        std::scoped_lock lk{log.mutex};
+        ++log.destroyed;
+        log.changed.notify_all();
+    }
+
+    Result HandleSyncRequest(Kernel::KServerSession&, Service::HLERequestContext&) override {
+        return ResultSuccess;
+    }
+
+private:
+    SessionLog& log;
+};
+
+/// Called by the server on a pool thread for each session it accepts
+Service::SessionRequestHandlerPtr CreateHandler(Kernel::KernelCore& kernel, SessionLog& log) {
+    std::unique_lock lk{log.mutex};
+    log.max_creating = std::max(log.max_creating, ++log.creating);
+    log.changed.notify_all();
+    log.changed.wait(lk, [&] { return !log.blocked; });
+    --log.creating;
+    ++log.created;
+    log.changed.notify_all();
+    return std::make_shared<TestHandler>(kernel, log);
+}
+
+class PoolSystem {
+public:
+    PoolSystem() {
+        Settings::values.use_shared_service_threads.SetValue(true);
+        system.Initialize();
+        system.Kernel().SetMulticore(true);
+        system.Kernel().Initialize();
+    }
+
+    ~PoolSystem() {
+        system.Kernel().CloseServices();
+        system.Kernel().Shutdown();
+        Settings::values.use_shared_service_threads.SetValue(false);
+    }
+
+    /// Runs a server on a host core process the way services do, returns once its thread exited
+    std::unique_ptr<Service::ServerManager> StartServer(const char* name, SessionLog& log) {
+        std::unique_ptr<Service::ServerManager> server;
+        Result result = ResultUnknown;
+        const auto run_server = [&] {
+            server = std::make_unique<Service::ServerManager>(system);
+            result = server->ManageNamedPort(
+                name, [this, &log] { return CreateHandler(system.Kernel(), log); });
+            if (R_SUCCEEDED(result)) {
+                result = server->LoopProcess();
+            }
+        };
+        system.Kernel().RunOnHostCoreProcess("test", run_server).join();
+        REQUIRE(R_SUCCEEDED(result));
+        return server;
+    }
+
+    /// Opens a session to a named port like a guest connecting to it
+    Kernel::KClientSession* Connect(const char* name) {
+        Kernel::KClientSession* session{};
+        const auto connect = [&] {
+            auto port = Kernel::KObjectName::Find<Kernel::KClientPort>(system.Kernel(), name);
+            if (port.IsNotNull()) {
+                void(port->CreateSession(std::addressof(session)));
+            }
+        };
+        system.Kernel().RunOnHostCoreProcess("client", connect).join();
+        REQUIRE(session != nullptr);
+        return session;
+    }
+
+    Core::System system;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("ServiceThreadPool: Servers are served after their thread exits", "[core]") {
+    PoolSystem pool_system;
+    SessionLog log;
+    auto server = pool_system.StartServer("test:exit", log);
+
+    // Each connection is accepted by a pool thread, which creates the session handler.
+    std::vector<Kernel::KClientSession*> sessions;
+    for (int i = 0; i < 3; ++i) {
+        sessions.push_back(pool_system.Connect("test:exit"));
+    }
+    REQUIRE(log.WaitUntil([](const SessionLog& l) { return l.created == 3; }));
+
+    // Closing the clients signals the server sessions, which the pool destroys.
+    for (auto* session : sessions) {
+        session->Close();
+    }
+    REQUIRE(log.WaitUntil([](const SessionLog& l) { return l.destroyed == 3; }));
+
+    // The server leaves the pool when it is destroyed.
+    server.reset();
+}
+
+TEST_CASE("ServiceThreadPool: Servers stay within their thread count", "[core]") {
+    PoolSystem pool_system;
+    SessionLog single;
+    SessionLog other;
+    single.blocked = true;
+    auto single_server = pool_system.StartServer("test:single", single);
+    auto other_server = pool_system.StartServer("test:other", other);
+
+    std::vector<Kernel::KClientSession*> sessions;
+    sessions.push_back(pool_system.Connect("test:single"));
+    sessions.push_back(pool_system.Connect("test:single"));
+    REQUIRE(single.WaitUntil([](const SessionLog& l) { return l.creating == 1; }));
+
+    // Another server is served while a pool thread is stuck in the first one.
+    sessions.push_back(pool_system.Connect("test:other"));
+    REQUIRE(other.WaitUntil([](const SessionLog& l) { return l.created == 1; }));
+
+    // The second connection of the single threaded server only starts after the first one.
+    single.Unblock();
+    REQUIRE(single.WaitUntil([](const SessionLog& l) { return l.created == 2; }));
+    REQUIRE(single.max_creating == 1);
+
+    for (auto* session : sessions) {
+        session->Close();
+    }
+    REQUIRE(single.WaitUntil([](const SessionLog& l) { return l.destroyed == 2; }));
+    REQUIRE(other.WaitUntil([](const SessionLog& l) { return l.destroyed == 1; }));
+}
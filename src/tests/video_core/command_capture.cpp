@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/command_capture.h"
+
+namespace {
+using namespace Tegra::CommandCapture;
+
+std::filesystem::path CapturePath() {
+    return std::filesystem::temp_directory_path() / "yuzu_command_capture_test.ygcs";
+}
+
+std::vector<u32> LoadCapture(const std::filesystem::path& path) {
+    const Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                                  Common::FS::FileType::BinaryFile};
+    std::vector<u32> words(file.GetSize() / sizeof(u32));
+    REQUIRE(file.ReadSpan(std::span<u32>(words)) == words.size());
+    return words;
+}
+
+/// Writes a capture with the given records and returns its words
+template <typename Func>
+std::vector<u32> WriteCapture(Func&& write) {
+    const auto path = CapturePath();
+    {
+        Writer writer{path};
+        REQUIRE(writer.IsOpen());
+        write(writer);
+    }
+    std::vector<u32> words = LoadCapture(path);
+    std::filesystem::remove(path);
+    return words;
+}
+} // Anonymous namespace
+
+TEST_CASE("CommandCapture: Records round trip", "[video_core]") {
+    static constexpr std::array<u32, 3> arguments{1, 2, 3};
+    static constexpr std::array<u8, 6> memory{1, 2, 3, 4, 5, 6};
+    const std::vector<u32> words = WriteCapture([](Writer& writer) {
+        writer.OnRead(0x12'3456'0000, memory);
+        writer.DmaSegment(0x10'0000'0040);
+        writer.Method(1, 0x45, 7, true);
+        writer.MultiMethod(2, 0x100, arguments, 5);
+        writer.ListEnd();
+    });
+
+    Reader reader{words};
+    REQUIRE(reader.IsValid());
+    Record record;
+
+    REQUIRE(reader.Next(record));
+    REQUIRE(record.type == RecordType::MemoryRead);
+    REQUIRE(record.address == 0x12'3456'0000);
+    REQUIRE(std::ranges::equal(record.data, memory));
+
+    REQUIRE(reader.Next(record));
+    REQUIRE(record.type == RecordType::DmaSegment);
+    REQUIRE(record.segment == 0x10'0000'0040);
+
+    REQUIRE(reader.Next(record));
+    REQUIRE(record.type == RecordType::Method);
+    REQUIRE(record.subchannel == 1);
+    REQUIRE(record.method == 0x45);
+    REQUIRE(record.is_last_call);
+    REQUIRE(record.arguments.size() == 1);
+    REQUIRE(record.arguments[0] == 7);
+
+    REQUIRE(reader.Next(record));
+    REQUIRE(record.type == RecordType::MultiMethod);
+    REQUIRE(record.subchannel == 2);
+    REQUIRE(record.method == 0x100);
+    REQUIRE(record.methods_pending == 5);
+    REQUIRE(std::ranges::equal(record.arguments, arguments));
+
+    REQUIRE(reader.Next(record));
+    REQUIRE(record.type == RecordType::ListEnd);
+    REQUIRE(reader.AtEnd());
+    REQUIRE(!reader.Next(record));
+}
+
+TEST_CASE("CommandCapture: Repeated reads are all recorded", "[video_core]") {
+    std::array<u8, 8> memory{};
+    const std::vector<u32> words = WriteCapture([&memory](Writer& writer) {
+        writer.OnRead(0x1000, memory);
+        memory[0] = 1;
+        writer.OnRead(0x1004, std::span(memory).first(4));
+        memory[0] = 0;
+        writer.OnRead(0x1000, memory);
+    });
+
+    Reader reader{words};
+    Record record;
+    std::vector<std::pair<GPUVAddr, std::vector<u8>>> reads;
+    while (reader.Next(record)) {
+        REQUIRE(record.type == RecordType::MemoryRead);
+        reads.emplace_back(record.address, std::vector<u8>(record.data.begin(), record.data.end()));
+    }
+    REQUIRE(reader.AtEnd());
+    const std::vector<std::pair<GPUVAddr, std::vector<u8>>> expected{
+        {0x1000, {0, 0, 0, 0, 0, 0, 0, 0}},
+        {0x1004, {1, 0, 0, 0}},
+        {0x1000, {0, 0, 0, 0, 0, 0, 0, 0}},
+    };
+    REQUIRE(reads == expected);
+}
+
+TEST_CASE("CommandCapture: Truncated records are rejected", "[video_core]") {
+    static constexpr std::array<u8, 16> memory{};
+    std::vector<u32> words = WriteCapture([](Writer& writer) { writer.OnRead(0x1000, memory); });
+    words.pop_back();
+
+    Reader reader{words};
+    REQUIRE(reader.IsValid());
+    Record record;
+    REQUIRE(!reader.Next(record));
+    REQUIRE(!reader.AtEnd());
+}
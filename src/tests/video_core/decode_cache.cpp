@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "video_core/textures/decode_cache.h"
+
+namespace {
+using Tegra::Texture::DecodeCache;
+using Tegra::Texture::DecodeKey;
+
+constexpr DecodeKey MakeKey(u64 hash) {
+    return DecodeKey{
+        .hash = hash,
+        .size = 16,
+        .width = 4,
+        .height = 4,
+        .depth = 1,
+        .block_width = 4,
+        .block_height = 4,
+    };
+}
+
+/// Encoded blocks of the test decodes, one 4x4 block filled with value
+std::vector<u8> MakeEncoded(u64 value) {
+    return std::vector<u8>(16, static_cast<u8>(value));
+}
+
+/// Inserts a decode after the miss that makes it worth caching
+void InsertAfterMiss(DecodeCache& cache, u64 hash, const std::vector<u8>& decoded) {
+    cache.Insert(MakeKey(hash), MakeEncoded(hash), decoded);
+    cache.Insert(MakeKey(hash), MakeEncoded(hash), decoded);
+}
+} // Anonymous namespace
+
+TEST_CASE("DecodeCache: Hit and miss", "[video_core]") {
+    DecodeCache cache{1024};
+    const std::vector<u8> decoded(64, 0x5a);
+    std::vector<u8> output(64);
+
+    REQUIRE(!cache.Lookup(MakeKey(1), MakeEncoded(1), output));
+    InsertAfterMiss(cache, 1, decoded);
+    REQUIRE(cache.Lookup(MakeKey(1), MakeEncoded(1), output));
+    REQUIRE(output == decoded);
+
+    DecodeKey other_layout{MakeKey(1)};
+    other_layout.width = 8;
+    REQUIRE(!cache.Lookup(other_layout, MakeEncoded(1), output));
+
+    cache.Clear();
+    REQUIRE(!cache.Lookup(MakeKey(1), MakeEncoded(1), output));
+}
+
+TEST_CASE("DecodeCache: Decodes are cached the second time they miss", "[video_core]") {
+    DecodeCache cache{1024};
+    const std::vector<u8> decoded(64, 0x5a);
+    std::vector<u8> output(64);
+
+    cache.Insert(MakeKey(1), MakeEncoded(1), decoded);
+    REQUIRE(!cache.Lookup(MakeKey(1), MakeEncoded(1), output));
+    cache.Insert(MakeKey(1), MakeEncoded(1), decoded);
+    REQUIRE(cache.Lookup(MakeKey(1), MakeEncoded(1), output));
+}
+
+TEST_CASE("DecodeCache: Hash collisions are not returned", "[video_core]") {
+    DecodeCache cache{1024};
+    std::vector<u8> output(64);
+    InsertAfterMiss(cache, 1, std::vector<u8>(64, 1));
+
+    // Same key, different encoded contents
+    REQUIRE(!cache.Lookup(MakeKey(1), MakeEncoded(2), output));
+    REQUIRE(output == std::vector<u8>(64, 0));
+}
+
+TEST_CASE("DecodeCache: Least recently used entries are evicted", "[video_core]") {
+    // Room for four entries of 16 encoded and 64 decoded bytes
+    DecodeCache cache{320};
+    std::vector<u8> output(64);
+    for (u64 hash = 0; hash < 4; ++hash) {
+        InsertAfterMiss(cache, hash, std::vector<u8>(64, static_cast<u8>(hash)));
+    }
+    // Touch the oldest entry so the second oldest one is evicted
+    REQUIRE(cache.Lookup(MakeKey(0), MakeEncoded(0), output));
+    InsertAfterMiss(cache, 4, std::vector<u8>(64, 4));
+
+    REQUIRE(cache.Lookup(MakeKey(0), MakeEncoded(0), output));
+    REQUIRE(!cache.Lookup(MakeKey(1), MakeEncoded(1), output));
+    for (u64 hash = 2; hash < 5; ++hash) {
+        REQUIRE(cache.Lookup(MakeKey(hash), MakeEncoded(hash), output));
+        REQUIRE(output[0] == hash);
+    }
+}
+
+TEST_CASE("DecodeCache: Entries too big for the budget are not cached", "[video_core]") {
+    DecodeCache cache{256};
+    std::vector<u8> output(128);
+    InsertAfterMiss(cache, 1, std::vector<u8>(128, 1));
+    REQUIRE(!cache.Lookup(MakeKey(1), MakeEncoded(1), output));
+}
+
+TEST_CASE("DecodeCache: A zero budget disables the cache", "[video_core]") {
+    DecodeCache cache{0};
+    std::vector<u8> output(64);
+    InsertAfterMiss(cache, 1, std::vector<u8>(64, 1));
+    REQUIRE(!cache.Lookup(MakeKey(1), MakeEncoded(1), output));
+}
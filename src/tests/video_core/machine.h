@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+
+#include "core/core.h"
+#include "core/device_memory.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/memory_manager.h"
+
+namespace VideoCoreTest {
+
+/// Owns the system and the empty GPU address space that engines under test are built on
+class Machine {
+public:
+    Machine() : memory_manager{system, device_memory_manager, 32, 0, 17, 16} {}
+
+    std::unique_ptr<Tegra::Engines::Maxwell3D> MakeMaxwell3D() {
+        return std::make_unique<Tegra::Engines::Maxwell3D>(system, memory_manager);
+    }
+
+    Tegra::MemoryManager& GpuMemory() {
+        return memory_manager;
+    }
+
+private:
+    Core::System system;
+    Core::DeviceMemory device_memory;
+    Tegra::MaxwellDeviceMemoryManager device_memory_manager{device_memory};
+    Tegra::MemoryManager memory_manager;
+};
+
+} // namespace VideoCoreTest
@@ -0,0 +1,436 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "tests/video_core/machine.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro/macro.h"
+#include "video_core/macro/macro_interpreter.h"
+
+#if defined(ARCHITECTURE_x86_64)
+#include "video_core/macro/macro_jit_x64.h"
+#define HAS_MACRO_JIT
+#elif defined(ARCHITECTURE_arm64)
+#include "video_core/macro/macro_jit_a64.h"
+#define HAS_MACRO_JIT
+#endif
+
+namespace {
+
+using namespace Tegra;
+using Maxwell3D = Engines::Maxwell3D;
+using VideoCoreTest::Machine;
+
+#if defined(ARCHITECTURE_x86_64)
+using MacroJIT = MacroJITx64;
+#elif defined(ARCHITECTURE_arm64)
+using MacroJIT = MacroJITA64;
+#endif
+
+// Sends are confined to the viewport transforms, plain registers without side effects. With an
+// increment of one every send lands on the next register, so the region doubles as a tape of the
+// method stream written by the macro.
+constexpr u32 TAPE_BASE = MAXWELL3D_REG_INDEX(viewport_transform);
+constexpr u32 TAPE_SIZE = sizeof(Maxwell3D::Regs::viewport_transform) / sizeof(u32);
+constexpr u32 TAPE_FILL = 0xcdcdcdcd;
+
+constexpr std::array ALU_OPERATIONS{
+    Macro::ALUOperation::Add,
+    Macro::ALUOperation::AddWithCarry,
+    Macro::ALUOperation::Subtract,
+    Macro::ALUOperation::SubtractWithBorrow,
+    Macro::ALUOperation::Xor,
+    Macro::ALUOperation::Or,
+    Macro::ALUOperation::And,
+    Macro::ALUOperation::AndNot,
+    Macro::ALUOperation::Nand,
+};
+
+// Result operations that leave the method address alone
+constexpr std::array RESULT_OPERATIONS{
+    Macro::ResultOperation::IgnoreAndFetch,
+    Macro::ResultOperation::Move,
+    Macro::ResultOperation::FetchAndSend,
+    Macro::ResultOperation::MoveAndSend,
+};
+
+// Result operations that set the method address, only emitted with tape addresses as results
+constexpr std::array METHOD_RESULT_OPERATIONS{
+    Macro::ResultOperation::MoveAndSetMethod,
+    Macro::ResultOperation::FetchAndSetMethod,
+    Macro::ResultOperation::MoveAndSetMethodFetchAndSend,
+    Macro::ResultOperation::MoveAndSetMethodSend,
+};
+
+// Programs send at most once per instruction, method addresses leave room for all of them
+constexpr u32 MAX_PROGRAM_SIZE = 24;
+
+void ResetTape(Maxwell3D& maxwell3d) {
+    std::fill_n(maxwell3d.regs.reg_array.begin() + TAPE_BASE, TAPE_SIZE, TAPE_FILL);
+}
+
+std::vector<u32> Tape(const Maxwell3D& maxwell3d) {
+    const std::span<const u32> tape{maxwell3d.regs.reg_array.data() + TAPE_BASE, TAPE_SIZE};
+    return {tape.begin(), tape.end()};
+}
+
+Macro::Opcode AddImmediate(u32 dst, u32 src, s32 immediate, Macro::ResultOperation operation,
+                           bool is_exit = false) {
+    Macro::Opcode opcode{};
+    opcode.operation.Assign(Macro::Operation::AddImmediate);
+    opcode.result_operation.Assign(operation);
+    opcode.dst.Assign(dst);
+    opcode.src_a.Assign(src);
+    opcode.immediate.Assign(immediate);
+    opcode.is_exit.Assign(is_exit ? 1 : 0);
+    return opcode;
+}
+
+Macro::Opcode Branch(Macro::BranchCondition condition, bool annul, u32 src, s32 offset) {
+    Macro::Opcode opcode{};
+    opcode.operation.Assign(Macro::Operation::Branch);
+    opcode.branch_condition.Assign(condition);
+    opcode.branch_annul.Assign(annul ? 1 : 0);
+    opcode.src_a.Assign(src);
+    opcode.immediate.Assign(offset);
+    return opcode;
+}
+
+/// Method address of the tape register at offset, advancing by increment after every send
+constexpr s32 TapeMethod(u32 offset, u32 increment) {
+    return static_cast<s32>((TAPE_BASE + offset) | increment << 12);
+}
+
+/// Sets the method address through each of the result operations that send or fetch with it
+std::vector<u32> SetMethodProgram() {
+    using Macro::ResultOperation;
+    const std::array program{
+        // tape[0] = 1, the increment field of the result
+        AddImmediate(3, 0, TapeMethod(0, 1), ResultOperation::MoveAndSetMethodSend),
+        // tape[4] = second parameter
+        AddImmediate(0, 0, TapeMethod(4, 1), ResultOperation::MoveAndSetMethodFetchAndSend),
+        // r2 = third parameter, tape[8] = r2
+        AddImmediate(2, 0, TapeMethod(8, 1), ResultOperation::FetchAndSetMethod),
+        AddImmediate(0, 2, 0, ResultOperation::MoveAndSend),
+        // tape[9] = r3, the method address set by the first instruction
+        AddImmediate(0, 3, 0, ResultOperation::MoveAndSend, true),
+        AddImmediate(0, 0, 0, ResultOperation::Move),
+    };
+    std::vector<u32> code;
+    for (const Macro::Opcode& opcode : program) {
+        code.push_back(opcode.raw);
+    }
+    return code;
+}
+
+/// Sends every parameter after the first one to the tape, the first parameter being the count.
+std::vector<u32> LoopProgram() {
+    using Macro::ResultOperation;
+    const std::array program{
+        AddImmediate(0, 0, static_cast<s32>(TAPE_BASE | 1 << 12),
+                     ResultOperation::MoveAndSetMethod),
+        // loop:
+        AddImmediate(2, 0, 0, ResultOperation::IgnoreAndFetch),
+        AddImmediate(0, 2, 0, ResultOperation::MoveAndSend),
+        AddImmediate(1, 1, -1, ResultOperation::Move),
+        Branch(Macro::BranchCondition::NotZero, true, 1, -3),
+        AddImmediate(0, 0, 0, ResultOperation::Move, true),
+        AddImmediate(0, 0, 0, ResultOperation::Move),
+    };
+    std::vector<u32> code;
+    for (const Macro::Opcode& opcode : program) {
+        code.push_back(opcode.raw);
+    }
+    return code;
+}
+
+class ProgramGenerator {
+public:
+    explicit ProgramGenerator(u32 seed) : rng{seed} {}
+
+    /// Builds a random program that every backend must agree on: branches only go forward and
+    /// never sit in a delay slot, and the only exit is the second to last instruction.
+    std::vector<u32> Generate() {
+        const u32 size = Uniform(4, MAX_PROGRAM_SIZE);
+        std::vector<u32> code;
+        code.reserve(size);
+
+        const s32 method = static_cast<s32>(TAPE_BASE | Uniform(0, 1) << 12);
+        const Macro::Opcode set_method =
+            AddImmediate(Uniform(0, 7), 0, method, Macro::ResultOperation::MoveAndSetMethod);
+        code.push_back(set_method.raw);
+
+        bool after_branch = false;
+        for (u32 pc = 1; pc < size; ++pc) {
+            const u32 exit_pc = size - 2;
+            Macro::Opcode opcode{};
+            if (!after_branch && pc + 3 < size && Uniform(0, 5) == 0) {
+                opcode = Branch(static_cast<Macro::BranchCondition>(Uniform(0, 1)),
+                                Uniform(0, 1) != 0, Uniform(0, 7),
+                                static_cast<s32>(Uniform(2, exit_pc - pc)));
+                after_branch = true;
+            } else {
+                opcode = RandomOperation();
+                opcode.is_exit.Assign(pc == exit_pc ? 1 : 0);
+                after_branch = false;
+            }
+            code.push_back(opcode.raw);
+        }
+        return code;
+    }
+
+    /// Every instruction fetches at most once, plus the implicit fetch of the first parameter
+    std::vector<u32> Parameters(const std::vector<u32>& code) {
+        std::vector<u32> parameters(code.size() + 1);
+        for (u32& parameter : parameters) {
+            parameter = static_cast<u32>(rng());
+        }
+        return parameters;
+    }
+
+private:
+    Macro::Opcode RandomOperation() {
+        Macro::Opcode opcode{};
+        opcode.result_operation.Assign(Pick(RESULT_OPERATIONS));
+        opcode.dst.Assign(Uniform(0, 7));
+        opcode.src_a.Assign(Uniform(0, 7));
+        switch (Uniform(0, 6)) {
+        case 0:
+            opcode.operation.Assign(Macro::Operation::ALU);
+            opcode.src_b.Assign(Uniform(0, 7));
+            opcode.alu_operation.Assign(Pick(ALU_OPERATIONS));
+            break;
+        case 1:
+            opcode.operation.Assign(Macro::Operation::AddImmediate);
+            opcode.immediate.Assign(static_cast<s32>(Uniform(0, (1U << 18) - 1)) - (1 << 17));
+            break;
+        case 2:
+            opcode.operation.Assign(Macro::Operation::ExtractInsert);
+            RandomBitfield(opcode);
+            break;
+        case 3:
+            opcode.operation.Assign(Macro::Operation::ExtractShiftLeftImmediate);
+            RandomBitfield(opcode);
+            break;
+        case 4:
+            opcode.operation.Assign(Macro::Operation::ExtractShiftLeftRegister);
+            RandomBitfield(opcode);
+            break;
+        case 5:
+            // The result is the immediate, so the method address stays on the tape
+            opcode.operation.Assign(Macro::Operation::AddImmediate);
+            opcode.result_operation.Assign(Pick(METHOD_RESULT_OPERATIONS));
+            opcode.src_a.Assign(0);
+            opcode.immediate.Assign(
+                TapeMethod(Uniform(0, TAPE_SIZE - MAX_PROGRAM_SIZE), Uniform(0, 1)));
+            break;
+        default:
+            opcode.operation.Assign(Macro::Operation::Read);
+            opcode.src_a.Assign(0);
+            opcode.immediate.Assign(static_cast<s32>(Uniform(0, Maxwell3D::Regs::NUM_REGS - 1)));
+            break;
+        }
+        return opcode;
+    }
+
+    void RandomBitfield(Macro::Opcode& opcode) {
+        opcode.src_b.Assign(Uniform(0, 7));
+        opcode.bf_src_bit.Assign(Uniform(0, 31));
+        opcode.bf_size.Assign(Uniform(0, 31));
+        opcode.bf_dst_bit.Assign(Uniform(0, 31));
+    }
+
+    template <typename T, size_t N>
+    T Pick(const std::array<T, N>& values) {
+        return values[Uniform(0, N - 1)];
+    }
+
+    u32 Uniform(size_t min, size_t max) {
+        return static_cast<u32>(std::uniform_int_distribution<size_t>{min, max}(rng));
+    }
+
+    std::mt19937 rng;
+};
+
+/// Uploads each program to its own macro slot, so the engine compiles them only once
+void Upload(MacroEngine& engine, const std::vector<std::vector<u32>>& programs) {
+    for (u32 method = 0; method < static_cast<u32>(programs.size()); ++method) {
+        for (const u32 word : programs[method]) {
+            engine.AddCode(method, word);
+        }
+    }
+}
+
+void ExecuteAll(MacroEngine& engine, const std::vector<std::vector<u32>>& parameters) {
+    for (u32 method = 0; method < static_cast<u32>(parameters.size()); ++method) {
+        engine.Execute(method, parameters[method]);
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Macro: Interpreter runs a loop", "[video_core]") {
+    Machine machine;
+    const auto maxwell3d = machine.MakeMaxwell3D();
+    ResetTape(*maxwell3d);
+
+    const std::vector<u32> parameters{3, 10, 20, 30};
+    MacroInterpreter interpreter{*maxwell3d};
+    for (const u32 word : LoopProgram()) {
+        interpreter.AddCode(0, word);
+    }
+    interpreter.Execute(0, parameters);
+
+    const std::vector<u32> tape{Tape(*maxwell3d)};
+    REQUIRE(tape[0] == 10);
+    REQUIRE(tape[1] == 20);
+    REQUIRE(tape[2] == 30);
+    REQUIRE(tape[3] == TAPE_FILL);
+}
+
+TEST_CASE("Macro: Interpreter sets methods from results", "[video_core]") {
+    Machine machine;
+    const auto maxwell3d = machine.MakeMaxwell3D();
+    ResetTape(*maxwell3d);
+
+    const std::vector<u32> parameters{0, 20, 30};
+    MacroInterpreter interpreter{*maxwell3d};
+    for (const u32 word : SetMethodProgram()) {
+        interpreter.AddCode(0, word);
+    }
+    interpreter.Execute(0, parameters);
+
+    const std::vector<u32> tape{Tape(*maxwell3d)};
+    REQUIRE(tape[0] == 1);
+    REQUIRE(tape[1] == TAPE_FILL);
+    REQUIRE(tape[4] == 20);
+    REQUIRE(tape[8] == 30);
+    REQUIRE(tape[9] == static_cast<u32>(TapeMethod(0, 1)));
+}
+
+#ifdef HAS_MACRO_JIT
+
+TEST_CASE("Macro: JIT set method program matches the interpreter", "[video_core]") {
+    Machine machine;
+    const auto interpreted = machine.MakeMaxwell3D();
+    const auto compiled = machine.MakeMaxwell3D();
+    ResetTape(*interpreted);
+    ResetTape(*compiled);
+
+    const std::vector<u32> parameters{0, 20, 30};
+    MacroInterpreter interpreter{*interpreted};
+    MacroJIT jit{*compiled};
+    for (const u32 word : SetMethodProgram()) {
+        interpreter.AddCode(0, word);
+        jit.AddCode(0, word);
+    }
+    interpreter.Execute(0, parameters);
+    jit.Execute(0, parameters);
+
+    REQUIRE(Tape(*compiled) == Tape(*interpreted));
+    REQUIRE(compiled->regs.reg_array == interpreted->regs.reg_array);
+}
+
+TEST_CASE("Macro: JIT loop matches the interpreter", "[video_core]") {
+    Machine machine;
+    const auto interpreted = machine.MakeMaxwell3D();
+    const auto compiled = machine.MakeMaxwell3D();
+    ResetTape(*interpreted);
+    ResetTape(*compiled);
+
+    std::vector<u32> parameters{TAPE_SIZE};
+    for (u32 i = 0; i < TAPE_SIZE; ++i) {
+        parameters.push_back(i * 0x01010101U);
+    }
+    MacroInterpreter interpreter{*interpreted};
+    MacroJIT jit{*compiled};
+    for (const u32 word : LoopProgram()) {
+        interpreter.AddCode(0, word);
+        jit.AddCode(0, word);
+    }
+    interpreter.Execute(0, parameters);
+    jit.Execute(0, parameters);
+
+    REQUIRE(Tape(*compiled) == Tape(*interpreted));
+    REQUIRE(Tape(*compiled).back() == parameters.back());
+}
+
+TEST_CASE("Macro: Random programs produce identical method streams", "[video_core]") {
+    Machine machine;
+    const auto interpreted = machine.MakeMaxwell3D();
+    const auto compiled = machine.MakeMaxwell3D();
+    ProgramGenerator generator{0x6d61636f};
+
+    for (u32 iteration = 0; iteration < 2000; ++iteration) {
+        const std::vector<u32> code = generator.Generate();
+        const std::vector<u32> parameters = generator.Parameters(code);
+        ResetTape(*interpreted);
+        ResetTape(*compiled);
+
+        MacroInterpreter interpreter{*interpreted};
+        MacroJIT jit{*compiled};
+        for (const u32 word : code) {
+            interpreter.AddCode(0, word);
+            jit.AddCode(0, word);
+        }
+        interpreter.Execute(0, parameters);
+        jit.Execute(0, parameters);
+
+        INFO("Iteration " << iteration);
+        REQUIRE(Tape(*compiled) == Tape(*interpreted));
+        // Anything written outside of the tape has to match as well
+        REQUIRE(compiled->regs.reg_array == interpreted->regs.reg_array);
+    }
+}
+
+#endif
+
+TEST_CASE("Macro: Benchmark", "[.benchmark]") {
+    static constexpr size_t NUM_PROGRAMS = 256;
+    Machine machine;
+    const auto maxwell3d = machine.MakeMaxwell3D();
+    ProgramGenerator generator{0x62656e63};
+
+    std::vector<std::vector<u32>> programs;
+    std::vector<std::vector<u32>> parameters;
+    for (size_t i = 0; i < NUM_PROGRAMS; ++i) {
+        programs.push_back(generator.Generate());
+        parameters.push_back(generator.Parameters(programs.back()));
+    }
+    std::vector<u32> loop_parameters{TAPE_SIZE};
+    loop_parameters.resize(TAPE_SIZE + 1, 0x3f800000);
+
+    MacroInterpreter interpreter{*maxwell3d};
+    Upload(interpreter, programs);
+    BENCHMARK("Interpreter: 256 random programs") {
+        ExecuteAll(interpreter, parameters);
+    };
+    MacroInterpreter loop_interpreter{*maxwell3d};
+    Upload(loop_interpreter, {LoopProgram()});
+    BENCHMARK("Interpreter: 128 iteration loop") {
+        loop_interpreter.Execute(0, loop_parameters);
+    };
+
+#ifdef HAS_MACRO_JIT
+    MacroJIT jit{*maxwell3d};
+    Upload(jit, programs);
+    BENCHMARK("JIT: 256 random programs") {
+        ExecuteAll(jit, parameters);
+    };
+    MacroJIT loop_jit{*maxwell3d};
+    Upload(loop_jit, {LoopProgram()});
+    BENCHMARK("JIT: 128 iteration loop") {
+        loop_jit.Execute(0, loop_parameters);
+    };
+#endif
+}
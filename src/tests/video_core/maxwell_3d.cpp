@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "tests/video_core/machine.h"
+#include "video_core/engines/maxwell_3d.h"
+
+namespace {
+
+using namespace Tegra;
+using Maxwell3D = Engines::Maxwell3D;
+using VideoCoreTest::Machine;
+
+// The viewport transforms are plain registers, none of them is executable
+constexpr u32 RUN_BASE = MAXWELL3D_REG_INDEX(viewport_transform);
+constexpr u32 RUN_SIZE = sizeof(Maxwell3D::Regs::viewport_transform) / sizeof(u32);
+
+std::unique_ptr<Maxwell3D> MakeTrackedMaxwell3D(Machine& machine) {
+    auto maxwell3d = machine.MakeMaxwell3D();
+    for (u32 i = 0; i < RUN_SIZE; ++i) {
+        maxwell3d->dirty.tables[0][RUN_BASE + i] = static_cast<u8>(1 + i / 4);
+        maxwell3d->dirty.tables[1][RUN_BASE + i] = static_cast<u8>(100 + i % 3);
+    }
+    maxwell3d->dirty.flags.reset();
+    return maxwell3d;
+}
+
+std::vector<u32> MakeValues(u32 seed) {
+    std::vector<u32> values(RUN_SIZE);
+    for (u32 i = 0; i < RUN_SIZE; ++i) {
+        // Leave some registers at their current value so not every flag gets set
+        values[i] = i % 5 == 0 ? 0 : seed * 0x9e3779b9U + i;
+    }
+    return values;
+}
+
+void SetShadowRamControl(Maxwell3D& maxwell3d, Maxwell3D::Regs::ShadowRamControl control) {
+    maxwell3d.CallMethod(MAXWELL3D_REG_INDEX(shadow_ram_control), static_cast<u32>(control),
+                         true);
+}
+
+void RequireSameState(const Maxwell3D& lhs, const Maxwell3D& rhs) {
+    REQUIRE(lhs.regs.reg_array == rhs.regs.reg_array);
+    REQUIRE(lhs.dirty.flags == rhs.dirty.flags);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Maxwell3D: Method runs match single methods", "[video_core]") {
+    Machine machine;
+    const auto single = MakeTrackedMaxwell3D(machine);
+    const auto batched = MakeTrackedMaxwell3D(machine);
+
+    for (const auto control : {Maxwell3D::Regs::ShadowRamControl::Passthrough,
+                               Maxwell3D::Regs::ShadowRamControl::Track,
+                               Maxwell3D::Regs::ShadowRamControl::Replay}) {
+        SetShadowRamControl(*single, control);
+        SetShadowRamControl(*batched, control);
+        for (u32 seed = 1; seed < 4; ++seed) {
+            const std::vector<u32> values{MakeValues(seed)};
+            for (u32 i = 0; i < RUN_SIZE; ++i) {
+                single->CallMethod(RUN_BASE + i, values[i], true);
+            }
+            batched->CallMethodRun(RUN_BASE, values.data(), RUN_SIZE);
+            RequireSameState(*single, *batched);
+        }
+    }
+}
+
+TEST_CASE("Maxwell3D: Repeated writes keep the last value", "[video_core]") {
+    Machine machine;
+    const auto single = MakeTrackedMaxwell3D(machine);
+    const auto batched = MakeTrackedMaxwell3D(machine);
+
+    const std::vector<u32> values{MakeValues(7)};
+    const u32 amount = static_cast<u32>(values.size());
+    for (u32 i = 0; i < amount; ++i) {
+        single->CallMethod(RUN_BASE, values[i], amount - i <= 1);
+    }
+    batched->CallMultiMethod(RUN_BASE, values.data(), amount, amount);
+    REQUIRE(batched->regs.reg_array[RUN_BASE] == values.back());
+    REQUIRE(single->regs.reg_array == batched->regs.reg_array);
+}
@@ -1,15 +1,19 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include <array>
 #include <memory>
 #include <stdexcept>
 #include <unordered_map>
+#include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "video_core/buffer_cache/memory_tracker_base.h"
+#include "video_core/buffer_cache/word_scan.h"
 
 namespace {
 using Range = std::pair<u64, u64>;
@@ -546,3 +550,136 @@ TEST_CASE("MemoryTracker: Cached write downloads") {
     memory_track->MarkRegionAsCpuModified(c, WORD);
     REQUIRE(rasterizer.Count() == 0);
 }
+
+TEST_CASE("MemoryTracker: Word scans", "[video_core]") {
+    using namespace VideoCommon::WordScan;
+    static constexpr size_t NUM_WORDS = 40;
+    std::array<u64, NUM_WORDS> words{};
+    std::array<u64, NUM_WORDS> exclude{};
+    // Move a single bit through every position so each vector lane and the tails are covered
+    for (size_t bit = 0; bit < NUM_WORDS; ++bit) {
+        words.fill(0);
+        exclude.fill(0);
+        words[bit] = 1ULL << (bit % 64);
+        for (size_t begin = 0; begin <= NUM_WORDS; ++begin) {
+            for (size_t end = begin; end <= NUM_WORDS; ++end) {
+                const size_t expected = bit >= begin && bit < end ? bit : end;
+                REQUIRE(FindNonZero(words.data(), begin, end) == expected);
+                REQUIRE(FindNonZeroExcluding(words.data(), exclude.data(), begin, end) ==
+                        expected);
+                REQUIRE(FindNonZeroEither(exclude.data(), words.data(), begin, end) == expected);
+            }
+        }
+        exclude[bit] = words[bit];
+        REQUIRE(FindNonZeroExcluding(words.data(), exclude.data(), 0, NUM_WORDS) == NUM_WORDS);
+    }
+}
+
+TEST_CASE("MemoryTracker: Sparse pages in large region", "[video_core]") {
+    static constexpr u64 SIZE = HIGH_PAGE_SIZE * 4;
+    static constexpr u64 STRIDE = PAGE * 37;
+    RasterizerInterface rasterizer;
+    std::unique_ptr<MemoryTracker> memory_track(std::make_unique<MemoryTracker>(rasterizer));
+    memory_track->UnmarkRegionAsCpuModified(c, SIZE);
+    for (u64 offset = PAGE * 3; offset < SIZE; offset += STRIDE) {
+        memory_track->MarkRegionAsCpuModified(c + offset, PAGE);
+        // Pages also modified by the CPU don't count as GPU modified, keep them apart
+        memory_track->MarkRegionAsGpuModified(c + offset + PAGE, PAGE);
+    }
+    REQUIRE(memory_track->IsRegionGpuModified(c, SIZE));
+    REQUIRE(!memory_track->IsRegionGpuModified(c + PAGE * 5, PAGE * 36));
+
+    std::vector<Range> uploads;
+    memory_track->ForEachUploadRange(
+        c, SIZE, [&](u64 offset, u64 size) { uploads.emplace_back(offset, offset + size); });
+    REQUIRE(uploads.size() == (SIZE - PAGE * 3 + STRIDE - 1) / STRIDE);
+    for (size_t i = 0; i < uploads.size(); ++i) {
+        REQUIRE(uploads[i] == Range{c + PAGE * 3 + STRIDE * i, c + PAGE * 4 + STRIDE * i});
+    }
+    REQUIRE(!memory_track->IsRegionCpuModified(c, SIZE));
+
+    size_t downloads = 0;
+    memory_track->ForEachDownloadRangeAndClear(c, SIZE, [&](u64, u64) { ++downloads; });
+    REQUIRE(downloads == uploads.size());
+    REQUIRE(!memory_track->IsRegionGpuModified(c, SIZE));
+
+    memory_track->MarkRegionAsCpuModified(c, SIZE);
+    REQUIRE(rasterizer.Count() == 0);
+}
+
+TEST_CASE("MemoryTracker: Summary bits", "[video_core]") {
+    RasterizerInterface rasterizer;
+    std::unique_ptr<MemoryTracker> memory_track(std::make_unique<MemoryTracker>(rasterizer));
+    // Regions never seen before are CPU modified
+    REQUIRE(memory_track->IsRegionCpuModified(c + HIGH_PAGE_SIZE * 40, PAGE));
+    REQUIRE(!memory_track->IsRegionGpuModified(c + HIGH_PAGE_SIZE * 40, PAGE));
+
+    memory_track->UnmarkRegionAsCpuModified(c, HIGH_PAGE_SIZE * 8);
+    REQUIRE(!memory_track->IsRegionCpuModified(c, HIGH_PAGE_SIZE * 8));
+    REQUIRE(memory_track->IsRegionCpuModified(c, HIGH_PAGE_SIZE * 9));
+    REQUIRE(memory_track->ModifiedCpuRegion(c, HIGH_PAGE_SIZE * 8) == Range{0, 0});
+
+    memory_track->MarkRegionAsCpuModified(c + HIGH_PAGE_SIZE * 5 + PAGE, PAGE);
+    REQUIRE(memory_track->IsRegionCpuModified(c, HIGH_PAGE_SIZE * 8));
+    REQUIRE(memory_track->ModifiedCpuRegion(c, HIGH_PAGE_SIZE * 8) ==
+            Range{c + HIGH_PAGE_SIZE * 5 + PAGE, c + HIGH_PAGE_SIZE * 5 + PAGE * 2});
+    memory_track->UnmarkRegionAsCpuModified(c + HIGH_PAGE_SIZE * 5 + PAGE, PAGE);
+    REQUIRE(!memory_track->IsRegionCpuModified(c, HIGH_PAGE_SIZE * 8));
+
+    // GPU pages hidden by CPU writes must show up again once the CPU pages are uploaded
+    memory_track->MarkRegionAsGpuModified(c + HIGH_PAGE_SIZE * 3, PAGE);
+    memory_track->MarkRegionAsCpuModified(c + HIGH_PAGE_SIZE * 3, PAGE);
+    REQUIRE(!memory_track->IsRegionGpuModified(c, HIGH_PAGE_SIZE * 8));
+    memory_track->ForEachUploadRange(c, HIGH_PAGE_SIZE * 8, [](u64, u64) {});
+    REQUIRE(memory_track->IsRegionGpuModified(c, HIGH_PAGE_SIZE * 8));
+    REQUIRE(memory_track->ModifiedGpuRegion(c, HIGH_PAGE_SIZE * 8) ==
+            Range{c + HIGH_PAGE_SIZE * 3, c + HIGH_PAGE_SIZE * 3 + PAGE});
+    memory_track->UnmarkRegionAsGpuModified(c + HIGH_PAGE_SIZE * 3, PAGE);
+    REQUIRE(!memory_track->IsRegionGpuModified(c, HIGH_PAGE_SIZE * 8));
+
+    memory_track->MarkRegionAsPreflushable(c + HIGH_PAGE_SIZE * 7, PAGE);
+    REQUIRE(memory_track->IsRegionPreflushable(c, HIGH_PAGE_SIZE * 8));
+    memory_track->UnmarkRegionAsPreflushable(c + HIGH_PAGE_SIZE * 7, PAGE);
+    REQUIRE(!memory_track->IsRegionPreflushable(c, HIGH_PAGE_SIZE * 8));
+
+    // Flushed cached writes make the region CPU modified again
+    memory_track->CachedCpuWrite(c + HIGH_PAGE_SIZE * 6, PAGE);
+    REQUIRE(!memory_track->IsRegionCpuModified(c, HIGH_PAGE_SIZE * 8));
+    memory_track->FlushCachedWrites();
+    REQUIRE(memory_track->IsRegionCpuModified(c, HIGH_PAGE_SIZE * 8));
+}
+
+TEST_CASE("MemoryTracker: Benchmark", "[.benchmark]") {
+    // A 64 MiB buffer where one page every 8 words is touched between invalidations
+    static constexpr u64 SIZE = 64ULL << 20;
+    RasterizerInterface rasterizer;
+    std::unique_ptr<MemoryTracker> memory_track(std::make_unique<MemoryTracker>(rasterizer));
+    memory_track->UnmarkRegionAsCpuModified(c, SIZE);
+    const auto touch = [&] {
+        for (u64 offset = 0; offset < SIZE; offset += WORD * 8) {
+            memory_track->MarkRegionAsCpuModified(c + offset + PAGE * 5, PAGE);
+        }
+    };
+
+    BENCHMARK("Query clean 1 GiB region") {
+        static constexpr u64 LARGE_SIZE = 1ULL << 30;
+        return memory_track->IsRegionGpuModified(c, LARGE_SIZE);
+    };
+    BENCHMARK("Query clean region") {
+        return memory_track->IsRegionCpuModified(c, SIZE);
+    };
+    BENCHMARK("Query clean GPU region") {
+        return memory_track->IsRegionGpuModified(c, SIZE);
+    };
+    BENCHMARK("Upload sparse pages") {
+        touch();
+        u64 uploaded = 0;
+        memory_track->ForEachUploadRange(c, SIZE, [&](u64, u64 size) { uploaded += size; });
+        return uploaded;
+    };
+    BENCHMARK("Mark and clear GPU modified region") {
+        memory_track->MarkRegionAsGpuModified(c, SIZE);
+        memory_track->UnmarkRegionAsGpuModified(c, SIZE);
+        return memory_track->IsRegionGpuModified(c, SIZE);
+    };
+}
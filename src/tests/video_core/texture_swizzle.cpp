@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "tests/video_core/machine.h"
+#include "video_core/surface.h"
+#include "video_core/texture_cache/image_info.h"
+#include "video_core/texture_cache/util.h"
+#include "video_core/textures/decoders.h"
+#include "video_core/textures/workers.h"
+
+namespace {
+
+using namespace Tegra::Texture;
+
+struct Layout {
+    u32 bytes_per_pixel;
+    u32 width;
+    u32 height;
+    u32 depth;
+    u32 block_height;
+    u32 block_depth;
+};
+
+constexpr std::array LAYOUTS{
+    Layout{4, 256, 256, 1, 4, 0}, Layout{16, 64, 64, 1, 3, 0}, Layout{4, 100, 37, 1, 2, 0},
+    Layout{8, 36, 20, 3, 1, 1},   Layout{1, 333, 71, 1, 5, 0}, Layout{2, 24, 9, 2, 0, 0},
+    Layout{12, 16, 16, 1, 1, 0},
+};
+
+/// Straightforward block linear address of a byte, written independently from the decoders
+size_t ReferenceOffset(const Layout& layout, u32 x, u32 y, u32 z) {
+    const u32 stride = Common::AlignUpLog2(layout.width * layout.bytes_per_pixel, 6);
+    const u32 gobs_in_x = stride / GOB_SIZE_X;
+    const u32 gobs_per_block = 1U << (layout.block_height + layout.block_depth);
+    const u32 blocks_in_y = Common::DivCeil(layout.height, GOB_SIZE_Y << layout.block_height);
+    const size_t block_size = size_t{GOB_SIZE} * gobs_per_block;
+
+    const u32 block_x = x / GOB_SIZE_X;
+    const u32 block_y = y / (GOB_SIZE_Y << layout.block_height);
+    const u32 block_z = z >> layout.block_depth;
+    const size_t block_offset =
+        ((size_t{block_z} * blocks_in_y + block_y) * gobs_in_x + block_x) * block_size;
+
+    const u32 gob_y = (y / GOB_SIZE_Y) & ((1U << layout.block_height) - 1);
+    const u32 gob_z = z & ((1U << layout.block_depth) - 1);
+    const size_t gob_offset = (size_t{gob_z} << layout.block_height | gob_y) * GOB_SIZE;
+
+    const u32 gob_x = x % GOB_SIZE_X;
+    const u32 row = y % GOB_SIZE_Y;
+    const u32 in_gob = (gob_x / 32) * 256 + (row / 2) * 64 + ((gob_x % 32) / 16) * 32 +
+                       (row % 2) * 16 + gob_x % 16;
+    return block_offset + gob_offset + in_gob;
+}
+
+size_t SwizzledSize(const Layout& layout) {
+    return CalculateSize(true, layout.bytes_per_pixel, layout.width, layout.height, layout.depth,
+                         layout.block_height, layout.block_depth);
+}
+
+std::vector<u8> MakePattern(size_t size) {
+    std::vector<u8> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<u8>(i * 7 + (i >> 8) * 13 + 1);
+    }
+    return data;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("TextureSwizzle: Unswizzle matches reference", "[video_core]") {
+    for (const Layout& layout : LAYOUTS) {
+        const std::vector<u8> swizzled{MakePattern(SwizzledSize(layout))};
+        const u32 pitch = layout.width * layout.bytes_per_pixel;
+        std::vector<u8> linear(size_t{pitch} * layout.height * layout.depth);
+        UnswizzleTexture(linear, swizzled, layout.bytes_per_pixel, layout.width, layout.height,
+                         layout.depth, layout.block_height, layout.block_depth);
+
+        for (u32 z = 0; z < layout.depth; ++z) {
+            for (u32 y = 0; y < layout.height; ++y) {
+                for (u32 x = 0; x < pitch; ++x) {
+                    const size_t linear_offset = (size_t{z} * layout.height + y) * pitch + x;
+                    REQUIRE(linear[linear_offset] == swizzled[ReferenceOffset(layout, x, y, z)]);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("TextureSwizzle: Swizzle matches reference", "[video_core]") {
+    for (const Layout& layout : LAYOUTS) {
+        const u32 pitch = layout.width * layout.bytes_per_pixel;
+        const std::vector<u8> linear{MakePattern(size_t{pitch} * layout.height * layout.depth)};
+        std::vector<u8> swizzled(SwizzledSize(layout));
+        SwizzleTexture(swizzled, linear, layout.bytes_per_pixel, layout.width, layout.height,
+                       layout.depth, layout.block_height, layout.block_depth);
+
+        for (u32 z = 0; z < layout.depth; ++z) {
+            for (u32 y = 0; y < layout.height; ++y) {
+                for (u32 x = 0; x < pitch; ++x) {
+                    const size_t linear_offset = (size_t{z} * layout.height + y) * pitch + x;
+                    REQUIRE(swizzled[ReferenceOffset(layout, x, y, z)] == linear[linear_offset]);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("TextureSwizzle: Subrect matches reference", "[video_core]") {
+    static constexpr Layout layout{4, 200, 120, 1, 4, 0};
+    struct Rect {
+        u32 origin_x;
+        u32 origin_y;
+        u32 extent_x;
+        u32 extent_y;
+    };
+    // Sector aligned rects take the GOB path, the others the per pixel path
+    static constexpr std::array rects{
+        Rect{0, 0, 200, 120}, Rect{16, 8, 64, 64}, Rect{4, 3, 40, 21},
+        Rect{1, 5, 33, 50},   Rect{12, 117, 8, 3},
+    };
+    const std::vector<u8> swizzled{MakePattern(SwizzledSize(layout))};
+    for (const Rect& rect : rects) {
+        const u32 pitch = rect.extent_x * layout.bytes_per_pixel;
+        std::vector<u8> linear(size_t{pitch} * rect.extent_y);
+        UnswizzleSubrect(linear, swizzled, layout.bytes_per_pixel, layout.width, layout.height,
+                         layout.depth, rect.origin_x, rect.origin_y, rect.extent_x, rect.extent_y,
+                         layout.block_height, layout.block_depth, pitch);
+
+        std::vector<u8> reswizzled(swizzled.size());
+        SwizzleSubrect(reswizzled, linear, layout.bytes_per_pixel, layout.width, layout.height,
+                       layout.depth, rect.origin_x, rect.origin_y, rect.extent_x, rect.extent_y,
+                       layout.block_height, layout.block_depth, pitch);
+
+        for (u32 y = 0; y < rect.extent_y; ++y) {
+            for (u32 x = 0; x < pitch; ++x) {
+                const size_t swizzled_offset = ReferenceOffset(
+                    layout, rect.origin_x * layout.bytes_per_pixel + x, rect.origin_y + y, 0);
+                REQUIRE(linear[size_t{y} * pitch + x] == swizzled[swizzled_offset]);
+                REQUIRE(reswizzled[swizzled_offset] == swizzled[swizzled_offset]);
+            }
+        }
+    }
+}
+
+TEST_CASE("TextureSwizzle: Banded image unswizzle matches the serial path", "[video_core]") {
+    using VideoCommon::ImageInfo;
+    using VideoCommon::ImageType;
+    using VideoCore::Surface::PixelFormat;
+
+    const auto make_info = [](PixelFormat format, ImageType type, VideoCommon::Extent3D size,
+                              VideoCommon::Extent3D block, s32 levels, s32 layers) {
+        ImageInfo info;
+        info.format = format;
+        info.type = type;
+        info.size = size;
+        info.block = block;
+        info.resources = {.levels = levels, .layers = layers};
+        info.layer_stride = VideoCommon::CalculateLayerStride(info);
+        return info;
+    };
+    // Every image is large enough to be split in bands, as long as the texture worker pool has
+    // more than one thread
+    const std::array infos{
+        make_info(PixelFormat::A8B8G8R8_UNORM, ImageType::e2D, {512, 512, 1}, {0, 4, 0}, 10, 2),
+        make_info(PixelFormat::R16G16B16A16_FLOAT, ImageType::e2D, {300, 200, 1}, {0, 3, 0}, 1,
+                  3),
+        make_info(PixelFormat::R8_UNORM, ImageType::e3D, {128, 128, 96}, {0, 2, 2}, 3, 1),
+    };
+    if (GetNumThreadWorkers() < 2) {
+        WARN("The texture worker pool has a single thread, only the serial path is covered");
+    }
+    VideoCoreTest::Machine machine;
+    for (const ImageInfo& info : infos) {
+        const std::vector<u8> input{MakePattern(VideoCommon::CalculateGuestSizeInBytes(info))};
+        std::vector<u8> output(VideoCommon::CalculateUnswizzledSizeBytes(info));
+        const auto copies =
+            VideoCommon::UnswizzleImage(machine.GpuMemory(), 0, info, input, output);
+
+        // Unswizzle every level and layer on its own, as the serial path does
+        const u32 bytes_per_block = VideoCore::Surface::BytesPerBlock(info.format);
+        const u32 stride_alignment = GOB_SIZE_X_SHIFT - std::countr_zero(bytes_per_block);
+        const auto level_offsets = VideoCommon::CalculateMipLevelOffsets(info);
+        std::vector<u8> expected(output.size());
+        for (s32 level = 0; level < info.resources.levels; ++level) {
+            const VideoCommon::Extent3D size = VideoCommon::MipSize(info.size, level);
+            const VideoCommon::Extent3D block = VideoCommon::MipBlockSize(info, level);
+            const size_t host_layer_size = copies[level].buffer_size / info.resources.layers;
+            for (s32 layer = 0; layer < info.resources.layers; ++layer) {
+                UnswizzleTexture(std::span(expected).subspan(copies[level].buffer_offset +
+                                                             layer * host_layer_size),
+                                 std::span(input).subspan(layer * info.layer_stride +
+                                                          level_offsets[level]),
+                                 bytes_per_block, size.width, size.height, size.depth,
+                                 block.height, block.depth, stride_alignment);
+            }
+        }
+        REQUIRE(output == expected);
+    }
+}
+
+TEST_CASE("TextureSwizzle: Benchmark", "[.benchmark]") {
+    static constexpr Layout layout{4, 2048, 2048, 1, 4, 0};
+    const std::vector<u8> swizzled{MakePattern(SwizzledSize(layout))};
+    std::vector<u8> linear(size_t{layout.width} * layout.height * layout.bytes_per_pixel);
+
+    BENCHMARK("Unswizzle 2048x2048 RGBA8") {
+        UnswizzleTexture(linear, swizzled, layout.bytes_per_pixel, layout.width, layout.height,
+                         layout.depth, layout.block_height, layout.block_depth);
+        return linear[0];
+    };
+    std::vector<u8> output(swizzled.size());
+    BENCHMARK("Swizzle 2048x2048 RGBA8") {
+        SwizzleTexture(output, linear, layout.bytes_per_pixel, layout.width, layout.height,
+                       layout.depth, layout.block_height, layout.block_depth);
+        return output[0];
+    };
+    BENCHMARK("Unswizzle subrect 1000x1000 RGBA8") {
+        UnswizzleSubrect(linear, swizzled, layout.bytes_per_pixel, layout.width, layout.height,
+                         layout.depth, 4, 4, 1000, 1000, layout.block_height, layout.block_depth,
+                         1000 * layout.bytes_per_pixel);
+        return linear[0];
+    };
+    BENCHMARK("Unswizzle subrect 999x1000 RGBA8 (per pixel)") {
+        UnswizzleSubrect(linear, swizzled, layout.bytes_per_pixel, layout.width, layout.height,
+                         layout.depth, 1, 4, 999, 1000, layout.block_height, layout.block_depth,
+                         999 * layout.bytes_per_pixel);
+        return linear[0];
+    };
+}
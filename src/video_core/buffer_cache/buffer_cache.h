@@ -100,10 +100,20 @@ void BufferCache<P>::TickFrame() {
     ++frame_tick;
     delayed_destruction_ring.Tick();
 
+    std::scoped_lock lock{readback_mutex};
     for (auto& buffer : async_buffers_death_ring) {
         runtime.FreeDeferredStagingBuffer(buffer);
     }
     async_buffers_death_ring.clear();
+
+    if (frame_download_stats.batches != 0) {
+        frame_download_stats.average_latency_us =
+            static_cast<double>(frame_download_latency_us) /
+            static_cast<double>(frame_download_stats.batches);
+    }
+    last_frame_download_stats = frame_download_stats;
+    frame_download_stats = {};
+    frame_download_latency_us = 0;
 }
 
 template <class P>
@@ -169,6 +179,7 @@ std::optional<VideoCore::RasterizerDownloadArea> BufferCache<P>::GetFlushArea(DA
 
 template <class P>
 void BufferCache<P>::DownloadMemory(DAddr device_addr, u64 size) {
+    WriteReadbacks();
     ForEachBufferInRange(device_addr, size, [&](BufferId, Buffer& buffer) {
         DownloadBufferMemory(buffer, device_addr, size);
     });
@@ -176,6 +187,7 @@ void BufferCache<P>::DownloadMemory(DAddr device_addr, u64 size) {
 
 template <class P>
 void BufferCache<P>::ClearDownload(DAddr device_addr, u64 size) {
+    DiscardReadbacks(device_addr, size);
     async_downloads.DeleteAll(device_addr, size);
     uncommitted_gpu_modified_ranges.Subtract(device_addr, size);
     for (auto& interval_set : committed_gpu_modified_ranges) {
@@ -587,22 +599,35 @@ void BufferCache<P>::CommitAsyncFlushesHigh() {
         return;
     }
     auto download_staging = runtime.DownloadStagingBuffer(total_size_bytes, true);
-    boost::container::small_vector<BufferCopy, 4> normalized_copies;
+    PendingDownload pending_download{
+        .copies{},
+        .commit_time = std::chrono::steady_clock::now(),
+    };
+    // Record a single copy with every region of each buffer
+    std::ranges::stable_sort(downloads, {}, [](const auto& download) {
+        return download.second.index;
+    });
+    boost::container::small_vector<BufferCopy, 16> buffer_copies;
     runtime.PreCopyBarrier();
-    for (auto& [copy, buffer_id] : downloads) {
-        copy.dst_offset += download_staging.offset;
-        const std::array copies{copy};
-        BufferCopy second_copy{copy};
+    for (auto it = downloads.begin(); it != downloads.end();) {
+        const BufferId buffer_id = it->second;
         Buffer& buffer = slot_buffers[buffer_id];
-        second_copy.src_offset = static_cast<size_t>(buffer.CpuAddr()) + copy.src_offset;
-        const DAddr orig_device_addr = static_cast<DAddr>(second_copy.src_offset);
-        async_downloads.Add(orig_device_addr, copy.size);
-        buffer.MarkUsage(copy.src_offset, copy.size);
-        runtime.CopyBuffer(download_staging.buffer, buffer, copies, false);
-        normalized_copies.push_back(second_copy);
+        buffer_copies.clear();
+        for (; it != downloads.end() && it->second == buffer_id; ++it) {
+            BufferCopy& copy = it->first;
+            copy.dst_offset += download_staging.offset;
+            BufferCopy second_copy{copy};
+            second_copy.src_offset = static_cast<size_t>(buffer.CpuAddr()) + copy.src_offset;
+            const DAddr orig_device_addr = static_cast<DAddr>(second_copy.src_offset);
+            async_downloads.Add(orig_device_addr, copy.size);
+            buffer.MarkUsage(copy.src_offset, copy.size);
+            buffer_copies.push_back(copy);
+            pending_download.copies.push_back(second_copy);
+        }
+        runtime.CopyBuffer(download_staging.buffer, buffer, buffer_copies, false);
     }
     runtime.PostCopyBarrier();
-    pending_downloads.emplace_back(std::move(normalized_copies));
+    pending_downloads.emplace_back(std::move(pending_download));
     async_buffers.emplace_back(download_staging);
 }
 
@@ -630,25 +655,110 @@ void BufferCache<P>::PopAsyncBuffers() {
     auto& async_buffer = async_buffers.front();
     u8* base = async_buffer->mapped_span.data();
     const size_t base_offset = async_buffer->offset;
-    for (const auto& copy : downloads) {
+    ReadbackBatch batch{
+        .buffer = *async_buffer,
+        .writes{},
+        .commit_time = downloads.commit_time,
+    };
+    for (const auto& copy : downloads.copies) {
         const DAddr device_addr = static_cast<DAddr>(copy.src_offset);
         const u64 dst_offset = copy.dst_offset - base_offset;
         const u8* read_mapped_memory = base + dst_offset;
         async_downloads.ForEachInRange(device_addr, copy.size, [&](DAddr start, DAddr end, s32) {
-            device_memory.WriteBlockUnsafe(start, &read_mapped_memory[start - device_addr],
-                                           end - start);
+            batch.writes.push_back(ReadbackWrite{
+                .device_addr = start,
+                .data = &read_mapped_memory[start - device_addr],
+                .size = end - start,
+            });
         });
         async_downloads.Subtract(device_addr, copy.size, [&](DAddr start, DAddr end) {
             gpu_modified_ranges.Subtract(start, end - start);
         });
     }
-    async_buffers_death_ring.emplace_back(*async_buffer);
+    // The memory copies are left to CompleteAsyncFlushes, so they don't block the cache
+    {
+        std::scoped_lock lock{readback_mutex};
+        readback_batches.push_back(std::move(batch));
+        has_readbacks.store(true, std::memory_order_release);
+    }
     async_buffers.pop_front();
     pending_downloads.pop_front();
 }
 
+template <class P>
+void BufferCache<P>::CompleteAsyncFlushes() {
+    MICROPROFILE_SCOPE(GPU_DownloadMemory);
+    WriteReadbacks();
+}
+
+template <class P>
+VideoCore::RasterizerDownloadStats BufferCache<P>::GetDownloadStats() {
+    std::scoped_lock lock{readback_mutex};
+    return last_frame_download_stats;
+}
+
+template <class P>
+void BufferCache<P>::WriteReadbacks() {
+    if (!has_readbacks.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::scoped_lock lock{readback_mutex};
+    const auto now = std::chrono::steady_clock::now();
+    for (ReadbackBatch& batch : readback_batches) {
+        for (const ReadbackWrite& write : batch.writes) {
+            device_memory.WriteBlockUnsafe(write.device_addr, write.data, write.size);
+            frame_download_stats.bytes += write.size;
+        }
+        ++frame_download_stats.batches;
+        frame_download_latency_us += static_cast<u64>(
+            std::chrono::duration_cast<std::chrono::microseconds>(now - batch.commit_time)
+                .count());
+        async_buffers_death_ring.push_back(std::move(batch.buffer));
+    }
+    readback_batches.clear();
+    has_readbacks.store(false, std::memory_order_release);
+}
+
+template <class P>
+void BufferCache<P>::DiscardReadbacks(DAddr device_addr, u64 size) {
+    if (!has_readbacks.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::scoped_lock lock{readback_mutex};
+    const DAddr end_addr = device_addr + size;
+    for (ReadbackBatch& batch : readback_batches) {
+        std::vector<ReadbackWrite> kept_writes;
+        kept_writes.reserve(batch.writes.size());
+        for (const ReadbackWrite& write : batch.writes) {
+            const DAddr write_end = write.device_addr + write.size;
+            if (write_end <= device_addr || write.device_addr >= end_addr) {
+                kept_writes.push_back(write);
+                continue;
+            }
+            // Keep the parts of the write on either side of the discarded range
+            if (write.device_addr < device_addr) {
+                kept_writes.push_back(ReadbackWrite{
+                    .device_addr = write.device_addr,
+                    .data = write.data,
+                    .size = device_addr - write.device_addr,
+                });
+            }
+            if (write_end > end_addr) {
+                kept_writes.push_back(ReadbackWrite{
+                    .device_addr = end_addr,
+                    .data = write.data + (end_addr - write.device_addr),
+                    .size = write_end - end_addr,
+                });
+            }
+        }
+        batch.writes = std::move(kept_writes);
+    }
+}
+
 template <class P>
 bool BufferCache<P>::IsRegionGpuModified(DAddr addr, size_t size) {
+    // Popped downloads are no longer tracked as GPU modified, make sure they reached guest memory
+    WriteReadbacks();
     bool is_dirty = false;
     gpu_modified_ranges.ForEachInRange(addr, size, [&](DAddr, DAddr) { is_dirty = true; });
     return is_dirty;
@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -275,6 +277,12 @@ public:
     void PopAsyncFlushes();
     void PopAsyncBuffers();
 
+    /// Write popped asynchronous downloads to guest memory, the cache mutex doesn't have to be held
+    void CompleteAsyncFlushes();
+
+    /// Return the download statistics of the last frame
+    [[nodiscard]] VideoCore::RasterizerDownloadStats GetDownloadStats();
+
     bool DMACopy(GPUVAddr src_address, GPUVAddr dest_address, u64 amount);
 
     bool DMAClear(GPUVAddr src_address, u64 amount, u32 value);
@@ -442,6 +450,12 @@ private:
 
     void ClearDownload(DAddr base_addr, u64 size);
 
+    /// Write every popped download to guest memory
+    void WriteReadbacks();
+
+    /// Drop the popped downloads of a range that has been overwritten
+    void DiscardReadbacks(DAddr device_addr, u64 size);
+
     void InlineMemoryImplementation(DAddr dest_address, size_t copy_size,
                                     std::span<const u8> inlined_buffer);
 
@@ -462,10 +476,34 @@ private:
     // Async Buffers
     Common::OverlapRangeSet<DAddr> async_downloads;
     std::deque<std::optional<Async_Buffer>> async_buffers;
-    std::deque<boost::container::small_vector<BufferCopy, 4>> pending_downloads;
+    struct PendingDownload {
+        boost::container::small_vector<BufferCopy, 4> copies;
+        std::chrono::steady_clock::time_point commit_time;
+    };
+    std::deque<PendingDownload> pending_downloads;
     std::optional<Async_Buffer> current_buffer;
 
+    /// Guest memory write of a download whose GPU copy has finished
+    struct ReadbackWrite {
+        DAddr device_addr;
+        const u8* data;
+        u64 size;
+    };
+    /// Downloads popped from the GPU, waiting to be written to guest memory
+    struct ReadbackBatch {
+        Async_Buffer buffer;
+        std::vector<ReadbackWrite> writes;
+        std::chrono::steady_clock::time_point commit_time;
+    };
+
+    // Readbacks are written without the cache mutex, they are guarded by readback_mutex instead
+    std::mutex readback_mutex;
+    std::atomic_bool has_readbacks{};
+    std::vector<ReadbackBatch> readback_batches;
     std::deque<Async_Buffer> async_buffers_death_ring;
+    VideoCore::RasterizerDownloadStats frame_download_stats{};
+    VideoCore::RasterizerDownloadStats last_frame_download_stats{};
+    u64 frame_download_latency_us = 0;
 
     size_t immediate_buffer_capacity = 0;
     Common::ScratchBuffer<u8> immediate_buffer_alloc;
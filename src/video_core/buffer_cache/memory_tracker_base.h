@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <deque>
 #include <limits>
@@ -28,14 +29,20 @@ class MemoryTrackerBase {
     static constexpr size_t WORDS_STACK_NEEDED = HIGHER_PAGE_SIZE / BYTES_PER_WORD;
     using Manager = WordManager<DeviceTracker, WORDS_STACK_NEEDED>;
 
+    /// One bit per high page, set when its manager may have pages in a given state
+    using SummaryBits = std::array<u64, NUM_HIGH_PAGES / 64>;
+
 public:
-    MemoryTrackerBase(DeviceTracker& device_tracker_) : device_tracker{&device_tracker_} {}
+    MemoryTrackerBase(DeviceTracker& device_tracker_) : device_tracker{&device_tracker_} {
+        // Regions without a manager are considered modified by the CPU
+        Summary<Type::CPU>().fill(~u64{0});
+    }
     ~MemoryTrackerBase() = default;
 
     /// Returns the inclusive CPU modified range in a begin end pair
     [[nodiscard]] std::pair<u64, u64> ModifiedCpuRegion(VAddr query_cpu_addr,
                                                         u64 query_size) noexcept {
-        return IteratePairs<true>(
+        return IteratePairs<Type::CPU, true>(
             query_cpu_addr, query_size, [](Manager* manager, u64 offset, size_t size) {
                 return manager->template ModifiedRegion<Type::CPU>(offset, size);
             });
@@ -44,7 +51,7 @@ public:
     /// Returns the inclusive GPU modified range in a begin end pair
     [[nodiscard]] std::pair<u64, u64> ModifiedGpuRegion(VAddr query_cpu_addr,
                                                         u64 query_size) noexcept {
-        return IteratePairs<false>(
+        return IteratePairs<Type::GPU, false>(
             query_cpu_addr, query_size, [](Manager* manager, u64 offset, size_t size) {
                 return manager->template ModifiedRegion<Type::GPU>(offset, size);
             });
@@ -52,7 +59,7 @@ public:
 
     /// Returns true if a region has been modified from the CPU
     [[nodiscard]] bool IsRegionCpuModified(VAddr query_cpu_addr, u64 query_size) noexcept {
-        return IteratePages<true>(
+        return IterateSummaryPages<Type::CPU, true>(
             query_cpu_addr, query_size, [](Manager* manager, u64 offset, size_t size) {
                 return manager->template IsRegionModified<Type::CPU>(offset, size);
             });
@@ -60,7 +67,7 @@ public:
 
     /// Returns true if a region has been modified from the GPU
     [[nodiscard]] bool IsRegionGpuModified(VAddr query_cpu_addr, u64 query_size) noexcept {
-        return IteratePages<false>(
+        return IterateSummaryPages<Type::GPU, false>(
             query_cpu_addr, query_size, [](Manager* manager, u64 offset, size_t size) {
                 return manager->template IsRegionModified<Type::GPU>(offset, size);
             });
@@ -68,7 +75,7 @@ public:
 
     /// Returns true if a region has been marked as Preflushable
     [[nodiscard]] bool IsRegionPreflushable(VAddr query_cpu_addr, u64 query_size) noexcept {
-        return IteratePages<false>(
+        return IterateSummaryPages<Type::Preflushable, false>(
             query_cpu_addr, query_size, [](Manager* manager, u64 offset, size_t size) {
                 return manager->template IsRegionModified<Type::Preflushable>(offset, size);
             });
@@ -77,55 +84,62 @@ public:
     /// Mark region as CPU modified, notifying the device_tracker about this change
     void MarkRegionAsCpuModified(VAddr dirty_cpu_addr, u64 query_size) {
         IteratePages<true>(dirty_cpu_addr, query_size,
-                           [](Manager* manager, u64 offset, size_t size) {
+                           [this](Manager* manager, u64 offset, size_t size) {
                                manager->template ChangeRegionState<Type::CPU, true>(
                                    manager->GetCpuAddr() + offset, size);
+                               SetSummary<Type::CPU>(manager);
                            });
     }
 
     /// Unmark region as CPU modified, notifying the device_tracker about this change
     void UnmarkRegionAsCpuModified(VAddr dirty_cpu_addr, u64 query_size) {
+        // Tracked pages have to be updated even when no page is modified, don't skip managers
         IteratePages<true>(dirty_cpu_addr, query_size,
-                           [](Manager* manager, u64 offset, size_t size) {
+                           [this](Manager* manager, u64 offset, size_t size) {
                                manager->template ChangeRegionState<Type::CPU, false>(
                                    manager->GetCpuAddr() + offset, size);
+                               UpdateSummary<Type::CPU>(manager);
                            });
     }
 
     /// Mark region as modified from the host GPU
     void MarkRegionAsGpuModified(VAddr dirty_cpu_addr, u64 query_size) noexcept {
         IteratePages<true>(dirty_cpu_addr, query_size,
-                           [](Manager* manager, u64 offset, size_t size) {
+                           [this](Manager* manager, u64 offset, size_t size) {
                                manager->template ChangeRegionState<Type::GPU, true>(
                                    manager->GetCpuAddr() + offset, size);
+                               SetSummary<Type::GPU>(manager);
                            });
     }
 
     /// Mark region as modified from the host GPU
     void MarkRegionAsPreflushable(VAddr dirty_cpu_addr, u64 query_size) noexcept {
         IteratePages<true>(dirty_cpu_addr, query_size,
-                           [](Manager* manager, u64 offset, size_t size) {
+                           [this](Manager* manager, u64 offset, size_t size) {
                                manager->template ChangeRegionState<Type::Preflushable, true>(
                                    manager->GetCpuAddr() + offset, size);
+                               SetSummary<Type::Preflushable>(manager);
                            });
     }
 
     /// Unmark region as modified from the host GPU
     void UnmarkRegionAsGpuModified(VAddr dirty_cpu_addr, u64 query_size) noexcept {
-        IteratePages<true>(dirty_cpu_addr, query_size,
-                           [](Manager* manager, u64 offset, size_t size) {
-                               manager->template ChangeRegionState<Type::GPU, false>(
-                                   manager->GetCpuAddr() + offset, size);
-                           });
+        IterateSummaryPages<Type::GPU, false>(
+            dirty_cpu_addr, query_size, [this](Manager* manager, u64 offset, size_t size) {
+                manager->template ChangeRegionState<Type::GPU, false>(
+                    manager->GetCpuAddr() + offset, size);
+                UpdateSummary<Type::GPU>(manager);
+            });
     }
 
     /// Unmark region as modified from the host GPU
     void UnmarkRegionAsPreflushable(VAddr dirty_cpu_addr, u64 query_size) noexcept {
-        IteratePages<true>(dirty_cpu_addr, query_size,
-                           [](Manager* manager, u64 offset, size_t size) {
-                               manager->template ChangeRegionState<Type::Preflushable, false>(
-                                   manager->GetCpuAddr() + offset, size);
-                           });
+        IterateSummaryPages<Type::Preflushable, false>(
+            dirty_cpu_addr, query_size, [this](Manager* manager, u64 offset, size_t size) {
+                manager->template ChangeRegionState<Type::Preflushable, false>(
+                    manager->GetCpuAddr() + offset, size);
+                UpdateSummary<Type::Preflushable>(manager);
+            });
     }
 
     /// Mark region as modified from the CPU
@@ -142,13 +156,17 @@ public:
     /// Flushes cached CPU writes, and notify the device_tracker about the deltas
     void FlushCachedWrites(VAddr query_cpu_addr, u64 query_size) noexcept {
         IteratePages<false>(query_cpu_addr, query_size,
-                            [](Manager* manager, [[maybe_unused]] u64 offset,
-                               [[maybe_unused]] size_t size) { manager->FlushCachedWrites(); });
+                            [this](Manager* manager, [[maybe_unused]] u64 offset,
+                                   [[maybe_unused]] size_t size) {
+                                manager->FlushCachedWrites();
+                                UpdateSummary<Type::CPU>(manager);
+                            });
     }
 
     void FlushCachedWrites() noexcept {
         for (auto id : cached_pages) {
             top_tier[id]->FlushCachedWrites();
+            UpdateSummary<Type::CPU>(top_tier[id]);
         }
         cached_pages.clear();
     }
@@ -156,35 +174,40 @@ public:
     /// Call 'func' for each CPU modified range and unmark those pages as CPU modified
     template <typename Func>
     void ForEachUploadRange(VAddr query_cpu_range, u64 query_size, Func&& func) {
+        // Clearing also starts tracking pages with cached writes, don't skip managers
         IteratePages<true>(query_cpu_range, query_size,
-                           [&func](Manager* manager, u64 offset, size_t size) {
+                           [this, &func](Manager* manager, u64 offset, size_t size) {
                                manager->template ForEachModifiedRange<Type::CPU, true>(
                                    manager->GetCpuAddr() + offset, size, func);
+                               UpdateSummary<Type::CPU>(manager);
                            });
     }
 
     /// Call 'func' for each GPU modified range and unmark those pages as GPU modified
     template <typename Func>
     void ForEachDownloadRange(VAddr query_cpu_range, u64 query_size, bool clear, Func&& func) {
-        IteratePages<false>(query_cpu_range, query_size,
-                            [&func, clear](Manager* manager, u64 offset, size_t size) {
-                                if (clear) {
-                                    manager->template ForEachModifiedRange<Type::GPU, true>(
-                                        manager->GetCpuAddr() + offset, size, func);
-                                } else {
-                                    manager->template ForEachModifiedRange<Type::GPU, false>(
-                                        manager->GetCpuAddr() + offset, size, func);
-                                }
-                            });
+        IterateSummaryPages<Type::GPU, false>(
+            query_cpu_range, query_size,
+            [this, &func, clear](Manager* manager, u64 offset, size_t size) {
+                if (clear) {
+                    manager->template ForEachModifiedRange<Type::GPU, true>(
+                        manager->GetCpuAddr() + offset, size, func);
+                    UpdateSummary<Type::GPU>(manager);
+                } else {
+                    manager->template ForEachModifiedRange<Type::GPU, false>(
+                        manager->GetCpuAddr() + offset, size, func);
+                }
+            });
     }
 
     template <typename Func>
     void ForEachDownloadRangeAndClear(VAddr query_cpu_range, u64 query_size, Func&& func) {
-        IteratePages<false>(query_cpu_range, query_size,
-                            [&func](Manager* manager, u64 offset, size_t size) {
-                                manager->template ForEachModifiedRange<Type::GPU, true>(
-                                    manager->GetCpuAddr() + offset, size, func);
-                            });
+        IterateSummaryPages<Type::GPU, false>(
+            query_cpu_range, query_size, [this, &func](Manager* manager, u64 offset, size_t size) {
+                manager->template ForEachModifiedRange<Type::GPU, true>(
+                    manager->GetCpuAddr() + offset, size, func);
+                UpdateSummary<Type::GPU>(manager);
+            });
     }
 
 private:
@@ -225,36 +248,59 @@ private:
         return false;
     }
 
-    template <bool create_region_on_fail, typename Func>
+    /**
+     * Iterates the managers of a region like IteratePages, but skips whole runs of high pages
+     * whose summary bit for type is clear without looking at their managers
+     */
+    template <Type type, bool create_region_on_fail, typename Func>
+    bool IterateSummaryPages(VAddr cpu_address, size_t size, Func&& func) {
+        using FuncReturn = typename std::invoke_result<Func, Manager*, u64, size_t>::type;
+        static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
+        if (size == 0) {
+            return false;
+        }
+        const SummaryBits& summary_bits = Summary<type>();
+        const VAddr end_address = cpu_address + size;
+        const size_t end_page = ((end_address - 1) >> HIGHER_PAGE_BITS) + 1;
+        for (size_t page_index = FindSummaryBit(summary_bits, cpu_address >> HIGHER_PAGE_BITS,
+                                                end_page);
+             page_index != end_page;
+             page_index = FindSummaryBit(summary_bits, page_index + 1, end_page)) {
+            auto* manager{top_tier[page_index]};
+            if (!manager) {
+                if constexpr (!create_region_on_fail) {
+                    continue;
+                }
+                CreateRegion(page_index);
+                manager = top_tier[page_index];
+            }
+            const VAddr page_address = static_cast<VAddr>(page_index) << HIGHER_PAGE_BITS;
+            const VAddr begin = std::max<VAddr>(cpu_address, page_address);
+            const VAddr end = std::min<VAddr>(end_address, page_address + HIGHER_PAGE_SIZE);
+            if constexpr (BOOL_BREAK) {
+                if (func(manager, begin - page_address, end - begin)) {
+                    return true;
+                }
+            } else {
+                func(manager, begin - page_address, end - begin);
+            }
+        }
+        return false;
+    }
+
+    template <Type type, bool create_region_on_fail, typename Func>
     std::pair<u64, u64> IteratePairs(VAddr cpu_address, size_t size, Func&& func) {
-        std::size_t remaining_size{size};
-        std::size_t page_index{cpu_address >> HIGHER_PAGE_BITS};
-        u64 page_offset{cpu_address & HIGHER_PAGE_MASK};
         u64 begin = std::numeric_limits<u64>::max();
         u64 end = 0;
-        while (remaining_size > 0) {
-            const std::size_t copy_amount{
-                std::min<std::size_t>(HIGHER_PAGE_SIZE - page_offset, remaining_size)};
-            auto* manager{top_tier[page_index]};
-            const auto execute = [&] {
-                auto [new_begin, new_end] = func(manager, page_offset, copy_amount);
+        IterateSummaryPages<type, create_region_on_fail>(
+            cpu_address, size, [&](Manager* manager, u64 offset, size_t copy_amount) {
+                auto [new_begin, new_end] = func(manager, offset, copy_amount);
                 if (new_begin != 0 || new_end != 0) {
-                    const u64 base_address = page_index << HIGHER_PAGE_BITS;
+                    const u64 base_address = manager->GetCpuAddr();
                     begin = std::min(new_begin + base_address, begin);
                     end = std::max(new_end + base_address, end);
                 }
-            };
-            if (manager) {
-                execute();
-            } else if constexpr (create_region_on_fail) {
-                CreateRegion(page_index);
-                manager = top_tier[page_index];
-                execute();
-            }
-            page_index++;
-            page_offset = 0;
-            remaining_size -= copy_amount;
-        }
+            });
         if (begin < end) {
             return std::make_pair(begin, end);
         } else {
@@ -262,6 +308,48 @@ private:
         }
     }
 
+    /// Returns the first high page in [begin, end) with its summary bit set, or end
+    static size_t FindSummaryBit(const SummaryBits& summary_bits, size_t begin, size_t end) {
+        if (begin >= end) {
+            return end;
+        }
+        size_t word_index = begin / 64;
+        u64 word = summary_bits[word_index] & (~u64{0} << (begin % 64));
+        while (word == 0) {
+            if (++word_index * 64 >= end) {
+                return end;
+            }
+            word = summary_bits[word_index];
+        }
+        return std::min<size_t>(word_index * 64 + std::countr_zero(word), end);
+    }
+
+    template <Type type>
+    SummaryBits& Summary() noexcept {
+        if constexpr (type == Type::CPU) {
+            return summary[0];
+        } else if constexpr (type == Type::GPU) {
+            return summary[1];
+        } else if constexpr (type == Type::Preflushable) {
+            return summary[2];
+        }
+    }
+
+    template <Type type>
+    void SetSummary(const Manager* manager) noexcept {
+        const size_t page_index = manager->GetCpuAddr() >> HIGHER_PAGE_BITS;
+        Summary<type>()[page_index / 64] |= u64{1} << (page_index % 64);
+    }
+
+    /// Recomputes the summary bit of a manager from its pages
+    template <Type type>
+    void UpdateSummary(const Manager* manager) noexcept {
+        const size_t page_index = manager->GetCpuAddr() >> HIGHER_PAGE_BITS;
+        u64& word = Summary<type>()[page_index / 64];
+        const u64 bit = u64{1} << (page_index % 64);
+        word = manager->template IsAnyBitSet<type>() ? (word | bit) : (word & ~bit);
+    }
+
     void CreateRegion(std::size_t page_index) {
         const VAddr base_cpu_addr = page_index << HIGHER_PAGE_BITS;
         top_tier[page_index] = GetNewManager(base_cpu_addr);
@@ -293,6 +381,9 @@ private:
 
     std::unordered_set<u32> cached_pages;
 
+    /// Summary bits of the CPU, GPU and preflushable states
+    std::array<SummaryBits, 3> summary{};
+
     DeviceTracker* device_tracker = nullptr;
 };
 
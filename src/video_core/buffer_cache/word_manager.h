@@ -13,6 +13,7 @@
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/div_ceil.h"
+#include "video_core/buffer_cache/word_scan.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
 
 namespace VideoCommon {
@@ -227,6 +228,40 @@ public:
         }
     }
 
+    /**
+     * Iterates the words of a range like IterateWords, but hands the words fully covered by the
+     * range to full_func as a single [begin, end) interval of word indices, so they can be
+     * scanned or filled in bulk. Partially covered words are still given to func with their mask.
+     */
+    template <typename Func, typename FullFunc>
+    void IterateWordSpans(size_t offset, size_t size, Func&& func, FullFunc&& full_func) const {
+        const size_t start = static_cast<size_t>(std::max<s64>(static_cast<s64>(offset), 0LL));
+        const size_t end = static_cast<size_t>(std::max<s64>(static_cast<s64>(offset + size), 0LL));
+        if (start >= SizeBytes() || end <= start) {
+            return;
+        }
+        const size_t num_words = NumWords();
+        const size_t start_word = std::min(start / BYTES_PER_WORD, num_words);
+        const size_t start_page = (start % BYTES_PER_WORD) / BYTES_PER_PAGE;
+        // Pages are counted from the first page of start_word
+        const size_t end_page = Common::DivCeil(end, BYTES_PER_PAGE) - start_word * PAGES_PER_WORD;
+        const size_t end_word = std::min(start_word + Common::DivCeil(end_page, PAGES_PER_WORD),
+                                         num_words);
+        const size_t full_begin = std::min(start_word + (start_page != 0 ? 1 : 0), end_word);
+        const size_t full_end =
+            std::max(full_begin, std::min(start_word + end_page / PAGES_PER_WORD, end_word));
+        if (full_begin != start_word) {
+            func(start_word, ExtractBits(~u64{0}, start_page, end_page));
+        }
+        if (full_begin != full_end) {
+            full_func(full_begin, full_end);
+        }
+        for (size_t word_index = full_end; word_index < end_word; ++word_index) {
+            const size_t page_offset = (word_index - start_word) * PAGES_PER_WORD;
+            func(word_index, ExtractBits(~u64{0}, 0, end_page - page_offset));
+        }
+    }
+
     template <typename Func>
     void IteratePages(u64 mask, Func&& func) const {
         size_t offset = 0;
@@ -253,7 +288,7 @@ public:
         std::span<u64> state_words = words.template Span<type>();
         [[maybe_unused]] std::span<u64> untracked_words = words.template Span<Type::Untracked>();
         [[maybe_unused]] std::span<u64> cached_words = words.template Span<Type::CachedCPU>();
-        IterateWords(dirty_addr - cpu_addr, size, [&](size_t index, u64 mask) {
+        const auto change = [&](size_t index, u64 mask) {
             if constexpr (type == Type::CPU || type == Type::CachedCPU) {
                 NotifyRasterizer<!enable>(index, untracked_words[index], mask);
             }
@@ -275,6 +310,23 @@ public:
                     untracked_words[index] &= ~mask;
                 }
             }
+        };
+        IterateWordSpans(dirty_addr - cpu_addr, size, change, [&](size_t begin, size_t end) {
+            if constexpr (type != Type::CPU && type != Type::CachedCPU) {
+                // Nothing else has to be updated, fill the whole words at once
+                std::fill(state_words.begin() + begin, state_words.begin() + end,
+                          enable ? ~u64{0} : u64{0});
+            } else if constexpr (enable) {
+                for (size_t index = begin; index < end; ++index) {
+                    change(index, ~u64{0});
+                }
+            } else {
+                // Words without modified or tracked pages are left as they are
+                for (size_t index = FindDirtyWord<type, true>(begin, end); index != end;
+                     index = FindDirtyWord<type, true>(index + 1, end)) {
+                    change(index, ~u64{0});
+                }
+            }
         });
     }
 
@@ -301,7 +353,7 @@ public:
             func(cpu_addr + pending_offset * BYTES_PER_PAGE,
                  (pending_pointer - pending_offset) * BYTES_PER_PAGE);
         };
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        const auto process = [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
@@ -336,6 +388,15 @@ public:
                 release();
                 reset();
             });
+        };
+        // Clearing CPU pages also stops tracking them, so tracked words can't be skipped either
+        static constexpr bool include_untracked =
+            clear && (type == Type::CPU || type == Type::CachedCPU);
+        IterateWordSpans(offset, size, process, [&](size_t begin, size_t end) {
+            for (size_t index = FindDirtyWord<type, include_untracked>(begin, end); index != end;
+                 index = FindDirtyWord<type, include_untracked>(index + 1, end)) {
+                process(index, ~u64{0});
+            }
         });
         if (pending) {
             release();
@@ -356,16 +417,14 @@ public:
         [[maybe_unused]] const std::span<const u64> untracked_words =
             words.template Span<Type::Untracked>();
         bool result = false;
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        const auto test = [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
-            const u64 word = state_words[index] & mask;
-            if (word != 0) {
-                result = true;
-                return true;
-            }
-            return false;
+            result = result || (state_words[index] & mask) != 0;
+        };
+        IterateWordSpans(offset, size, test, [&](size_t begin, size_t end) {
+            result = result || FindDirtyWord<type>(begin, end) != end;
         });
         return result;
     }
@@ -384,7 +443,7 @@ public:
             words.template Span<Type::Untracked>();
         u64 begin = std::numeric_limits<u64>::max();
         u64 end = 0;
-        IterateWords(offset, size, [&](size_t index, u64 mask) {
+        const auto process = [&](size_t index, u64 mask) {
             if constexpr (type == Type::GPU) {
                 mask &= ~untracked_words[index];
             }
@@ -397,11 +456,32 @@ public:
             const u64 page_index = index * PAGES_PER_WORD;
             begin = std::min(begin, page_index + local_page_begin);
             end = page_index + local_page_end;
+        };
+        IterateWordSpans(offset, size, process, [&](size_t begin_word, size_t end_word) {
+            for (size_t index = FindDirtyWord<type>(begin_word, end_word); index != end_word;
+                 index = FindDirtyWord<type>(index + 1, end_word)) {
+                process(index, ~u64{0});
+            }
         });
         static constexpr std::pair<u64, u64> EMPTY{0, 0};
         return begin < end ? std::make_pair(begin * BYTES_PER_PAGE, end * BYTES_PER_PAGE) : EMPTY;
     }
 
+    /**
+     * Returns true when any page of the manager is in the given state, unlike IsRegionModified
+     * GPU modified pages that are untracked are considered too
+     */
+    template <Type type>
+    [[nodiscard]] bool IsAnyBitSet() const noexcept {
+        // Managers are a few words long, a branchless reduction beats an early exit here
+        const u64* const state_words = Array<type>();
+        u64 bits = 0;
+        for (size_t index = 0; index < NumWords(); ++index) {
+            bits |= state_words[index];
+        }
+        return bits != 0;
+    }
+
     /// Returns the number of words of the manager
     [[nodiscard]] size_t NumWords() const noexcept {
         return words.NumWords();
@@ -418,11 +498,13 @@ public:
     }
 
     void FlushCachedWrites() noexcept {
-        const u64 num_words = NumWords();
+        const size_t num_words = NumWords();
         u64* const cached_words = Array<Type::CachedCPU>();
         u64* const untracked_words = Array<Type::Untracked>();
         u64* const cpu_words = Array<Type::CPU>();
-        for (u64 word_index = 0; word_index < num_words; ++word_index) {
+        for (size_t word_index = FindDirtyWord<Type::CachedCPU>(0, num_words);
+             word_index != num_words;
+             word_index = FindDirtyWord<Type::CachedCPU>(word_index + 1, num_words)) {
             const u64 cached_bits = cached_words[word_index];
             NotifyRasterizer<false>(word_index, untracked_words[word_index], cached_bits);
             untracked_words[word_index] |= cached_bits;
@@ -442,6 +524,8 @@ private:
             return words.cached_cpu.Pointer(IsShort());
         } else if constexpr (type == Type::Untracked) {
             return words.untracked.Pointer(IsShort());
+        } else if constexpr (type == Type::Preflushable) {
+            return words.preflushable.Pointer(IsShort());
         }
     }
 
@@ -455,6 +539,27 @@ private:
             return words.cached_cpu.Pointer(IsShort());
         } else if constexpr (type == Type::Untracked) {
             return words.untracked.Pointer(IsShort());
+        } else if constexpr (type == Type::Preflushable) {
+            return words.preflushable.Pointer(IsShort());
+        }
+    }
+
+    /**
+     * Returns the index of the first word in [begin, end) with pages in the given state, or end
+     * when there is none. GPU modified pages that are untracked are not considered modified.
+     *
+     * @tparam include_untracked True when words with tracked pages also have to be returned
+     */
+    template <Type type, bool include_untracked = false>
+    [[nodiscard]] size_t FindDirtyWord(size_t begin, size_t end) const noexcept {
+        const u64* const state_words = Array<type>();
+        if constexpr (include_untracked) {
+            return WordScan::FindNonZeroEither(state_words, Array<Type::Untracked>(), begin, end);
+        } else if constexpr (type == Type::GPU) {
+            return WordScan::FindNonZeroExcluding(state_words, Array<Type::Untracked>(), begin,
+                                                  end);
+        } else {
+            return WordScan::FindNonZero(state_words, begin, end);
         }
     }
 
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "video_core/buffer_cache/word_scan.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+namespace VideoCommon::WordScan {
+
+namespace {
+
+enum class Op {
+    Plain,     ///< words
+    Excluding, ///< words & ~exclude
+    Either,    ///< lhs | rhs
+};
+
+using ScanFunction = size_t (*)(const u64* lhs, const u64* rhs, size_t begin, size_t end);
+
+template <Op op>
+u64 Combine(const u64* lhs, const u64* rhs, size_t index) {
+    if constexpr (op == Op::Plain) {
+        return lhs[index];
+    } else if constexpr (op == Op::Excluding) {
+        return lhs[index] & ~rhs[index];
+    } else {
+        return lhs[index] | rhs[index];
+    }
+}
+
+template <Op op>
+size_t FindScalar(const u64* lhs, const u64* rhs, size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+        if (Combine<op>(lhs, rhs, index) != 0) {
+            return index;
+        }
+    }
+    return end;
+}
+
+#ifdef ARCHITECTURE_x86_64
+/// Tests eight words per iteration with two 256-bit vectors
+template <Op op>
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+size_t FindAVX2(const u64* lhs, const u64* rhs, size_t begin, size_t end) {
+    static constexpr size_t WORDS_PER_STEP = 8;
+    size_t index = begin;
+    for (; index + WORDS_PER_STEP <= end; index += WORDS_PER_STEP) {
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + index));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + index + 4));
+        if constexpr (op != Op::Plain) {
+            const __m256i rhs_low =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + index));
+            const __m256i rhs_high =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + index + 4));
+            if constexpr (op == Op::Excluding) {
+                low = _mm256_andnot_si256(rhs_low, low);
+                high = _mm256_andnot_si256(rhs_high, high);
+            } else {
+                low = _mm256_or_si256(low, rhs_low);
+                high = _mm256_or_si256(high, rhs_high);
+            }
+        }
+        const __m256i any = _mm256_or_si256(low, high);
+        if (!_mm256_testz_si256(any, any)) {
+            return FindScalar<op>(lhs, rhs, index, index + WORDS_PER_STEP);
+        }
+    }
+    return FindScalar<op>(lhs, rhs, index, end);
+}
+#endif
+
+#ifdef ARCHITECTURE_arm64
+/// Tests four words per iteration with two 128-bit vectors
+template <Op op>
+size_t FindNEON(const u64* lhs, const u64* rhs, size_t begin, size_t end) {
+    static constexpr size_t WORDS_PER_STEP = 4;
+    size_t index = begin;
+    for (; index + WORDS_PER_STEP <= end; index += WORDS_PER_STEP) {
+        uint64x2_t low = vld1q_u64(lhs + index);
+        uint64x2_t high = vld1q_u64(lhs + index + 2);
+        if constexpr (op == Op::Excluding) {
+            low = vbicq_u64(low, vld1q_u64(rhs + index));
+            high = vbicq_u64(high, vld1q_u64(rhs + index + 2));
+        } else if constexpr (op == Op::Either) {
+            low = vorrq_u64(low, vld1q_u64(rhs + index));
+            high = vorrq_u64(high, vld1q_u64(rhs + index + 2));
+        }
+        const uint32x4_t any = vreinterpretq_u32_u64(vorrq_u64(low, high));
+        if (vmaxvq_u32(any) != 0) {
+            return FindScalar<op>(lhs, rhs, index, index + WORDS_PER_STEP);
+        }
+    }
+    return FindScalar<op>(lhs, rhs, index, end);
+}
+#endif
+
+template <Op op>
+ScanFunction SelectFind() {
+#ifdef ARCHITECTURE_x86_64
+    if (Common::GetCPUCaps().avx2) {
+        return &FindAVX2<op>;
+    }
+#elif defined(ARCHITECTURE_arm64)
+    return &FindNEON<op>;
+#endif
+    return &FindScalar<op>;
+}
+
+} // Anonymous namespace
+
+size_t FindNonZero(const u64* words, size_t begin, size_t end) {
+    static const ScanFunction find = SelectFind<Op::Plain>();
+    return find(words, nullptr, begin, end);
+}
+
+size_t FindNonZeroExcluding(const u64* words, const u64* exclude, size_t begin, size_t end) {
+    static const ScanFunction find = SelectFind<Op::Excluding>();
+    return find(words, exclude, begin, end);
+}
+
+size_t FindNonZeroEither(const u64* lhs, const u64* rhs, size_t begin, size_t end) {
+    static const ScanFunction find = SelectFind<Op::Either>();
+    return find(lhs, rhs, begin, end);
+}
+
+} // namespace VideoCommon::WordScan
@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+
+#include "common/common_types.h"
+
+/**
+ * Vectorized scans over the page bitmaps of the buffer cache. They let large runs of clean words
+ * be skipped without visiting them one at a time. Every function returns the index of the first
+ * matching word in [begin, end), or end when there is none.
+ */
+namespace VideoCommon::WordScan {
+
+/// Finds the first word with any bit set
+[[nodiscard]] size_t FindNonZero(const u64* words, size_t begin, size_t end);
+
+/// Finds the first word with a bit set in words that is not set in exclude
+[[nodiscard]] size_t FindNonZeroExcluding(const u64* words, const u64* exclude, size_t begin,
+                                          size_t end);
+
+/// Finds the first word with a bit set in either lhs or rhs
+[[nodiscard]] size_t FindNonZeroEither(const u64* lhs, const u64* rhs, size_t begin, size_t end);
+
+} // namespace VideoCommon::WordScan
@@ -0,0 +1,179 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#include "common/div_ceil.h"
+#include "common/fs/fs.h"
+#include "common/logging/log.h"
+#include "video_core/command_capture.h"
+
+namespace Tegra::CommandCapture {
+
+namespace {
+/// Number of words buffered before they are written out
+constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+} // Anonymous namespace
+
+Writer::Writer(const std::filesystem::path& path) {
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(HW_GPU, "Failed to create the directory of {}", path.string());
+        return;
+    }
+    file.Open(path, Common::FS::FileAccessMode::Write, Common::FS::FileType::BinaryFile);
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to open GPU command capture {}", path.string());
+        return;
+    }
+    buffer.reserve(FLUSH_THRESHOLD);
+    buffer.push_back(MAGIC);
+    buffer.push_back(VERSION);
+}
+
+Writer::~Writer() {
+    Flush();
+}
+
+void Writer::Method(u32 subchannel, u32 method, u32 argument, bool is_last_call) {
+    PushHeader(RecordType::Method, subchannel, method, is_last_call);
+    buffer.push_back(argument);
+}
+
+void Writer::MultiMethod(u32 subchannel, u32 method, std::span<const u32> arguments,
+                         u32 methods_pending) {
+    PushHeader(RecordType::MultiMethod, subchannel, method);
+    buffer.push_back(static_cast<u32>(arguments.size()));
+    buffer.push_back(methods_pending);
+    buffer.insert(buffer.end(), arguments.begin(), arguments.end());
+}
+
+void Writer::DmaSegment(GPUVAddr segment) {
+    if (segment == last_segment) {
+        return;
+    }
+    last_segment = segment;
+    PushHeader(RecordType::DmaSegment);
+    buffer.push_back(static_cast<u32>(segment));
+    buffer.push_back(static_cast<u32>(segment >> 32));
+}
+
+void Writer::ListEnd() {
+    PushHeader(RecordType::ListEnd);
+    if (buffer.size() >= FLUSH_THRESHOLD) {
+        Flush();
+    }
+}
+
+void Writer::OnRead(GPUVAddr gpu_addr, std::span<const u8> data) {
+    PushHeader(RecordType::MemoryRead);
+    buffer.push_back(static_cast<u32>(gpu_addr));
+    buffer.push_back(static_cast<u32>(gpu_addr >> 32));
+    buffer.push_back(static_cast<u32>(data.size()));
+    const size_t offset = buffer.size();
+    buffer.resize(offset + Common::DivCeil(data.size(), sizeof(u32)));
+    std::memcpy(buffer.data() + offset, data.data(), data.size());
+    if (buffer.size() >= FLUSH_THRESHOLD) {
+        Flush();
+    }
+}
+
+void Writer::PushHeader(RecordType type, u32 subchannel, u32 method, bool is_last_call) {
+    RecordHeader header{};
+    header.type.Assign(type);
+    header.subchannel.Assign(subchannel);
+    header.is_last_call.Assign(is_last_call ? 1 : 0);
+    header.method.Assign(method);
+    buffer.push_back(header.raw);
+}
+
+void Writer::Flush() {
+    if (!file.IsOpen() || buffer.empty()) {
+        buffer.clear();
+        return;
+    }
+    if (file.WriteSpan(std::span<const u32>(buffer)) != buffer.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write GPU command capture, closing it");
+        file.Close();
+    }
+    buffer.clear();
+}
+
+Reader::Reader(std::span<const u32> words_) : words{words_}, position{2} {}
+
+bool Reader::IsValid() const {
+    return words.size() >= 2 && words[0] == MAGIC && words[1] == VERSION;
+}
+
+bool Reader::Next(Record& record) {
+    if (AtEnd()) {
+        return false;
+    }
+    const size_t start = position;
+    if (!Decode(record)) {
+        // Leave the reader on the malformed record so it is not mistaken for the end
+        position = start;
+        return false;
+    }
+    return true;
+}
+
+bool Reader::Decode(Record& record) {
+    const auto remaining = [this] { return words.size() - position; };
+    const RecordHeader header{words[position++]};
+    record.type = header.type;
+    record.subchannel = header.subchannel;
+    record.method = header.method;
+    record.is_last_call = header.is_last_call != 0;
+    record.arguments = {};
+    record.data = {};
+    switch (record.type) {
+    case RecordType::Method:
+        if (remaining() < 1) {
+            return false;
+        }
+        record.arguments = words.subspan(position++, 1);
+        return true;
+    case RecordType::MultiMethod: {
+        if (remaining() < 2) {
+            return false;
+        }
+        const u32 count = words[position++];
+        record.methods_pending = words[position++];
+        if (remaining() < count) {
+            return false;
+        }
+        record.arguments = words.subspan(position, count);
+        position += count;
+        return true;
+    }
+    case RecordType::DmaSegment:
+        if (remaining() < 2) {
+            return false;
+        }
+        record.segment = words[position] | (static_cast<GPUVAddr>(words[position + 1]) << 32);
+        position += 2;
+        return true;
+    case RecordType::ListEnd:
+        return true;
+    case RecordType::MemoryRead: {
+        if (remaining() < 3) {
+            return false;
+        }
+        record.address = words[position] | (static_cast<GPUVAddr>(words[position + 1]) << 32);
+        const u32 size = words[position + 2];
+        position += 3;
+        const size_t num_words = Common::DivCeil(size_t{size}, sizeof(u32));
+        if (remaining() < num_words) {
+            return false;
+        }
+        record.data = std::span(reinterpret_cast<const u8*>(words.data() + position), size);
+        position += num_words;
+        return true;
+    }
+    }
+    LOG_ERROR(HW_GPU, "Unknown GPU command capture record type {}",
+              static_cast<u32>(record.type));
+    return false;
+}
+
+} // namespace Tegra::CommandCapture
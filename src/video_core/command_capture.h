@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "common/bit_field.h"
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/memory_manager.h"
+
+namespace Tegra {
+
+/**
+ * Command captures hold the method stream of a GPU channel as the DmaPusher hands it to the
+ * puller and the engines, after the pushbuffers have been decoded, together with the guest memory
+ * the methods read through the channel's MemoryManager. Every method is recorded after it runs,
+ * so the memory it read comes first and a replay can restore it before calling the method.
+ *
+ * Only block and span reads of the MemoryManager are captured. Reads the renderer makes on its
+ * own, through device memory (vertex, index and uniform data in the buffer cache) or Read<T>
+ * (texture handles), are not, so captures replay faithfully on renderer_null only.
+ *
+ * The file is a sequence of little endian words: MAGIC and VERSION, then records made of a
+ * RecordHeader word and a payload that depends on the record type.
+ */
+namespace CommandCapture {
+
+constexpr u32 MAGIC = 0x53434759; // "YGCS"
+constexpr u32 VERSION = 2;
+
+enum class RecordType : u32 {
+    Method,      ///< Payload: argument
+    MultiMethod, ///< Payload: argument count, methods pending, arguments
+    DmaSegment,  ///< Payload: low and high words of the segment address
+    ListEnd,     ///< No payload, marks the end of a DispatchCalls
+    MemoryRead,  ///< Payload: low and high words of the address, size, data padded to a word
+};
+
+union RecordHeader {
+    u32 raw;
+    BitField<0, 4, RecordType> type;
+    BitField<4, 3, u32> subchannel;
+    BitField<7, 1, u32> is_last_call;
+    BitField<8, 16, u32> method;
+};
+static_assert(sizeof(RecordHeader) == sizeof(u32), "RecordHeader has incorrect size!");
+
+struct Record {
+    RecordType type{};
+    u32 subchannel{};
+    u32 method{};
+    bool is_last_call{};
+    u32 methods_pending{};
+    std::span<const u32> arguments;
+    GPUVAddr segment{};
+    GPUVAddr address{};
+    std::span<const u8> data;
+};
+
+/// Appends the method stream of a channel and the memory it reads to a capture file
+class Writer final : public MemoryReadObserver {
+public:
+    explicit Writer(const std::filesystem::path& path);
+    ~Writer() override;
+
+    [[nodiscard]] bool IsOpen() const {
+        return file.IsOpen();
+    }
+
+    void Method(u32 subchannel, u32 method, u32 argument, bool is_last_call);
+    void MultiMethod(u32 subchannel, u32 method, std::span<const u32> arguments,
+                     u32 methods_pending);
+    void DmaSegment(GPUVAddr segment);
+    void ListEnd();
+
+    /// Records a memory read. Every read is kept, the GPU may have written the range since it
+    /// was last recorded and a replay has to undo that.
+    void OnRead(GPUVAddr gpu_addr, std::span<const u8> data) override;
+
+private:
+    void PushHeader(RecordType type, u32 subchannel = 0, u32 method = 0,
+                    bool is_last_call = false);
+    void Flush();
+
+    Common::FS::IOFile file;
+    std::vector<u32> buffer;
+    GPUVAddr last_segment{};
+};
+
+/// Walks the records of a capture loaded in memory, the words must outlive the reader
+class Reader {
+public:
+    explicit Reader(std::span<const u32> words_);
+
+    /// Returns true when the capture has a known magic and version
+    [[nodiscard]] bool IsValid() const;
+
+    /// Decodes the next record, returns false at the end of the capture or on a malformed record
+    bool Next(Record& record);
+
+    /// Returns true when every record has been decoded
+    [[nodiscard]] bool AtEnd() const {
+        return position >= words.size();
+    }
+
+private:
+    bool Decode(Record& record);
+
+    std::span<const u32> words;
+    size_t position{};
+};
+
+} // namespace CommandCapture
+
+} // namespace Tegra
@@ -1,10 +1,15 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <fmt/format.h>
+
 #include "common/cityhash.h"
+#include "common/fs/path_util.h"
 #include "common/microprofile.h"
 #include "common/settings.h"
 #include "core/core.h"
+#include "video_core/command_capture.h"
+#include "video_core/control/channel_state.h"
 #include "video_core/dma_pusher.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/gpu.h"
@@ -19,7 +24,18 @@ constexpr u32 ComputeInline = 0x6D;
 DmaPusher::DmaPusher(Core::System& system_, GPU& gpu_, MemoryManager& memory_manager_,
                      Control::ChannelState& channel_state_)
     : gpu{gpu_}, system{system_}, memory_manager{memory_manager_}, puller{gpu_, memory_manager_,
-                                                                          *this, channel_state_} {}
+                                                                          *this, channel_state_} {
+    if (Settings::values.dump_gpu_commands) {
+        const auto path = Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir) / "gpu_commands" /
+                          fmt::format("{:016x}_channel{}.ygcs",
+                                      system.GetApplicationProcessProgramID(),
+                                      channel_state_.bind_id);
+        capture = std::make_unique<CommandCapture::Writer>(path);
+        if (!capture->IsOpen()) {
+            capture.reset();
+        }
+    }
+}
 
 DmaPusher::~DmaPusher() = default;
 
@@ -37,6 +53,9 @@ void DmaPusher::DispatchCalls() {
             break;
         }
     }
+    if (capture) {
+        capture->ListEnd();
+    }
     gpu.FlushCommands();
     gpu.OnCommandListEnd();
 }
@@ -131,10 +150,20 @@ void DmaPusher::ProcessCommands(std::span<const CommandHeader> commands) {
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
-            } else {
-                dma_state.is_last_call = dma_state.method_count <= 1;
-                CallMethod(command_header.argument);
             }
+            if (!dma_increment_once && dma_state.method >= non_puller_methods) {
+                const u32 max_run = static_cast<u32>(
+                    std::min<std::size_t>(dma_state.method_count, commands.size() - index));
+                const u32 run = CallMethodRun(&command_header.argument, max_run);
+                if (run != 0) {
+                    dma_state.method += run;
+                    dma_state.method_count -= run;
+                    index += run;
+                    continue;
+                }
+            }
+            dma_state.is_last_call = dma_state.method_count <= 1;
+            CallMethod(command_header.argument);
 
             if (!dma_state.non_incrementing) {
                 dma_state.method++;
@@ -187,6 +216,37 @@ void DmaPusher::SetState(const CommandHeader& command_header) {
 }
 
 void DmaPusher::CallMethod(u32 argument) const {
+    if (!capture) [[likely]] {
+        ExecuteMethod(argument);
+        return;
+    }
+    // Methods are recorded once they ran, so the memory they read is in the capture ahead of them
+    memory_manager.SetReadObserver(capture.get());
+    ExecuteMethod(argument);
+    memory_manager.SetReadObserver(nullptr);
+    if (dma_state.method >= non_puller_methods &&
+        subchannels[dma_state.subchannel]->execution_mask[dma_state.method]) {
+        capture->DmaSegment(dma_state.dma_get + dma_state.dma_word_offset);
+    }
+    capture->Method(dma_state.subchannel, dma_state.method, argument, dma_state.is_last_call);
+}
+
+void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
+    if (!capture) [[likely]] {
+        ExecuteMultiMethod(base_start, num_methods);
+        return;
+    }
+    memory_manager.SetReadObserver(capture.get());
+    ExecuteMultiMethod(base_start, num_methods);
+    memory_manager.SetReadObserver(nullptr);
+    if (dma_state.method >= non_puller_methods) {
+        capture->DmaSegment(dma_state.dma_get + dma_state.dma_word_offset);
+    }
+    capture->MultiMethod(dma_state.subchannel, dma_state.method,
+                         std::span<const u32>(base_start, num_methods), dma_state.method_count);
+}
+
+void DmaPusher::ExecuteMethod(u32 argument) const {
     if (dma_state.method < non_puller_methods) {
         puller.CallPullerMethod(Engines::Puller::MethodCall{
             dma_state.method,
@@ -206,7 +266,7 @@ void DmaPusher::CallMethod(u32 argument) const {
     }
 }
 
-void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
+void DmaPusher::ExecuteMultiMethod(const u32* base_start, u32 num_methods) const {
     if (dma_state.method < non_puller_methods) {
         puller.CallMultiMethod(dma_state.method, dma_state.subchannel, base_start, num_methods,
                                dma_state.method_count);
@@ -219,8 +279,52 @@ void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     }
 }
 
+u32 DmaPusher::CallMethodRun(const u32* base_start, u32 max_run) const {
+    const auto subchannel = subchannels[dma_state.subchannel];
+    u32 run = 0;
+    while (run < max_run && !subchannel->execution_mask[dma_state.method + run]) {
+        ++run;
+    }
+    if (run == 0) {
+        return 0;
+    }
+    if (capture) [[unlikely]] {
+        for (u32 i = 0; i < run; i++) {
+            capture->Method(dma_state.subchannel, dma_state.method + i, base_start[i],
+                            dma_state.method_count - i <= 1);
+        }
+    }
+    subchannel->CallMethodRun(dma_state.method, base_start, run);
+    return run;
+}
+
 void DmaPusher::BindRasterizer(VideoCore::RasterizerInterface* rasterizer) {
     puller.BindRasterizer(rasterizer);
 }
 
+void DmaPusher::ReplayMethod(u32 subchannel, u32 method, u32 argument, bool is_last_call,
+                             GPUVAddr segment) {
+    dma_state.subchannel = subchannel;
+    dma_state.method = method;
+    dma_state.is_last_call = is_last_call;
+    dma_state.dma_get = segment;
+    dma_state.dma_word_offset = 0;
+    CallMethod(argument);
+}
+
+void DmaPusher::ReplayMultiMethod(u32 subchannel, u32 method, std::span<const u32> arguments,
+                                  u32 methods_pending, GPUVAddr segment) {
+    dma_state.subchannel = subchannel;
+    dma_state.method = method;
+    dma_state.method_count = methods_pending;
+    dma_state.dma_get = segment;
+    dma_state.dma_word_offset = 0;
+    CallMultiMethod(arguments.data(), static_cast<u32>(arguments.size()));
+}
+
+void DmaPusher::ReplayListEnd() {
+    gpu.FlushCommands();
+    gpu.OnCommandListEnd();
+}
+
 } // namespace Tegra
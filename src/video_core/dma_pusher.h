@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <span>
 #include <vector>
 #include <boost/container/small_vector.hpp>
@@ -25,6 +26,10 @@ namespace Control {
 struct ChannelState;
 }
 
+namespace CommandCapture {
+class Writer;
+}
+
 class GPU;
 class MemoryManager;
 
@@ -138,6 +143,14 @@ public:
 
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
+    /// Runs a method of a command capture as if it had been read from a pushbuffer at segment
+    void ReplayMethod(u32 subchannel, u32 method, u32 argument, bool is_last_call,
+                      GPUVAddr segment);
+    void ReplayMultiMethod(u32 subchannel, u32 method, std::span<const u32> arguments,
+                           u32 methods_pending, GPUVAddr segment);
+    /// Ends a replayed command list the way DispatchCalls ends one
+    void ReplayListEnd();
+
 private:
     static constexpr u32 non_puller_methods = 0x40;
     static constexpr u32 max_subchannels = 8;
@@ -148,6 +161,11 @@ private:
 
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
+    void ExecuteMethod(u32 argument) const;
+    void ExecuteMultiMethod(const u32* base_start, u32 num_methods) const;
+    /// Hands the leading non-executable methods of an incrementing command to the engine at once,
+    /// returns how many were consumed
+    u32 CallMethodRun(const u32* base_start, u32 max_run) const;
 
     Common::ScratchBuffer<CommandHeader>
         command_headers; ///< Buffer for list of commands fetched at once
@@ -178,6 +196,8 @@ private:
     Core::System& system;
     MemoryManager& memory_manager;
     mutable Engines::Puller puller;
+
+    std::unique_ptr<CommandCapture::Writer> capture; ///< Method stream recorder, when enabled
 };
 
 } // namespace Tegra
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cstring>
 #include <optional>
 #include "common/assert.h"
@@ -326,6 +327,22 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     }
 }
 
+void Maxwell3D::ProcessDirtyRegisters(u32 method, std::span<const u32> arguments) {
+    const std::span<u32> registers{regs.reg_array.data() + method, arguments.size()};
+    if (std::ranges::equal(registers, arguments)) {
+        return;
+    }
+    for (size_t i = 0; i < arguments.size(); i++) {
+        if (registers[i] == arguments[i]) {
+            continue;
+        }
+        for (const auto& table : dirty.tables) {
+            dirty.flags[table[method + i]] = true;
+        }
+    }
+    std::ranges::copy(arguments, registers.begin());
+}
+
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
                                   bool is_last_call) {
     switch (method) {
@@ -465,6 +482,12 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
         return;
     }
     default:
+        if (!execution_mask[method] && executing_macro == 0) {
+            // Repeated writes to a register without side effects, only the last one is visible
+            ConsumeSink();
+            ProcessDirtyRegisters(method, ProcessShadowRam(method, base_start[amount - 1]));
+            break;
+        }
         for (u32 i = 0; i < amount; i++) {
             CallMethod(method, base_start[i], methods_pending - i <= 1);
         }
@@ -472,6 +495,23 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     }
 }
 
+void Maxwell3D::CallMethodRun(u32 method, const u32* base_start, u32 amount) {
+    ASSERT_MSG(method + amount <= Regs::NUM_REGS,
+               "Invalid Maxwell3D register, increase the size of the Regs structure");
+
+    // Pending sink writes are older than the run and must land first
+    ConsumeSink();
+    std::span<const u32> arguments{base_start, amount};
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        std::ranges::copy(arguments, shadow_state.reg_array.begin() + method);
+    } else if (control == Regs::ShadowRamControl::Replay) {
+        arguments = std::span<const u32>{shadow_state.reg_array.data() + method, amount};
+    }
+    ProcessDirtyRegisters(method, arguments);
+}
+
 void Maxwell3D::ProcessMacroUpload(u32 data) {
     macro_engine->AddCode(regs.load_mme.instruction_ptr++, data);
 }
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <limits>
 #include <optional>
+#include <span>
 #include <type_traits>
 #include <vector>
 
@@ -3078,6 +3079,9 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write a run of values to consecutive registers without side effects.
+    void CallMethodRun(u32 method, const u32* base_start, u32 amount) override;
+
     bool ShouldExecute() const {
         return execute_on;
     }
@@ -3139,6 +3143,7 @@ private:
     u32 ProcessShadowRam(u32 method, u32 argument);
 
     void ProcessDirtyRegisters(u32 method, u32 argument);
+    void ProcessDirtyRegisters(u32 method, std::span<const u32> arguments);
 
     void ConsumeSinkImpl() override;
 
@@ -86,7 +86,7 @@ void Puller::ProcessSemaphoreTriggerMethod() {
                           VideoCommon::QueryPropertiesFlags::HasTimeout, payload, 0);
     } else {
         do {
-            const u32 word{memory_manager.Read<u32>(regs.semaphore_address.SemaphoreAddress())};
+            const u32 word{ReadSemaphore()};
             regs.acquire_source = true;
             regs.acquire_value = regs.semaphore_sequence;
             if (op == GpuSemaphoreOperation::AcquireEqual) {
@@ -123,19 +123,26 @@ void Puller::ProcessSemaphoreRelease() {
 }
 
 void Puller::ProcessSemaphoreAcquire() {
-    u32 word = memory_manager.Read<u32>(regs.semaphore_address.SemaphoreAddress());
+    u32 word = ReadSemaphore();
     const auto value = regs.semaphore_acquire;
     while (word != value) {
         regs.acquire_active = true;
         regs.acquire_value = value;
         rasterizer->ReleaseFences();
-        word = memory_manager.Read<u32>(regs.semaphore_address.SemaphoreAddress());
+        word = ReadSemaphore();
         // TODO(kemathe73) figure out how to do the acquire_timeout
         regs.acquire_mode = false;
         regs.acquire_source = false;
     }
 }
 
+u32 Puller::ReadSemaphore() const {
+    // A block read, unlike Read<u32>, is seen by command captures
+    u32 word{};
+    memory_manager.ReadBlockUnsafe(regs.semaphore_address.SemaphoreAddress(), &word, sizeof(word));
+    return word;
+}
+
 /// Calls a GPU puller method.
 void Puller::CallPullerMethod(const MethodCall& method_call) {
     regs.reg_array[method_call.method] = method_call.argument;
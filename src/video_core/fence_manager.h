@@ -250,6 +250,8 @@ private:
             texture_cache.PopAsyncFlushes();
             buffer_cache.PopAsyncFlushes();
         }
+        // Writing downloads to guest memory doesn't need the cache locks, let rendering continue
+        buffer_cache.CompleteAsyncFlushes();
         query_cache.PopAsyncFlushes();
     }
 
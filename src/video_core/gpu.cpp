@@ -196,6 +196,10 @@ struct GPU::Impl {
         return *shader_notify;
     }
 
+    [[nodiscard]] VideoCommon::GPUThread::QueueStats GetAndResetQueueStats() {
+        return gpu_thread.GetAndResetStats();
+    }
+
     [[nodiscard]] u64 GetTicks() const {
         u64 gpu_tick = system.CoreTiming().GetGPUTicks();
 
@@ -250,6 +254,10 @@ struct GPU::Impl {
         gpu_thread.SubmitList(channel, std::move(entries));
     }
 
+    void PushGPUEntries(s32 channel, std::span<Tegra::CommandList> lists) {
+        gpu_thread.SubmitLists(channel, lists);
+    }
+
     /// Push GPU command buffer entries to be processed
     void PushCommandBuffer(u32 id, Tegra::ChCommandHeaderList& entries) {
         if (!use_nvdec) {
@@ -511,6 +519,10 @@ const VideoCore::ShaderNotify& GPU::ShaderNotify() const {
     return impl->ShaderNotify();
 }
 
+VideoCommon::GPUThread::QueueStats GPU::GetAndResetQueueStats() {
+    return impl->GetAndResetQueueStats();
+}
+
 void GPU::RequestComposite(std::vector<Tegra::FramebufferConfig>&& layers,
                            std::vector<Service::Nvidia::NvFence>&& fences) {
     impl->RequestComposite(std::move(layers), std::move(fences));
@@ -556,6 +568,10 @@ void GPU::PushGPUEntries(s32 channel, Tegra::CommandList&& entries) {
     impl->PushGPUEntries(channel, std::move(entries));
 }
 
+void GPU::PushGPUEntries(s32 channel, std::span<Tegra::CommandList> lists) {
+    impl->PushGPUEntries(channel, lists);
+}
+
 void GPU::PushCommandBuffer(u32 id, Tegra::ChCommandHeaderList& entries) {
     impl->PushCommandBuffer(id, entries);
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 
 #include "common/bit_field.h"
 #include "common/common_types.h"
@@ -21,6 +22,10 @@ class RendererBase;
 class ShaderNotify;
 } // namespace VideoCore
 
+namespace VideoCommon::GPUThread {
+struct QueueStats;
+} // namespace VideoCommon::GPUThread
+
 namespace Tegra {
 class DmaPusher;
 struct CommandList;
@@ -206,6 +211,9 @@ public:
 
     [[nodiscard]] u64 GetTicks() const;
 
+    /// Returns the GPU thread queue statistics gathered since the previous call.
+    [[nodiscard]] VideoCommon::GPUThread::QueueStats GetAndResetQueueStats();
+
     [[nodiscard]] bool IsAsync() const;
 
     [[nodiscard]] bool UseNvdec() const;
@@ -234,6 +242,9 @@ public:
     /// Push GPU command entries to be processed
     void PushGPUEntries(s32 channel, Tegra::CommandList&& entries);
 
+    /// Push several GPU command lists of a channel at once, waking the GPU thread once
+    void PushGPUEntries(s32 channel, std::span<Tegra::CommandList> lists);
+
     /// Push GPU command buffer entries to be processed
     void PushCommandBuffer(u32 id, Tegra::ChCommandHeaderList& entries);
 
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "common/assert.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
@@ -16,6 +18,30 @@
 
 namespace VideoCommon::GPUThread {
 
+namespace {
+/// Bounds of the number of polls the GPU thread makes on an empty queue before it parks
+constexpr u32 MIN_SPIN_COUNT = 16;
+constexpr u32 MAX_SPIN_COUNT = 4096;
+
+/// Polls the queue for a while before parking the thread. The poll budget grows when commands
+/// keep arriving while polling and shrinks when the thread ends up parking anyway.
+void WaitForCommand(SynchState& state, CommandDataContainer& next, u32& spin_count,
+                    std::stop_token stop_token) {
+    if (state.queue.TryPop(next)) {
+        return;
+    }
+    for (u32 spin = 0; spin < spin_count; ++spin) {
+        std::this_thread::yield();
+        if (state.queue.TryPop(next)) {
+            spin_count = std::min(spin_count * 2, MAX_SPIN_COUNT);
+            return;
+        }
+    }
+    spin_count = std::max(spin_count / 2, MIN_SPIN_COUNT);
+    state.queue.PopWait(next, stop_token);
+}
+} // Anonymous namespace
+
 /// Runs the GPU thread
 static void RunThread(std::stop_token stop_token, Core::System& system,
                       VideoCore::RendererBase& renderer, Core::Frontend::GraphicsContext& context,
@@ -34,12 +60,18 @@ static void RunThread(std::stop_token stop_token, Core::System& system,
     VideoCore::RasterizerInterface* const rasterizer = renderer.ReadRasterizer();
 
     CommandDataContainer next;
+    u32 spin_count = MIN_SPIN_COUNT;
 
     while (!stop_token.stop_requested()) {
-        state.queue.PopWait(next, stop_token);
+        WaitForCommand(state, next, spin_count, stop_token);
         if (stop_token.stop_requested()) {
             break;
         }
+        const auto latency = CommandDataContainer::Clock::now() - next.push_time;
+        state.accumulated_latency_ns.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count(),
+            std::memory_order_relaxed);
+        state.popped_commands.fetch_add(1, std::memory_order_relaxed);
         if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
             scheduler.Push(submit_list->channel, std::move(submit_list->entries));
         } else if (std::holds_alternative<GPUTickCommand>(next.data)) {
@@ -78,6 +110,21 @@ void ThreadManager::SubmitList(s32 channel, Tegra::CommandList&& entries) {
     PushCommand(SubmitListCommand(channel, std::move(entries)));
 }
 
+void ThreadManager::SubmitLists(s32 channel, std::span<Tegra::CommandList> lists) {
+    if (!is_async) {
+        // Every command blocks in synchronous GPU mode, there is nothing to batch
+        for (Tegra::CommandList& entries : lists) {
+            SubmitList(channel, std::move(entries));
+        }
+        return;
+    }
+    std::scoped_lock lk{state.write_lock};
+    for (Tegra::CommandList& entries : lists) {
+        EnqueueCommand(SubmitListCommand(channel, std::move(entries)), false);
+    }
+    state.queue.Flush();
+}
+
 void ThreadManager::FlushRegion(DAddr addr, u64 size) {
     if (!is_async) {
         // Always flush with synchronous GPU mode
@@ -106,6 +153,18 @@ void ThreadManager::FlushAndInvalidateRegion(DAddr addr, u64 size) {
     rasterizer->OnCacheInvalidation(addr, size);
 }
 
+QueueStats ThreadManager::GetAndResetStats() {
+    const u64 pushed = state.pushed_commands.exchange(0, std::memory_order_relaxed);
+    const u64 depth = state.accumulated_depth.exchange(0, std::memory_order_relaxed);
+    const u64 popped = state.popped_commands.exchange(0, std::memory_order_relaxed);
+    const u64 latency_ns = state.accumulated_latency_ns.exchange(0, std::memory_order_relaxed);
+    return QueueStats{
+        .commands = pushed,
+        .average_depth = pushed != 0 ? static_cast<double>(depth) / pushed : 0.0,
+        .average_latency_us = popped != 0 ? static_cast<double>(latency_ns) / popped / 1000.0 : 0.0,
+    };
+}
+
 u64 ThreadManager::PushCommand(CommandData&& command_data, bool block) {
     if (!is_async) {
         // In synchronous GPU mode, block the caller until the command has executed
@@ -113,8 +172,8 @@ u64 ThreadManager::PushCommand(CommandData&& command_data, bool block) {
     }
 
     std::unique_lock lk(state.write_lock);
-    const u64 fence{++state.last_fence};
-    state.queue.EmplaceWait(std::move(command_data), fence, block);
+    const u64 fence{EnqueueCommand(std::move(command_data), block)};
+    state.queue.Flush();
 
     if (block) {
         Common::CondvarWait(state.cv, lk, thread.get_stop_token(), [this, fence] {
@@ -125,4 +184,14 @@ u64 ThreadManager::PushCommand(CommandData&& command_data, bool block) {
     return fence;
 }
 
+u64 ThreadManager::EnqueueCommand(CommandData&& command_data, bool block) {
+    const u64 fence{++state.last_fence};
+    state.accumulated_depth.fetch_add(
+        fence - 1 - state.signaled_fence.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    state.pushed_commands.fetch_add(1, std::memory_order_relaxed);
+    state.queue.EmplaceWaitDeferred(std::move(command_data), fence, block);
+    return fence;
+}
+
 } // namespace VideoCommon::GPUThread
@@ -4,14 +4,17 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <thread>
 #include <variant>
 
 #include "common/bounded_threadsafe_queue.h"
 #include "common/polyfill_thread.h"
+#include "video_core/dma_pusher.h"
 #include "video_core/framebuffer_config.h"
 
 namespace Tegra {
@@ -77,24 +80,43 @@ using CommandData =
                  FlushAndInvalidateRegionCommand, GPUTickCommand>;
 
 struct CommandDataContainer {
+    using Clock = std::chrono::steady_clock;
+
     CommandDataContainer() = default;
 
     explicit CommandDataContainer(CommandData&& data_, u64 next_fence_, bool block_)
-        : data{std::move(data_)}, fence{next_fence_}, block(block_) {}
+        : data{std::move(data_)}, fence{next_fence_}, block(block_), push_time{Clock::now()} {}
 
     CommandData data;
     u64 fence{};
     bool block{};
+    Clock::time_point push_time{};
+};
+
+/// Queue statistics accumulated since they were last reset
+struct QueueStats {
+    /// Number of commands pushed
+    u64 commands{};
+    /// Average number of commands still pending when a command was pushed
+    double average_depth{};
+    /// Average time between pushing a command and the GPU thread picking it up, in microseconds
+    double average_latency_us{};
 };
 
 /// Struct used to synchronize the GPU thread
 struct SynchState final {
-    using CommandQueue = Common::MPSCQueue<CommandDataContainer>;
+    /// Producers are serialized by write_lock, so the ring itself only has one writer
+    using CommandQueue = Common::SPSCQueue<CommandDataContainer>;
     std::mutex write_lock;
     CommandQueue queue;
     u64 last_fence{};
     std::atomic<u64> signaled_fence{};
     std::condition_variable_any cv;
+
+    std::atomic<u64> pushed_commands{};
+    std::atomic<u64> accumulated_depth{};
+    std::atomic<u64> popped_commands{};
+    std::atomic<u64> accumulated_latency_ns{};
 };
 
 /// Class used to manage the GPU thread
@@ -110,6 +132,9 @@ public:
     /// Push GPU command entries to be processed
     void SubmitList(s32 channel, Tegra::CommandList&& entries);
 
+    /// Push several GPU command lists of a channel, waking the GPU thread once for all of them
+    void SubmitLists(s32 channel, std::span<Tegra::CommandList> lists);
+
     /// Notify rasterizer that any caches of the specified region should be flushed to Switch memory
     void FlushRegion(DAddr addr, u64 size);
 
@@ -121,10 +146,16 @@ public:
 
     void TickGPU();
 
+    /// Returns the queue statistics gathered since the previous call
+    QueueStats GetAndResetStats();
+
 private:
     /// Pushes a command to be executed by the GPU thread
     u64 PushCommand(CommandData&& command_data, bool block = false);
 
+    /// Queues a command without waking the GPU thread, write_lock must be held
+    u64 EnqueueCommand(CommandData&& command_data, bool block);
+
     Core::System& system;
     const bool is_async;
     VideoCore::RasterizerInterface* rasterizer = nullptr;
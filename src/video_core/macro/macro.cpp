@@ -21,6 +21,8 @@
 
 #ifdef ARCHITECTURE_x86_64
 #include "video_core/macro/macro_jit_x64.h"
+#elif defined(ARCHITECTURE_arm64)
+#include "video_core/macro/macro_jit_a64.h"
 #endif
 
 MICROPROFILE_DEFINE(MacroHLE, "GPU", "Execute macro HLE", MP_RGB(128, 192, 192));
@@ -134,6 +136,8 @@ std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d) {
     }
 #ifdef ARCHITECTURE_x86_64
     return std::make_unique<MacroJITx64>(maxwell3d);
+#elif defined(ARCHITECTURE_arm64)
+    return std::make_unique<MacroJITA64>(maxwell3d);
 #else
     return std::make_unique<MacroInterpreter>(maxwell3d);
 #endif
@@ -0,0 +1,532 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include <oaknut/code_block.hpp>
+#include <oaknut/oaknut.hpp>
+
+#include "common/assert.h"
+#include "common/bit_field.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro/macro_jit_a64.h"
+
+MICROPROFILE_DEFINE(MacroJitCompile, "GPU", "Compile macro JIT", MP_RGB(173, 255, 47));
+MICROPROFILE_DEFINE(MacroJitExecute, "GPU", "Execute macro JIT", MP_RGB(255, 255, 0));
+
+namespace Tegra {
+namespace {
+
+using namespace oaknut::util;
+
+// Macro registers 1 to 7 are pinned to the callee saved registers W19-W25, so they survive the
+// calls into Maxwell3D without being spilled. Register 0 always reads as WZR.
+constexpr int MACRO_REGISTER_BASE = 18;
+constexpr oaknut::XReg STATE = X26;
+constexpr oaknut::XReg PARAMETERS = X27;
+constexpr oaknut::XReg MAX_PARAMETER = X28;
+
+// Caller saved, spilled around calls
+constexpr oaknut::WReg METHOD_ADDRESS = W9;
+constexpr oaknut::WReg RESULT = W10;
+constexpr oaknut::XReg RESULT_X = X10;
+constexpr oaknut::WReg CARRY = W11;
+constexpr oaknut::WReg PARAMETER = W12;
+
+// Stack frame holding X19-X30
+constexpr int FRAME_SIZE = 96;
+
+// Upper bound of host instructions emitted for a single macro opcode. The worst case is a
+// fetch and send in the delay slot of a taken branch, which emits both calls twice.
+constexpr size_t MAX_HOST_INSTRUCTIONS_PER_OPCODE = 128;
+constexpr size_t PROLOGUE_EPILOGUE_SIZE = 64 * sizeof(u32);
+
+constexpr size_t REG_ARRAY_OFFSET =
+    offsetof(Engines::Maxwell3D, regs) + offsetof(Engines::Maxwell3D::Regs, reg_array);
+
+void Send(Engines::Maxwell3D* maxwell3d, u32 method_address, u32 value) {
+    const Macro::MethodAddress address{method_address};
+    maxwell3d->CallMethod(address.address, value, true);
+}
+
+void WarnInvalidParameter(uintptr_t parameter, uintptr_t max_parameter) {
+    LOG_CRITICAL(HW_GPU,
+                 "Macro JIT: invalid parameter access 0x{:x} (0x{:x} is the last parameter)",
+                 parameter, max_parameter - sizeof(u32));
+}
+
+size_t CodeSize(const std::vector<u32>& code) {
+    return code.size() * MAX_HOST_INSTRUCTIONS_PER_OPCODE * sizeof(u32) + PROLOGUE_EPILOGUE_SIZE;
+}
+
+class MacroJITA64Impl final : public CachedMacro {
+public:
+    explicit MacroJITA64Impl(Engines::Maxwell3D& maxwell3d_, const std::vector<u32>& code_)
+        : mem{CodeSize(code_)}, c{mem.ptr()}, code{code_}, maxwell3d{maxwell3d_} {
+        Compile();
+    }
+
+    void Execute(const std::vector<u32>& parameters, u32 method) override;
+
+private:
+    using ProgramType = void (*)(Engines::Maxwell3D*, const u32*, const u32*);
+
+    void Optimizer_ScanFlags();
+
+    void Compile();
+    void Compile_Instruction(u32 pc);
+    void Compile_DelaySlot(u32 pc);
+    void Compile_Operation(Macro::Opcode opcode);
+
+    void Compile_ALU(Macro::Opcode opcode);
+    void Compile_AddImmediate(Macro::Opcode opcode);
+    void Compile_ExtractInsert(Macro::Opcode opcode);
+    void Compile_ExtractShiftLeftImmediate(Macro::Opcode opcode);
+    void Compile_ExtractShiftLeftRegister(Macro::Opcode opcode);
+    void Compile_Read(Macro::Opcode opcode);
+    void Compile_Branch(Macro::Opcode opcode, u32 pc);
+
+    void Compile_AddToResult(u32 index, s32 immediate);
+    oaknut::WReg Compile_FetchParameter();
+    void Compile_ProcessResult(Macro::ResultOperation operation, u32 reg);
+    void Compile_Send(oaknut::WReg value);
+    void Compile_SetCarry();
+    void Compile_LoadCarry();
+
+    void Compile_SaveScratch();
+    void Compile_RestoreScratch();
+
+    struct OptimizerState {
+        bool can_skip_carry{};
+        bool skip_dummy_addimmediate{};
+    };
+    OptimizerState optimizer{};
+
+    oaknut::CodeBlock mem;
+    oaknut::CodeGenerator c;
+    ProgramType program{nullptr};
+
+    std::vector<oaknut::Label> labels;
+    oaknut::Label end_of_code;
+
+    const std::vector<u32>& code;
+    Engines::Maxwell3D& maxwell3d;
+};
+
+oaknut::WReg MacroRegister(u32 index) {
+    if (index == 0) {
+        return WZR;
+    }
+    return oaknut::WReg{MACRO_REGISTER_BASE + static_cast<int>(index)};
+}
+
+void MacroJITA64Impl::Execute(const std::vector<u32>& parameters, u32 method) {
+    MICROPROFILE_SCOPE(MacroJitExecute);
+    ASSERT_OR_EXECUTE(program != nullptr, { return; });
+    program(&maxwell3d, parameters.data(), parameters.data() + parameters.size());
+}
+
+void MacroJITA64Impl::Compile_ALU(Macro::Opcode opcode) {
+    const oaknut::WReg src_a = MacroRegister(opcode.src_a);
+    const oaknut::WReg src_b = MacroRegister(opcode.src_b);
+
+    switch (opcode.alu_operation) {
+    case Macro::ALUOperation::Add:
+        if (optimizer.can_skip_carry) {
+            c.ADD(RESULT, src_a, src_b);
+        } else {
+            c.ADDS(RESULT, src_a, src_b);
+            Compile_SetCarry();
+        }
+        break;
+    case Macro::ALUOperation::AddWithCarry:
+        Compile_LoadCarry();
+        c.ADCS(RESULT, src_a, src_b);
+        Compile_SetCarry();
+        break;
+    case Macro::ALUOperation::Subtract:
+        // The macro carry flag is set when there is no borrow, which matches the AArch64 C flag.
+        if (optimizer.can_skip_carry) {
+            c.SUB(RESULT, src_a, src_b);
+        } else {
+            c.SUBS(RESULT, src_a, src_b);
+            Compile_SetCarry();
+        }
+        break;
+    case Macro::ALUOperation::SubtractWithBorrow:
+        Compile_LoadCarry();
+        c.SBCS(RESULT, src_a, src_b);
+        Compile_SetCarry();
+        break;
+    case Macro::ALUOperation::Xor:
+        c.EOR(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::Or:
+        c.ORR(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::And:
+        c.AND(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::AndNot:
+        c.BIC(RESULT, src_a, src_b);
+        break;
+    case Macro::ALUOperation::Nand:
+        c.AND(RESULT, src_a, src_b);
+        c.MVN(RESULT, RESULT);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented ALU operation {}", opcode.alu_operation.Value());
+        c.MOV(RESULT, WZR);
+        break;
+    }
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITA64Impl::Compile_AddImmediate(Macro::Opcode opcode) {
+    if (optimizer.skip_dummy_addimmediate) {
+        // Games tend to use this as an exit instruction placeholder. It's to encode an instruction
+        // without doing anything. In our case we can just not emit anything.
+        if (opcode.result_operation == Macro::ResultOperation::Move && opcode.dst == 0) {
+            return;
+        }
+    }
+    Compile_AddToResult(opcode.src_a, opcode.immediate);
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITA64Impl::Compile_ExtractInsert(Macro::Opcode opcode) {
+    const oaknut::WReg dst = MacroRegister(opcode.src_a);
+    const oaknut::WReg src = MacroRegister(opcode.src_b);
+    const u32 mask = opcode.GetBitfieldMask();
+
+    c.MOV(W0, mask);
+    c.AND(W0, W0, src, oaknut::LogShift::LSR, opcode.bf_src_bit.Value());
+    c.MOV(W1, ~(mask << opcode.bf_dst_bit));
+    c.AND(RESULT, dst, W1);
+    c.ORR(RESULT, RESULT, W0, oaknut::LogShift::LSL, opcode.bf_dst_bit.Value());
+
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITA64Impl::Compile_ExtractShiftLeftImmediate(Macro::Opcode opcode) {
+    const oaknut::WReg dst = MacroRegister(opcode.src_a);
+    const oaknut::WReg src = MacroRegister(opcode.src_b);
+
+    // ((src >> dst) & mask) << bf_dst_bit, with the mask shifted ahead of time
+    c.LSRV(W0, src, dst);
+    c.MOV(W1, opcode.GetBitfieldMask() << opcode.bf_dst_bit);
+    c.AND(RESULT, W1, W0, oaknut::LogShift::LSL, opcode.bf_dst_bit.Value());
+
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITA64Impl::Compile_ExtractShiftLeftRegister(Macro::Opcode opcode) {
+    const oaknut::WReg dst = MacroRegister(opcode.src_a);
+    const oaknut::WReg src = MacroRegister(opcode.src_b);
+
+    c.MOV(W0, opcode.GetBitfieldMask());
+    c.AND(W0, W0, src, oaknut::LogShift::LSR, opcode.bf_src_bit.Value());
+    c.LSLV(RESULT, W0, dst);
+
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITA64Impl::Compile_Read(Macro::Opcode opcode) {
+    Compile_AddToResult(opcode.src_a, opcode.immediate);
+
+    // Equivalent to Engines::Maxwell3D::GetRegisterValue:
+    c.MOV(X0, REG_ARRAY_OFFSET);
+    c.ADD(X0, STATE, X0);
+    c.ADD(X0, X0, RESULT_X, oaknut::AddSubShift::LSL, 2);
+    c.LDR(RESULT, X0, 0);
+
+    Compile_ProcessResult(opcode.result_operation, opcode.dst);
+}
+
+void MacroJITA64Impl::Compile_Branch(Macro::Opcode opcode, u32 pc) {
+    const s32 jump_address =
+        static_cast<s32>(pc) + static_cast<s32>(opcode.GetBranchTarget() / sizeof(s32));
+    const bool in_range = jump_address >= 0 && static_cast<size_t>(jump_address) < code.size();
+    oaknut::Label& target = in_range ? labels[jump_address] : end_of_code;
+
+    oaknut::Label not_taken;
+    const oaknut::WReg value = MacroRegister(opcode.src_a);
+    switch (opcode.branch_condition) {
+    case Macro::BranchCondition::Zero:
+        c.CBNZ(value, not_taken);
+        break;
+    case Macro::BranchCondition::NotZero:
+        c.CBZ(value, not_taken);
+        break;
+    }
+    // The delay slot is resolved at compile time: the taken path gets its own copy of the next
+    // instruction, so nothing has to be tracked while the program runs.
+    if (!opcode.branch_annul) {
+        Compile_DelaySlot(pc + 1);
+    }
+    c.B(target);
+    c.l(not_taken);
+}
+
+void MacroJITA64Impl::Optimizer_ScanFlags() {
+    optimizer.can_skip_carry = true;
+    for (const u32 raw_op : code) {
+        const Macro::Opcode op{raw_op};
+        if (op.operation != Macro::Operation::ALU) {
+            continue;
+        }
+        // Scan for any ALU operations which actually use the carry flag, if they don't exist in
+        // our current code we can skip emitting the carry flag handling operations
+        if (op.alu_operation == Macro::ALUOperation::AddWithCarry ||
+            op.alu_operation == Macro::ALUOperation::SubtractWithBorrow) {
+            optimizer.can_skip_carry = false;
+        }
+    }
+}
+
+void MacroJITA64Impl::Compile() {
+    MICROPROFILE_SCOPE(MacroJitCompile);
+    labels.resize(code.size());
+
+    // AddImmediate tends to be used as a NOP instruction, if we detect this we can
+    // completely skip the entire code path and no emit anything
+    optimizer.skip_dummy_addimmediate = true;
+
+    // Check to see if we can skip emitting certain instructions
+    Optimizer_ScanFlags();
+
+    mem.unprotect();
+
+    c.STP(X29, X30, SP, PRE_INDEXED, -FRAME_SIZE);
+    c.MOV(X29, SP);
+    c.STP(X19, X20, SP, 16);
+    c.STP(X21, X22, SP, 32);
+    c.STP(X23, X24, SP, 48);
+    c.STP(X25, X26, SP, 64);
+    c.STP(X27, X28, SP, 80);
+
+    c.MOV(STATE, X0);
+    c.MOV(PARAMETERS, X1);
+    c.MOV(MAX_PARAMETER, X2);
+    c.MOV(METHOD_ADDRESS, WZR);
+    c.MOV(CARRY, WZR);
+    for (u32 index = 2; index < Macro::NUM_MACRO_REGISTERS; ++index) {
+        c.MOV(MacroRegister(index), WZR);
+    }
+    c.MOV(MacroRegister(1), Compile_FetchParameter());
+
+    for (u32 pc = 0; pc < static_cast<u32>(code.size()); ++pc) {
+        c.l(labels[pc]);
+        Compile_Instruction(pc);
+    }
+
+    c.l(end_of_code);
+    c.LDP(X19, X20, SP, 16);
+    c.LDP(X21, X22, SP, 32);
+    c.LDP(X23, X24, SP, 48);
+    c.LDP(X25, X26, SP, 64);
+    c.LDP(X27, X28, SP, 80);
+    c.LDP(X29, X30, SP, POST_INDEXED, FRAME_SIZE);
+    c.RET();
+
+    const size_t code_size = static_cast<size_t>(c.offset());
+    ASSERT_MSG(code_size <= CodeSize(code), "Macro JIT overflowed its code buffer");
+
+    mem.protect();
+    mem.invalidate_all();
+    program = reinterpret_cast<ProgramType>(mem.ptr());
+}
+
+void MacroJITA64Impl::Compile_Instruction(u32 pc) {
+    const Macro::Opcode opcode{code[pc]};
+    if (opcode.operation == Macro::Operation::Branch) {
+        Compile_Branch(opcode, pc);
+    } else {
+        Compile_Operation(opcode);
+    }
+    // An exit also has a delay slot. Like any other instruction the exit flag of a taken branch is
+    // never reached, as the branch has already jumped away at this point.
+    if (opcode.is_exit) {
+        Compile_DelaySlot(pc + 1);
+        c.B(end_of_code);
+    }
+}
+
+void MacroJITA64Impl::Compile_DelaySlot(u32 pc) {
+    if (pc >= code.size()) {
+        return;
+    }
+    const Macro::Opcode opcode{code[pc]};
+    if (opcode.operation == Macro::Operation::Branch) {
+        ASSERT_MSG(false, "Executing a branch in a delay slot is not valid");
+        return;
+    }
+    // An instruction with the Exit flag will not actually cause an exit if it's executed inside a
+    // delay slot.
+    Compile_Operation(opcode);
+}
+
+void MacroJITA64Impl::Compile_Operation(Macro::Opcode opcode) {
+    switch (opcode.operation) {
+    case Macro::Operation::ALU:
+        Compile_ALU(opcode);
+        break;
+    case Macro::Operation::AddImmediate:
+        Compile_AddImmediate(opcode);
+        break;
+    case Macro::Operation::ExtractInsert:
+        Compile_ExtractInsert(opcode);
+        break;
+    case Macro::Operation::ExtractShiftLeftImmediate:
+        Compile_ExtractShiftLeftImmediate(opcode);
+        break;
+    case Macro::Operation::ExtractShiftLeftRegister:
+        Compile_ExtractShiftLeftRegister(opcode);
+        break;
+    case Macro::Operation::Read:
+        Compile_Read(opcode);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented opcode {}", opcode.operation.Value());
+        break;
+    }
+}
+
+void MacroJITA64Impl::Compile_AddToResult(u32 index, s32 immediate) {
+    const oaknut::WReg src = MacroRegister(index);
+    if (index == 0) {
+        c.MOV(RESULT, static_cast<u32>(immediate));
+    } else if (immediate == 0) {
+        c.MOV(RESULT, src);
+    } else if (immediate > 0 && immediate < 0x1000) {
+        c.ADD(RESULT, src, static_cast<u32>(immediate));
+    } else if (immediate < 0 && immediate > -0x1000) {
+        c.SUB(RESULT, src, static_cast<u32>(-immediate));
+    } else {
+        c.MOV(W0, static_cast<u32>(immediate));
+        c.ADD(RESULT, src, W0);
+    }
+}
+
+oaknut::WReg MacroJITA64Impl::Compile_FetchParameter() {
+    oaknut::Label parameter_ok;
+    c.CMP(PARAMETERS, MAX_PARAMETER);
+    c.B(oaknut::Cond::LO, parameter_ok);
+    Compile_SaveScratch();
+    c.MOV(X0, PARAMETERS);
+    c.MOV(X1, MAX_PARAMETER);
+    c.MOV(X16, reinterpret_cast<u64>(&WarnInvalidParameter));
+    c.BLR(X16);
+    Compile_RestoreScratch();
+    c.l(parameter_ok);
+    c.LDR(PARAMETER, PARAMETERS, POST_INDEXED, sizeof(u32));
+    return PARAMETER;
+}
+
+void MacroJITA64Impl::Compile_ProcessResult(Macro::ResultOperation operation, u32 reg) {
+    const auto SetRegister = [this](u32 reg_index, oaknut::WReg result) {
+        // Register 0 is supposed to always return 0. NOP is implemented as a store to the zero
+        // register.
+        if (reg_index == 0) {
+            return;
+        }
+        c.MOV(MacroRegister(reg_index), result);
+    };
+    const auto SetMethodAddress = [this](oaknut::WReg reg32) { c.MOV(METHOD_ADDRESS, reg32); };
+
+    switch (operation) {
+    case Macro::ResultOperation::IgnoreAndFetch:
+        SetRegister(reg, Compile_FetchParameter());
+        break;
+    case Macro::ResultOperation::Move:
+        SetRegister(reg, RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSetMethod:
+        SetRegister(reg, RESULT);
+        SetMethodAddress(RESULT);
+        break;
+    case Macro::ResultOperation::FetchAndSend:
+        // Fetch parameter and send result.
+        SetRegister(reg, Compile_FetchParameter());
+        Compile_Send(RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSend:
+        // Move and send result.
+        SetRegister(reg, RESULT);
+        Compile_Send(RESULT);
+        break;
+    case Macro::ResultOperation::FetchAndSetMethod:
+        // Fetch parameter and use result as Method Address.
+        SetRegister(reg, Compile_FetchParameter());
+        SetMethodAddress(RESULT);
+        break;
+    case Macro::ResultOperation::MoveAndSetMethodFetchAndSend:
+        // Move result and use as Method Address, then fetch and send parameter.
+        SetRegister(reg, RESULT);
+        SetMethodAddress(RESULT);
+        Compile_Send(Compile_FetchParameter());
+        break;
+    case Macro::ResultOperation::MoveAndSetMethodSend:
+        // Move result and use as Method Address, then send bits 12:17 of result.
+        SetRegister(reg, RESULT);
+        SetMethodAddress(RESULT);
+        c.MOV(W0, 0b111111);
+        c.AND(PARAMETER, W0, RESULT, oaknut::LogShift::LSR, 12);
+        Compile_Send(PARAMETER);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented macro operation {}", operation);
+        break;
+    }
+}
+
+void MacroJITA64Impl::Compile_Send(oaknut::WReg value) {
+    Compile_SaveScratch();
+    c.MOV(W2, value);
+    c.MOV(W1, METHOD_ADDRESS);
+    c.MOV(X0, STATE);
+    c.MOV(X16, reinterpret_cast<u64>(&Send));
+    c.BLR(X16);
+    Compile_RestoreScratch();
+
+    // Advance the 12 bit address by the increment in bits 12:17, leaving the other bits untouched
+    c.MOV(W0, 0b111111);
+    c.AND(W0, W0, METHOD_ADDRESS, oaknut::LogShift::LSR, 12);
+    c.ADD(W0, METHOD_ADDRESS, W0);
+    c.MOV(W1, 0xfff);
+    c.AND(W0, W0, W1);
+    c.BIC(METHOD_ADDRESS, METHOD_ADDRESS, W1);
+    c.ORR(METHOD_ADDRESS, METHOD_ADDRESS, W0);
+}
+
+void MacroJITA64Impl::Compile_SetCarry() {
+    if (!optimizer.can_skip_carry) {
+        c.CSET(CARRY, oaknut::Cond::CS);
+    }
+}
+
+void MacroJITA64Impl::Compile_LoadCarry() {
+    // CARRY is either 0 or 1, comparing it against 1 sets C to its value
+    c.CMP(CARRY, 1);
+}
+
+void MacroJITA64Impl::Compile_SaveScratch() {
+    c.STP(X9, X10, SP, PRE_INDEXED, -32);
+    c.STR(X11, SP, 16);
+}
+
+void MacroJITA64Impl::Compile_RestoreScratch() {
+    c.LDR(X11, SP, 16);
+    c.LDP(X9, X10, SP, POST_INDEXED, 32);
+}
+} // Anonymous namespace
+
+MacroJITA64::MacroJITA64(Engines::Maxwell3D& maxwell3d_)
+    : MacroEngine{maxwell3d_}, maxwell3d{maxwell3d_} {}
+
+std::unique_ptr<CachedMacro> MacroJITA64::Compile(const std::vector<u32>& code) {
+    return std::make_unique<MacroJITA64Impl>(maxwell3d, code);
+}
+} // namespace Tegra
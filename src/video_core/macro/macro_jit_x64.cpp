@@ -55,6 +55,7 @@ public:
     void Execute(const std::vector<u32>& parameters, u32 method) override;
 
     void Compile_ALU(Macro::Opcode opcode);
+    bool Compile_ALUZeroOperand(Macro::Opcode opcode);
     void Compile_AddImmediate(Macro::Opcode opcode);
     void Compile_ExtractInsert(Macro::Opcode opcode);
     void Compile_ExtractShiftLeftImmediate(Macro::Opcode opcode);
@@ -118,41 +119,17 @@ void MacroJITx64Impl::Execute(const std::vector<u32>& parameters, u32 method) {
 }
 
 void MacroJITx64Impl::Compile_ALU(Macro::Opcode opcode) {
-    const bool is_a_zero = opcode.src_a == 0;
-    const bool is_b_zero = opcode.src_b == 0;
-    const bool valid_operation = !is_a_zero && !is_b_zero;
-    [[maybe_unused]] const bool is_move_operation = !is_a_zero && is_b_zero;
-    const bool has_zero_register = is_a_zero || is_b_zero;
-    const bool no_zero_reg_skip = opcode.alu_operation == Macro::ALUOperation::AddWithCarry ||
-                                  opcode.alu_operation == Macro::ALUOperation::SubtractWithBorrow;
-
-    Xbyak::Reg32 src_a;
-    Xbyak::Reg32 src_b;
-
-    if (!optimizer.zero_reg_skip || no_zero_reg_skip) {
-        src_a = Compile_GetRegister(opcode.src_a, RESULT);
-        src_b = Compile_GetRegister(opcode.src_b, eax);
-    } else {
-        if (!is_a_zero) {
-            src_a = Compile_GetRegister(opcode.src_a, RESULT);
-        }
-        if (!is_b_zero) {
-            src_b = Compile_GetRegister(opcode.src_b, eax);
-        }
+    if (optimizer.zero_reg_skip && (opcode.src_a == 0 || opcode.src_b == 0) &&
+        Compile_ALUZeroOperand(opcode)) {
+        Compile_ProcessResult(opcode.result_operation, opcode.dst);
+        return;
     }
-
-    bool has_emitted = false;
+    const auto src_a = Compile_GetRegister(opcode.src_a, RESULT);
+    const auto src_b = Compile_GetRegister(opcode.src_b, eax);
 
     switch (opcode.alu_operation) {
     case Macro::ALUOperation::Add:
-        if (optimizer.zero_reg_skip) {
-            if (valid_operation) {
-                add(src_a, src_b);
-            }
-        } else {
-            add(src_a, src_b);
-        }
-
+        add(src_a, src_b);
         if (!optimizer.can_skip_carry) {
             setc(byte[STATE + offsetof(JITState, carry_flag)]);
         }
@@ -163,72 +140,34 @@ void MacroJITx64Impl::Compile_ALU(Macro::Opcode opcode) {
         setc(byte[STATE + offsetof(JITState, carry_flag)]);
         break;
     case Macro::ALUOperation::Subtract:
-        if (optimizer.zero_reg_skip) {
-            if (valid_operation) {
-                sub(src_a, src_b);
-                has_emitted = true;
-            }
-        } else {
-            sub(src_a, src_b);
-            has_emitted = true;
-        }
-        if (!optimizer.can_skip_carry && has_emitted) {
-            setc(byte[STATE + offsetof(JITState, carry_flag)]);
+        // The macro carry flag is set when there is no borrow, the opposite of the x86 CF
+        sub(src_a, src_b);
+        if (!optimizer.can_skip_carry) {
+            setnc(byte[STATE + offsetof(JITState, carry_flag)]);
         }
         break;
     case Macro::ALUOperation::SubtractWithBorrow:
         bt(dword[STATE + offsetof(JITState, carry_flag)], 0);
+        cmc();
         sbb(src_a, src_b);
-        setc(byte[STATE + offsetof(JITState, carry_flag)]);
+        setnc(byte[STATE + offsetof(JITState, carry_flag)]);
         break;
     case Macro::ALUOperation::Xor:
-        if (optimizer.zero_reg_skip) {
-            if (valid_operation) {
-                xor_(src_a, src_b);
-            }
-        } else {
-            xor_(src_a, src_b);
-        }
+        xor_(src_a, src_b);
         break;
     case Macro::ALUOperation::Or:
-        if (optimizer.zero_reg_skip) {
-            if (valid_operation) {
-                or_(src_a, src_b);
-            }
-        } else {
-            or_(src_a, src_b);
-        }
+        or_(src_a, src_b);
         break;
     case Macro::ALUOperation::And:
-        if (optimizer.zero_reg_skip) {
-            if (!has_zero_register) {
-                and_(src_a, src_b);
-            }
-        } else {
-            and_(src_a, src_b);
-        }
+        and_(src_a, src_b);
         break;
     case Macro::ALUOperation::AndNot:
-        if (optimizer.zero_reg_skip) {
-            if (!is_a_zero) {
-                not_(src_b);
-                and_(src_a, src_b);
-            }
-        } else {
-            not_(src_b);
-            and_(src_a, src_b);
-        }
+        not_(src_b);
+        and_(src_a, src_b);
         break;
     case Macro::ALUOperation::Nand:
-        if (optimizer.zero_reg_skip) {
-            if (!is_a_zero) {
-                and_(src_a, src_b);
-                not_(src_a);
-            }
-        } else {
-            and_(src_a, src_b);
-            not_(src_a);
-        }
+        and_(src_a, src_b);
+        not_(src_a);
         break;
     default:
         UNIMPLEMENTED_MSG("Unimplemented ALU operation {}", opcode.alu_operation.Value());
@@ -237,6 +176,49 @@ void MacroJITx64Impl::Compile_ALU(Macro::Opcode opcode) {
     Compile_ProcessResult(opcode.result_operation, opcode.dst);
 }
 
+/// Folds an ALU operation with a zero register operand into its known result and carry.
+/// Returns false when the operation still has to be emitted.
+bool MacroJITx64Impl::Compile_ALUZeroOperand(Macro::Opcode opcode) {
+    const bool is_a_zero = opcode.src_a == 0;
+    const u32 other = is_a_zero ? opcode.src_b : opcode.src_a;
+    const auto set_carry = [this](bool value) {
+        if (!optimizer.can_skip_carry) {
+            mov(byte[STATE + offsetof(JITState, carry_flag)], value ? 1 : 0);
+        }
+    };
+    switch (opcode.alu_operation) {
+    case Macro::ALUOperation::Add:
+        // Adding zero never carries
+        Compile_GetRegister(other, RESULT);
+        set_carry(false);
+        return true;
+    case Macro::ALUOperation::Subtract:
+        if (is_a_zero && opcode.src_b != 0) {
+            return false;
+        }
+        // Subtracting zero never borrows
+        Compile_GetRegister(opcode.src_a, RESULT);
+        set_carry(true);
+        return true;
+    case Macro::ALUOperation::Xor:
+    case Macro::ALUOperation::Or:
+        Compile_GetRegister(other, RESULT);
+        return true;
+    case Macro::ALUOperation::And:
+        xor_(RESULT, RESULT);
+        return true;
+    case Macro::ALUOperation::AndNot:
+        Compile_GetRegister(opcode.src_a, RESULT);
+        return true;
+    case Macro::ALUOperation::Nand:
+        mov(RESULT, 0xFFFFFFFF);
+        return true;
+    default:
+        // AddWithCarry and SubtractWithBorrow depend on the incoming carry
+        return false;
+    }
+}
+
 void MacroJITx64Impl::Compile_AddImmediate(Macro::Opcode opcode) {
     if (optimizer.skip_dummy_addimmediate) {
         // Games tend to use this as an exit instruction placeholder. It's to encode an instruction
@@ -250,8 +232,14 @@ void MacroJITx64Impl::Compile_AddImmediate(Macro::Opcode opcode) {
         opcode.result_operation == Macro::ResultOperation::MoveAndSetMethod) {
         if (next_opcode.has_value()) {
             const auto next = *next_opcode;
-            if (next.result_operation == Macro::ResultOperation::MoveAndSetMethod &&
-                opcode.dst == next.dst) {
+            // The next instruction must not read the register we are about to drop
+            const bool reads_dst = next.src_a == opcode.dst ||
+                                   (next.operation != Macro::Operation::AddImmediate &&
+                                    next.operation != Macro::Operation::Read &&
+                                    next.src_b == opcode.dst);
+            if (next.operation != Macro::Operation::Branch &&
+                next.result_operation == Macro::ResultOperation::MoveAndSetMethod &&
+                opcode.dst == next.dst && !reads_dst) {
                 return;
             }
         }
@@ -264,7 +252,7 @@ void MacroJITx64Impl::Compile_AddImmediate(Macro::Opcode opcode) {
         }
     } else {
         auto result = Compile_GetRegister(opcode.src_a, RESULT);
-        if (opcode.immediate > 2) {
+        if (opcode.immediate > 1) {
             add(result, opcode.immediate);
         } else if (opcode.immediate == 1) {
             inc(result);
@@ -320,7 +308,7 @@ void MacroJITx64Impl::Compile_Read(Macro::Opcode opcode) {
         }
     } else {
         auto result = Compile_GetRegister(opcode.src_a, RESULT);
-        if (opcode.immediate > 2) {
+        if (opcode.immediate > 1) {
             add(result, opcode.immediate);
         } else if (opcode.immediate == 1) {
             inc(result);
@@ -463,7 +451,7 @@ void MacroJITx64Impl::Compile() {
 
     mov(dword[STATE + offsetof(JITState, registers) + 4], Compile_FetchParameter());
 
-    // Track get register for zero registers and mark it as no-op
+    // Fold operations on the zero register into their known results
     optimizer.zero_reg_skip = true;
 
     // AddImmediate tends to be used as a NOP instruction, if we detect this we can
@@ -368,6 +368,7 @@ inline void MemoryManager::MemoryOperation(GPUVAddr gpu_src_addr, std::size_t si
 template <bool is_safe>
 void MemoryManager::ReadBlockImpl(GPUVAddr gpu_src_addr, void* dest_buffer, std::size_t size,
                                   [[maybe_unused]] VideoCommon::CacheType which) const {
+    const std::span<const u8> read_data(static_cast<const u8*>(dest_buffer), size);
     auto set_to_zero = [&]([[maybe_unused]] std::size_t page_index,
                            [[maybe_unused]] std::size_t offset, std::size_t copy_amount) {
         std::memset(dest_buffer, 0, copy_amount);
@@ -403,6 +404,9 @@ void MemoryManager::ReadBlockImpl(GPUVAddr gpu_src_addr, void* dest_buffer, std:
         MemoryOperation<false>(base, copy_amount, mapped_normal, set_to_zero, set_to_zero);
     };
     MemoryOperation<true>(gpu_src_addr, size, mapped_big, set_to_zero, read_short_pages);
+    if (read_observer) [[unlikely]] {
+        read_observer->OnRead(gpu_src_addr, read_data);
+    }
 }
 
 void MemoryManager::ReadBlock(GPUVAddr gpu_src_addr, void* dest_buffer, std::size_t size,
@@ -767,10 +771,14 @@ const u8* MemoryManager::GetSpan(const GPUVAddr src_addr, const std::size_t size
         return nullptr;
     }
     auto dev_addr = GpuToCpuAddress(src_addr);
-    if (dev_addr) {
-        return memory.GetSpan(*dev_addr, size);
+    if (!dev_addr) {
+        return nullptr;
+    }
+    u8* const span = memory.GetSpan(*dev_addr, size);
+    if (read_observer && span) [[unlikely]] {
+        read_observer->OnRead(src_addr, std::span<const u8>(span, size));
     }
-    return nullptr;
+    return span;
 }
 
 u8* MemoryManager::GetSpan(const GPUVAddr src_addr, const std::size_t size) {
@@ -778,10 +786,14 @@ u8* MemoryManager::GetSpan(const GPUVAddr src_addr, const std::size_t size) {
         return nullptr;
     }
     auto dev_addr = GpuToCpuAddress(src_addr);
-    if (dev_addr) {
-        return memory.GetSpan(*dev_addr, size);
+    if (!dev_addr) {
+        return nullptr;
+    }
+    u8* const span = memory.GetSpan(*dev_addr, size);
+    if (read_observer && span) [[unlikely]] {
+        read_observer->OnRead(src_addr, std::span<const u8>(span, size));
     }
-    return nullptr;
+    return span;
 }
 
 } // namespace Tegra
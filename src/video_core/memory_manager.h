@@ -7,6 +7,7 @@
 #include <map>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <vector>
 #include <boost/container/small_vector.hpp>
 
@@ -33,6 +34,14 @@ class System;
 
 namespace Tegra {
 
+/// Receives the guest memory read through a MemoryManager, on the thread that reads it
+class MemoryReadObserver {
+public:
+    virtual ~MemoryReadObserver() = default;
+
+    virtual void OnRead(GPUVAddr gpu_addr, std::span<const u8> data) = 0;
+};
+
 class MemoryManager final {
 public:
     explicit MemoryManager(Core::System& system_, u64 address_space_bits_ = 40,
@@ -50,6 +59,12 @@ public:
     /// Binds a renderer to the memory manager.
     void BindRasterizer(VideoCore::RasterizerInterface* rasterizer);
 
+    /// Sets the observer told about block and span reads. Read<T> and GetPointer accesses are not
+    /// reported, so their fast paths stay free of it.
+    void SetReadObserver(MemoryReadObserver* observer) {
+        read_observer = observer;
+    }
+
     [[nodiscard]] std::optional<DAddr> GpuToCpuAddress(GPUVAddr addr) const;
 
     [[nodiscard]] std::optional<DAddr> GpuToCpuAddress(GPUVAddr addr, std::size_t size) const;
@@ -207,6 +222,7 @@ private:
     u64 big_page_table_mask;
 
     VideoCore::RasterizerInterface* rasterizer = nullptr;
+    MemoryReadObserver* read_observer = nullptr;
 
     enum class EntryType : u64 {
         Free = 0,
@@ -13,4 +13,13 @@ struct RasterizerDownloadArea {
     bool preemtive;
 };
 
+struct RasterizerDownloadStats {
+    /// Bytes written back to guest memory by asynchronous downloads
+    u64 bytes;
+    /// Number of asynchronous download batches written back
+    u64 batches;
+    /// Average time from the download being committed to it reaching guest memory
+    double average_latency_us;
+};
+
 } // namespace VideoCore
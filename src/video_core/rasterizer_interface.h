@@ -14,6 +14,7 @@
 #include "video_core/gpu.h"
 #include "video_core/query_cache/types.h"
 #include "video_core/rasterizer_download_area.h"
+#include "video_core/texture_cache/types.h"
 
 namespace Tegra {
 class MemoryManager;
@@ -95,6 +96,16 @@ public:
 
     virtual RasterizerDownloadArea GetFlushArea(DAddr addr, u64 size) = 0;
 
+    /// Returns the statistics of the asynchronous downloads of the last frame
+    [[nodiscard]] virtual RasterizerDownloadStats GetDownloadStats() {
+        return {};
+    }
+
+    /// Returns the memory budget statistics of the texture cache and resets its eviction counters
+    [[nodiscard]] virtual VideoCommon::TextureCacheStats GetAndResetTextureCacheStats() {
+        return {};
+    }
+
     /// Notify rasterizer that any caches of the specified region should be invalidated
     virtual void InvalidateRegion(DAddr addr, u64 size,
                                   VideoCommon::CacheType which = VideoCommon::CacheType::All) = 0;
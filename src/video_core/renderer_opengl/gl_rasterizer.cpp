@@ -542,6 +542,15 @@ VideoCore::RasterizerDownloadArea RasterizerOpenGL::GetFlushArea(DAddr addr, u64
     return new_area;
 }
 
+VideoCore::RasterizerDownloadStats RasterizerOpenGL::GetDownloadStats() {
+    return buffer_cache.GetDownloadStats();
+}
+
+VideoCommon::TextureCacheStats RasterizerOpenGL::GetAndResetTextureCacheStats() {
+    std::scoped_lock lock{texture_cache.mutex};
+    return texture_cache.GetAndResetStats();
+}
+
 void RasterizerOpenGL::InvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType which) {
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
     if (addr == 0 || size == 0) {
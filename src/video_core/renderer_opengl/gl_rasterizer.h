@@ -97,6 +97,8 @@ public:
     bool MustFlushRegion(DAddr addr, u64 size,
                          VideoCommon::CacheType which = VideoCommon::CacheType::All) override;
     VideoCore::RasterizerDownloadArea GetFlushArea(PAddr addr, u64 size) override;
+    VideoCore::RasterizerDownloadStats GetDownloadStats() override;
+    VideoCommon::TextureCacheStats GetAndResetTextureCacheStats() override;
     void InvalidateRegion(DAddr addr, u64 size,
                           VideoCommon::CacheType which = VideoCommon::CacheType::All) override;
     void OnCacheInvalidation(PAddr addr, u64 size) override;
@@ -51,8 +51,6 @@ using VideoCommon::LoadPipelines;
 using VideoCommon::SerializePipeline;
 using Context = ShaderContext::Context;
 
-constexpr u32 CACHE_VERSION = 10;
-
 template <typename Container>
 auto MakeSpan(Container& container) {
     return std::span(container.data(), container.size());
@@ -290,12 +288,20 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
             workers->QueueWork(std::move(work));
         }
     }};
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
-        ComputePipelineKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
-        queue_work([this, key, env_ = std::move(env), &state, &callback](Context* ctx) mutable {
-            ctx->pools.ReleaseContents();
-            auto pipeline{CreateComputePipeline(ctx->pools, key, env_, true)};
+    const auto load_compute{[&](const ComputePipelineKey& key,
+                                VideoCommon::PipelineCacheEntry entry) {
+        queue_work([this, key, entry_ = std::move(entry), stop_loading, &state,
+                    &callback](Context* ctx) mutable {
+            // Cancelled loads leave the remaining entries compressed
+            std::vector<FileEnvironment> envs;
+            if (!stop_loading.stop_requested()) {
+                envs = entry_.LoadEnvironments();
+            }
+            std::unique_ptr<ComputePipeline> pipeline;
+            if (!envs.empty()) {
+                ctx->pools.ReleaseContents();
+                pipeline = CreateComputePipeline(ctx->pools, key, envs.front(), true);
+            }
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
                 compute_cache.emplace(key, std::move(pipeline));
@@ -307,16 +313,25 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
-        GraphicsPipelineKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
-        queue_work([this, key, envs_ = std::move(envs), &state, &callback](Context* ctx) mutable {
-            boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
-            for (auto& env : envs_) {
-                env_ptrs.push_back(&env);
+    const auto load_graphics{[&](const GraphicsPipelineKey& key,
+                                 VideoCommon::PipelineCacheEntry entry) {
+        queue_work([this, key, entry_ = std::move(entry), stop_loading, &state,
+                    &callback](Context* ctx) mutable {
+            // Cancelled loads leave the remaining entries compressed
+            std::vector<FileEnvironment> envs;
+            if (!stop_loading.stop_requested()) {
+                envs = entry_.LoadEnvironments();
+            }
+            std::unique_ptr<GraphicsPipeline> pipeline;
+            if (!envs.empty()) {
+                boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
+                for (auto& env : envs) {
+                    env_ptrs.push_back(&env);
+                }
+                ctx->pools.ReleaseContents();
+                pipeline =
+                    CreateGraphicsPipeline(ctx->pools, key, MakeSpan(env_ptrs), false, true);
             }
-            ctx->pools.ReleaseContents();
-            auto pipeline{CreateGraphicsPipeline(ctx->pools, key, MakeSpan(env_ptrs), false, true)};
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
                 graphics_cache.emplace(key, std::move(pipeline));
@@ -328,7 +343,8 @@ void ShaderCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
         });
         ++state.total;
     }};
-    LoadPipelines(stop_loading, shader_cache_filename, CACHE_VERSION, load_compute, load_graphics);
+    LoadPipelines<ComputePipelineKey, GraphicsPipelineKey>(
+        stop_loading, shader_cache_filename, CACHE_VERSION, load_compute, load_graphics);
 
     LOG_INFO(Render_OpenGL, "Total Pipeline Count: {}", state.total);
 
@@ -466,8 +482,9 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
                                        index == static_cast<u32>(Maxwell::ShaderType::Geometry);
         if (key.unique_hashes[index] == 0 && is_emulated_stage) {
             auto topology = MaxwellToOutputTopology(key.gs_input_topology);
-            programs[index] = GenerateGeometryPassthrough(pools.inst, pools.block, host_info,
-                                                          *layer_source_program, topology);
+            programs[index] = GenerateGeometryPassthrough(pools.inst, pools.block, pools.arena,
+                                                          host_info, *layer_source_program,
+                                                          topology);
             continue;
         }
         if (key.unique_hashes[index] == 0) {
@@ -485,14 +502,16 @@ std::unique_ptr<GraphicsPipeline> ShaderCache::CreateGraphicsPipeline(
 
         if (!uses_vertex_a || index != 1) {
             // Normal path
-            programs[index] = TranslateProgram(pools.inst, pools.block, env, cfg, host_info);
+            programs[index] =
+                TranslateProgram(pools.inst, pools.block, pools.arena, env, cfg, host_info);
 
             total_storage_buffers +=
                 Shader::NumDescriptors(programs[index].info.storage_buffers_descriptors);
         } else {
             // VertexB path when VertexA is present.
             auto& program_va{programs[0]};
-            auto program_vb{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+            auto program_vb{
+                TranslateProgram(pools.inst, pools.block, pools.arena, env, cfg, host_info)};
             total_storage_buffers +=
                 Shader::NumDescriptors(program_vb.info.storage_buffers_descriptors);
             programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
@@ -581,7 +600,7 @@ std::unique_ptr<ComputePipeline> ShaderCache::CreateComputePipeline(
         env.Dump(hash, key.unique_hash);
     }
 
-    auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+    auto program{TranslateProgram(pools.inst, pools.block, pools.arena, env, cfg, host_info)};
     const u32 num_storage_buffers{Shader::NumDescriptors(program.info.storage_buffers_descriptors)};
     Shader::RuntimeInfo info;
     info.glasm_use_storage_buffers = num_storage_buffers <= device.GetMaxGLASMStorageBufferBlocks();
@@ -21,6 +21,9 @@ class MemoryManager;
 
 namespace OpenGL {
 
+/// Version of the pipeline cache files written by the OpenGL backend
+constexpr u32 CACHE_VERSION = 10;
+
 class Device;
 class ProgramManager;
 class RasterizerOpenGL;
@@ -5,6 +5,7 @@
 
 #include "core/frontend/emu_window.h"
 #include "core/frontend/graphics_context.h"
+#include "shader_recompiler/arena.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
 
@@ -14,11 +15,13 @@ struct ShaderPools {
         flow_block.ReleaseContents();
         block.ReleaseContents();
         inst.ReleaseContents();
+        arena.Reset();
     }
 
     Shader::ObjectPool<Shader::IR::Inst> inst{8192};
     Shader::ObjectPool<Shader::IR::Block> block{32};
     Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
+    Shader::Arena arena;
 };
 
 struct Context {
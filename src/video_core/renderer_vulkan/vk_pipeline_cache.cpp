@@ -53,7 +53,6 @@ using VideoCommon::FileEnvironment;
 using VideoCommon::GenericEnvironment;
 using VideoCommon::GraphicsEnvironment;
 
-constexpr u32 CACHE_VERSION = 11;
 constexpr std::array<char, 8> VULKAN_CACHE_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'v', 'k', 'c', 'h'};
 
 template <typename Container>
@@ -489,13 +488,25 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     if (device.IsKhrPipelineExecutablePropertiesEnabled()) {
         state.statistics = std::make_unique<PipelineStatistics>(device);
     }
-    const auto load_compute{[&](std::ifstream& file, FileEnvironment env) {
-        ComputePipelineCacheKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
-
-        workers.QueueWork([this, key, env_ = std::move(env), &state, &callback]() mutable {
-            ShaderPools pools;
-            auto pipeline{CreateComputePipeline(pools, key, env_, state.statistics.get(), false)};
+    // Each loader reuses its pools across pipelines, they are freed once loading is done
+    Common::StatefulThreadWorker<ShaderPools> loaders(
+        device.HasBrokenParallelShaderCompiling() ? 1ULL : GetTotalPipelineWorkers(),
+        "VkPipelineLoader", [] { return ShaderPools{}; });
+    const auto load_compute{[&](const ComputePipelineCacheKey& key,
+                                VideoCommon::PipelineCacheEntry entry) {
+        loaders.QueueWork([this, key, entry_ = std::move(entry), stop_loading, &state,
+                           &callback](ShaderPools* pools) mutable {
+            // Cancelled loads leave the remaining entries compressed
+            std::vector<FileEnvironment> envs;
+            if (!stop_loading.stop_requested()) {
+                envs = entry_.LoadEnvironments();
+            }
+            std::unique_ptr<ComputePipeline> pipeline;
+            if (!envs.empty()) {
+                pools->ReleaseContents();
+                pipeline = CreateComputePipeline(*pools, key, envs.front(),
+                                                 state.statistics.get(), false);
+            }
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
                 compute_cache.emplace(key, std::move(pipeline));
@@ -507,10 +518,8 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         });
         ++state.total;
     }};
-    const auto load_graphics{[&](std::ifstream& file, std::vector<FileEnvironment> envs) {
-        GraphicsPipelineCacheKey key;
-        file.read(reinterpret_cast<char*>(&key), sizeof(key));
-
+    const auto load_graphics{[&](const GraphicsPipelineCacheKey& key,
+                                 VideoCommon::PipelineCacheEntry entry) {
         if ((key.state.extended_dynamic_state != 0) !=
                 dynamic_features.has_extended_dynamic_state ||
             (key.state.extended_dynamic_state_2 != 0) !=
@@ -524,15 +533,23 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
             (key.state.dynamic_vertex_input != 0) != dynamic_features.has_dynamic_vertex_input) {
             return;
         }
-        workers.QueueWork([this, key, envs_ = std::move(envs), &state, &callback]() mutable {
-            ShaderPools pools;
-            boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
-            for (auto& env : envs_) {
-                env_ptrs.push_back(&env);
+        loaders.QueueWork([this, key, entry_ = std::move(entry), stop_loading, &state,
+                           &callback](ShaderPools* pools) mutable {
+            // Cancelled loads leave the remaining entries compressed
+            std::vector<FileEnvironment> envs;
+            if (!stop_loading.stop_requested()) {
+                envs = entry_.LoadEnvironments();
+            }
+            std::unique_ptr<GraphicsPipeline> pipeline;
+            if (!envs.empty()) {
+                pools->ReleaseContents();
+                boost::container::static_vector<Shader::Environment*, 5> env_ptrs;
+                for (auto& env : envs) {
+                    env_ptrs.push_back(&env);
+                }
+                pipeline = CreateGraphicsPipeline(*pools, key, MakeSpan(env_ptrs),
+                                                  state.statistics.get(), false);
             }
-            auto pipeline{CreateGraphicsPipeline(pools, key, MakeSpan(env_ptrs),
-                                                 state.statistics.get(), false)};
-
             std::scoped_lock lock{state.mutex};
             if (pipeline) {
                 graphics_cache.emplace(key, std::move(pipeline));
@@ -544,8 +561,8 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
         });
         ++state.total;
     }};
-    VideoCommon::LoadPipelines(stop_loading, pipeline_cache_filename, CACHE_VERSION, load_compute,
-                               load_graphics);
+    VideoCommon::LoadPipelines<ComputePipelineCacheKey, GraphicsPipelineCacheKey>(
+        stop_loading, pipeline_cache_filename, CACHE_VERSION, load_compute, load_graphics);
 
     LOG_INFO(Render_Vulkan, "Total Pipeline Count: {}", state.total);
 
@@ -554,7 +571,7 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     state.has_loaded = true;
     lock.unlock();
 
-    workers.WaitForRequests(stop_loading);
+    loaders.WaitForRequests(stop_loading);
 
     if (use_vulkan_pipeline_cache) {
         SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
@@ -623,8 +640,9 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
                                        index == static_cast<u32>(Maxwell::ShaderType::Geometry);
         if (key.unique_hashes[index] == 0 && is_emulated_stage) {
             auto topology = MaxwellToOutputTopology(key.state.topology);
-            programs[index] = GenerateGeometryPassthrough(pools.inst, pools.block, host_info,
-                                                          *layer_source_program, topology);
+            programs[index] = GenerateGeometryPassthrough(pools.inst, pools.block, pools.arena,
+                                                          host_info, *layer_source_program,
+                                                          topology);
             continue;
         }
         if (key.unique_hashes[index] == 0) {
@@ -637,11 +655,13 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
         Shader::Maxwell::Flow::CFG cfg(env, pools.flow_block, cfg_offset, index == 0);
         if (!uses_vertex_a || index != 1) {
             // Normal path
-            programs[index] = TranslateProgram(pools.inst, pools.block, env, cfg, host_info);
+            programs[index] =
+                TranslateProgram(pools.inst, pools.block, pools.arena, env, cfg, host_info);
         } else {
             // VertexB path when VertexA is present.
             auto& program_va{programs[0]};
-            auto program_vb{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+            auto program_vb{
+                TranslateProgram(pools.inst, pools.block, pools.arena, env, cfg, host_info)};
             programs[index] = MergeDualVertexPrograms(program_va, program_vb, env);
         }
 
@@ -766,7 +786,7 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
         env.Dump(hash, key.unique_hash);
     }
 
-    auto program{TranslateProgram(pools.inst, pools.block, env, cfg, host_info)};
+    auto program{TranslateProgram(pools.inst, pools.block, pools.arena, env, cfg, host_info)};
     const std::vector<u32> code{EmitSPIRV(profile, program)};
     device.SaveShader(code);
     vk::ShaderModule spv_module{BuildShader(device, code)};
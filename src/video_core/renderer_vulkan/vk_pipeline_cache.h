@@ -13,6 +13,7 @@
 
 #include "common/common_types.h"
 #include "common/thread_worker.h"
+#include "shader_recompiler/arena.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
 #include "shader_recompiler/frontend/ir/value.h"
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
@@ -44,6 +45,9 @@ namespace Vulkan {
 
 using Maxwell = Tegra::Engines::Maxwell3D::Regs;
 
+/// Version of the pipeline cache files written by the Vulkan backend
+constexpr u32 CACHE_VERSION = 11;
+
 struct ComputePipelineCacheKey {
     u64 unique_hash;
     u32 shared_memory_size;
@@ -90,11 +94,13 @@ struct ShaderPools {
         flow_block.ReleaseContents();
         block.ReleaseContents();
         inst.ReleaseContents();
+        arena.Reset();
     }
 
     Shader::ObjectPool<Shader::IR::Inst> inst{8192};
     Shader::ObjectPool<Shader::IR::Block> block{32};
     Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
+    Shader::Arena arena;
 };
 
 class PipelineCache : public VideoCommon::ShaderCache {
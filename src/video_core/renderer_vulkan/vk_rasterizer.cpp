@@ -591,6 +591,15 @@ VideoCore::RasterizerDownloadArea RasterizerVulkan::GetFlushArea(DAddr addr, u64
     return new_area;
 }
 
+VideoCore::RasterizerDownloadStats RasterizerVulkan::GetDownloadStats() {
+    return buffer_cache.GetDownloadStats();
+}
+
+VideoCommon::TextureCacheStats RasterizerVulkan::GetAndResetTextureCacheStats() {
+    std::scoped_lock lock{texture_cache.mutex};
+    return texture_cache.GetAndResetStats();
+}
+
 void RasterizerVulkan::InvalidateRegion(DAddr addr, u64 size, VideoCommon::CacheType which) {
     if (addr == 0 || size == 0) {
         return;
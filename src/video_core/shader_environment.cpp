@@ -2,10 +2,14 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <memory>
 #include <optional>
+#include <sstream>
+#include <streambuf>
+#include <unordered_map>
 #include <utility>
 
 #include "common/assert.h"
@@ -16,6 +20,7 @@
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/polyfill_ranges.h"
+#include "common/zstd_compression.h"
 #include "shader_recompiler/environment.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/memory_manager.h"
@@ -25,10 +30,35 @@
 
 namespace VideoCommon {
 
-constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
+/// Magic number of the legacy format, a flat stream of uncompressed pipelines
+constexpr std::array<char, 8> LEGACY_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'c', 'a', 'c', 'h'};
+/// Magic number of the indexed format, a journal of zstd compressed pipeline records
+constexpr std::array<char, 8> MAGIC_NUMBER{'y', 'u', 'z', 'u', 'p', 'c', 'c', 'z'};
+
+constexpr size_t FILE_HEADER_SIZE = MAGIC_NUMBER.size() + sizeof(u32);
+
+/// Header preceding every pipeline record in an indexed pipeline cache file.
+/// The pipeline key follows the header uncompressed, then the compressed environments.
+struct PipelineRecordHeader {
+    u64 key_hash;
+    u32 key_size;
+    u32 num_envs;
+    u32 compressed_size;
+    u32 uncompressed_size;
+    u32 is_compute;
+    u32 checksum;
+};
+static_assert(sizeof(PipelineRecordHeader) == 32);
+static_assert(std::has_unique_object_representations_v<PipelineRecordHeader>);
 
 constexpr size_t INST_SIZE = sizeof(u64);
 
+/// Checksum of the compressed environments of a record, verified before decompressing them
+static u32 RecordChecksum(std::span<const u8> data) {
+    return static_cast<u32>(
+        Common::CityHash64(reinterpret_cast<const char*>(data.data()), data.size()));
+}
+
 using Maxwell = Tegra::Engines::Maxwell3D::Regs;
 
 static u64 MakeCbufKey(u32 index, u32 offset) {
@@ -193,7 +223,7 @@ void GenericEnvironment::Dump(u64 pipeline_hash, u64 shader_hash) {
     DumpImpl(pipeline_hash, shader_hash, code, read_highest, read_lowest, initial_offset, stage);
 }
 
-void GenericEnvironment::Serialize(std::ofstream& file) const {
+void GenericEnvironment::Serialize(std::ostream& file) const {
     const u64 code_size{static_cast<u64>(CachedSizeBytes())};
     const u64 num_texture_types{static_cast<u64>(texture_types.size())};
     const u64 num_texture_pixel_formats{static_cast<u64>(texture_pixel_formats.size())};
@@ -448,7 +478,7 @@ u32 ComputeEnvironment::ReadViewportTransformState() {
     return viewport_transform_state;
 }
 
-void FileEnvironment::Deserialize(std::ifstream& file) {
+void FileEnvironment::Deserialize(std::istream& file) {
     u64 code_size{};
     u64 num_texture_types{};
     u64 num_texture_pixel_formats{};
@@ -582,6 +612,141 @@ std::optional<Shader::ReplaceConstant> FileEnvironment::GetReplaceConstBuffer(u3
     return it->second;
 }
 
+/// Read-only stream buffer over a memory region, avoids copying decompressed data into a string
+class SpanStreamBuffer final : public std::streambuf {
+public:
+    explicit SpanStreamBuffer(std::span<const u8> data) {
+        char* const begin{const_cast<char*>(reinterpret_cast<const char*>(data.data()))};
+        setg(begin, begin, begin + data.size());
+    }
+
+protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which) override {
+        if ((which & std::ios_base::in) == 0) {
+            return pos_type(off_type(-1));
+        }
+        char* const base{dir == std::ios_base::beg   ? eback()
+                         : dir == std::ios_base::cur ? gptr()
+                                                     : egptr()};
+        char* const target{base + off};
+        if (target < eback() || target > egptr()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), target, egptr());
+        return pos_type(target - eback());
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+static void WriteFileHeader(std::ostream& file, u32 cache_version) {
+    file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
+        .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+}
+
+static void WriteRecord(std::ostream& file, std::span<const char> key, u32 num_envs,
+                        bool is_compute, std::span<const char> env_data) {
+    const std::vector<u8> compressed{Common::Compression::CompressDataZSTDDefault(
+        reinterpret_cast<const u8*>(env_data.data()), env_data.size())};
+    if (compressed.empty()) {
+        LOG_ERROR(Common_Filesystem, "Failed to compress pipeline");
+        return;
+    }
+    const PipelineRecordHeader header{
+        .key_hash = Common::CityHash64(key.data(), key.size()),
+        .key_size = static_cast<u32>(key.size()),
+        .num_envs = num_envs,
+        .compressed_size = static_cast<u32>(compressed.size()),
+        .uncompressed_size = static_cast<u32>(env_data.size()),
+        .is_compute = is_compute ? 1U : 0U,
+        .checksum = RecordChecksum(compressed),
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header))
+        .write(key.data(), key.size())
+        .write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+}
+
+/// Reads the next record of a legacy pipeline cache, returns false if it is truncated or invalid
+static bool ReadLegacyRecord(std::ifstream& file, size_t compute_key_size,
+                             size_t graphics_key_size, u32& num_envs, bool& is_compute,
+                             std::vector<char>& env_data, std::vector<char>& key) try {
+    file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
+    if (num_envs == 0) {
+        return false;
+    }
+    const auto envs_begin{file.tellg()};
+    for (u32 index = 0; index < num_envs; ++index) {
+        FileEnvironment env;
+        env.Deserialize(file);
+        if (index == 0) {
+            is_compute = env.ShaderStage() == Shader::Stage::Compute;
+        }
+    }
+    const auto envs_end{file.tellg()};
+    env_data.resize(static_cast<size_t>(envs_end - envs_begin));
+    key.resize(is_compute ? compute_key_size : graphics_key_size);
+    file.seekg(envs_begin).read(env_data.data(), env_data.size()).read(key.data(), key.size());
+    return true;
+
+} catch (const std::exception&) {
+    // Short reads throw through failbit, garbage sizes through the allocations they request
+    return false;
+}
+
+/// Rewrites a legacy pipeline cache file in the indexed format, keeping its contents.
+/// Migration stops at the first truncated or invalid record, the records before it are kept.
+static bool MigrateLegacyPipelineCache(const std::filesystem::path& filename, u32 cache_version,
+                                       size_t compute_key_size, size_t graphics_key_size) try {
+    std::filesystem::path migrated_filename{filename};
+    migrated_filename += ".tmp";
+    {
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        file.exceptions(std::ifstream::failbit);
+        const auto end{file.tellg()};
+        file.seekg(LEGACY_MAGIC_NUMBER.size() + sizeof(u32), std::ios::beg);
+
+        std::ofstream migrated_file(migrated_filename, std::ios::binary | std::ios::trunc);
+        migrated_file.exceptions(std::ofstream::failbit);
+        WriteFileHeader(migrated_file, cache_version);
+
+        std::vector<char> env_data;
+        std::vector<char> key;
+        size_t num_pipelines{};
+        std::streamoff record_begin{file.tellg()};
+        while (record_begin != end) {
+            u32 num_envs{};
+            bool is_compute{};
+            if (!ReadLegacyRecord(file, compute_key_size, graphics_key_size, num_envs,
+                                  is_compute, env_data, key)) {
+                LOG_WARNING(Common_Filesystem,
+                            "Stopped migrating {} at a truncated or invalid pipeline, kept {} "
+                            "pipelines and dropped the last {} bytes",
+                            Common::FS::PathToUTF8String(filename), num_pipelines,
+                            static_cast<std::streamoff>(end) - record_begin);
+                break;
+            }
+            WriteRecord(migrated_file, key, num_envs, is_compute, env_data);
+            ++num_pipelines;
+            record_begin = file.tellg();
+        }
+        LOG_INFO(Common_Filesystem, "Migrated {} pipelines to the indexed pipeline cache format",
+                 num_pipelines);
+    }
+    if (!Common::FS::RemoveFile(filename) || !Common::FS::RenameFile(migrated_filename, filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to replace pipeline cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+        return false;
+    }
+    return true;
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "Failed to migrate pipeline cache: {}", e.what());
+    return false;
+}
+
 void SerializePipeline(std::span<const char> key, std::span<const GenericEnvironment* const> envs,
                        const std::filesystem::path& filename, u32 cache_version) try {
     std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
@@ -592,19 +757,19 @@ void SerializePipeline(std::span<const char> key, std::span<const GenericEnviron
         return;
     }
     if (file.tellp() == 0) {
-        // Write header
-        file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
-            .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+        WriteFileHeader(file, cache_version);
     }
     if (!std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized)) {
         return;
     }
-    const u32 num_envs{static_cast<u32>(envs.size())};
-    file.write(reinterpret_cast<const char*>(&num_envs), sizeof(num_envs));
+    std::ostringstream env_stream(std::ios::binary);
+    env_stream.exceptions(std::ios::failbit);
     for (const GenericEnvironment* const env : envs) {
-        env->Serialize(file);
+        env->Serialize(env_stream);
     }
-    file.write(key.data(), key.size_bytes());
+    const std::string env_data{std::move(env_stream).str()};
+    const bool is_compute{envs.front()->ShaderStage() == Shader::Stage::Compute};
+    WriteRecord(file, key, static_cast<u32>(envs.size()), is_compute, env_data);
 
 } catch (const std::ios_base::failure& e) {
     LOG_ERROR(Common_Filesystem, "{}", e.what());
@@ -614,26 +779,176 @@ void SerializePipeline(std::span<const char> key, std::span<const GenericEnviron
     }
 }
 
-void LoadPipelines(
-    std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics) try {
-    std::ifstream file(filename, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
+PipelineCacheEntry::PipelineCacheEntry(
+    std::shared_ptr<const Common::FS::MappedFile> file_,
+    std::shared_ptr<const std::filesystem::path> writable_filename_, size_t header_offset_,
+    size_t data_offset_, u32 stored_size_, u32 uncompressed_size_, u32 num_envs_, u32 checksum_,
+    bool is_compressed_)
+    : file{std::move(file_)}, writable_filename{std::move(writable_filename_)},
+      header_offset{header_offset_}, data_offset{data_offset_}, stored_size{stored_size_},
+      uncompressed_size{uncompressed_size_}, num_envs{num_envs_}, checksum{checksum_},
+      is_compressed{is_compressed_} {}
+
+std::vector<FileEnvironment> PipelineCacheEntry::LoadEnvironments() const try {
+    std::span<const u8> env_data{file->Data().subspan(data_offset, stored_size)};
+    std::vector<u8> decompressed;
+    if (is_compressed) {
+        if (RecordChecksum(env_data) != checksum) {
+            LOG_ERROR(Common_Filesystem, "Corrupted pipeline in pipeline cache, bad checksum");
+            DropRecord();
+            return {};
+        }
+        decompressed = Common::Compression::DecompressDataZSTD(env_data);
+        if (decompressed.size() != uncompressed_size) {
+            LOG_ERROR(Common_Filesystem, "Corrupted pipeline in pipeline cache");
+            DropRecord();
+            return {};
+        }
+        env_data = decompressed;
+    }
+    SpanStreamBuffer buffer{env_data};
+    std::istream stream{&buffer};
+    stream.exceptions(std::ios::failbit);
+    std::vector<FileEnvironment> envs(num_envs);
+    for (FileEnvironment& env : envs) {
+        env.Deserialize(stream);
+    }
+    return envs;
+
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "Corrupted pipeline in pipeline cache: {}", e.what());
+    DropRecord();
+    return {};
+}
+
+void PipelineCacheEntry::DropRecord() const try {
+    if (!writable_filename) {
         return;
     }
-    file.exceptions(std::ifstream::failbit);
-    const auto end{file.tellg()};
-    file.seekg(0, std::ios::beg);
+    // Records without environments are skipped by LoadPipelines
+    std::fstream stream(*writable_filename, std::ios::binary | std::ios::in | std::ios::out);
+    stream.exceptions(std::ios::failbit);
+    const u32 no_envs{};
+    stream.seekp(header_offset + offsetof(PipelineRecordHeader, num_envs))
+        .write(reinterpret_cast<const char*>(&no_envs), sizeof(no_envs));
 
-    std::array<char, 8> magic_number;
-    u32 cache_version;
-    file.read(magic_number.data(), magic_number.size())
-        .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
-    if (magic_number != MAGIC_NUMBER || cache_version != expected_cache_version) {
-        file.close();
-        if (Common::FS::RemoveFile(filename)) {
-            if (magic_number != MAGIC_NUMBER) {
+} catch (const std::ios_base::failure& e) {
+    LOG_ERROR(Common_Filesystem, "Failed to drop corrupted pipeline: {}", e.what());
+}
+
+/// Pipeline record found while indexing a pipeline cache file
+struct PipelineRecord {
+    size_t header_offset;
+    size_t key_offset;
+    size_t data_offset;
+    PipelineRecordHeader header;
+    bool is_compressed;
+};
+
+/// Walks the records of an indexed pipeline cache file, only the headers are touched.
+/// Returns the offset where the valid records end.
+static size_t IndexPipelineRecords(std::span<const u8> data, size_t compute_key_size,
+                                   size_t graphics_key_size, std::vector<PipelineRecord>& records) {
+    size_t offset{FILE_HEADER_SIZE};
+    while (offset + sizeof(PipelineRecordHeader) <= data.size()) {
+        PipelineRecordHeader header;
+        std::memcpy(&header, data.data() + offset, sizeof(header));
+        const size_t record_size{sizeof(header) + header.key_size + header.compressed_size};
+        if (offset + record_size > data.size()) {
+            break;
+        }
+        const size_t expected_key_size{header.is_compute != 0 ? compute_key_size
+                                                               : graphics_key_size};
+        if (header.key_size == expected_key_size && header.num_envs != 0) {
+            const size_t key_offset{offset + sizeof(header)};
+            records.push_back({
+                .header_offset = offset,
+                .key_offset = key_offset,
+                .data_offset = key_offset + header.key_size,
+                .header = header,
+                .is_compressed = true,
+            });
+        }
+        offset += record_size;
+    }
+    return offset;
+}
+
+/// Walks the pipelines of a legacy pipeline cache file without modifying it.
+/// Legacy records have no size prefix, so their environments are parsed to find where they end.
+static void IndexLegacyPipelineRecords(std::span<const u8> data, size_t compute_key_size,
+                                       size_t graphics_key_size,
+                                       std::vector<PipelineRecord>& records) try {
+    SpanStreamBuffer buffer{data};
+    std::istream stream{&buffer};
+    stream.exceptions(std::ios::failbit);
+    stream.seekg(LEGACY_MAGIC_NUMBER.size() + sizeof(u32), std::ios::beg);
+    while (static_cast<size_t>(stream.tellg()) != data.size()) {
+        u32 num_envs{};
+        stream.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
+        const size_t envs_begin{static_cast<size_t>(stream.tellg())};
+        bool is_compute{};
+        for (u32 index = 0; index < num_envs; ++index) {
+            FileEnvironment env;
+            env.Deserialize(stream);
+            if (index == 0) {
+                is_compute = env.ShaderStage() == Shader::Stage::Compute;
+            }
+        }
+        const size_t key_offset{static_cast<size_t>(stream.tellg())};
+        const size_t key_size{is_compute ? compute_key_size : graphics_key_size};
+        if (num_envs == 0 || key_offset + key_size > data.size()) {
+            break;
+        }
+        const u32 envs_size{static_cast<u32>(key_offset - envs_begin)};
+        records.push_back({
+            .header_offset = 0,
+            .key_offset = key_offset,
+            .data_offset = envs_begin,
+            .header =
+                {
+                    .key_hash = Common::CityHash64(
+                        reinterpret_cast<const char*>(data.data() + key_offset), key_size),
+                    .key_size = static_cast<u32>(key_size),
+                    .num_envs = num_envs,
+                    .compressed_size = envs_size,
+                    .uncompressed_size = envs_size,
+                    .is_compute = is_compute ? 1U : 0U,
+                    .checksum = 0,
+                },
+            .is_compressed = false,
+        });
+        stream.seekg(key_offset + key_size, std::ios::beg);
+    }
+
+} catch (const std::ios_base::failure& e) {
+    LOG_WARNING(Common_Filesystem, "Legacy pipeline cache file is truncated: {}", e.what());
+}
+
+void LoadPipelines(
+    std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
+    size_t compute_key_size, size_t graphics_key_size,
+    Common::UniqueFunction<void, std::span<const char>, PipelineCacheEntry> load_compute,
+    Common::UniqueFunction<void, std::span<const char>, PipelineCacheEntry> load_graphics,
+    PipelineCacheAccess access) {
+    const bool read_only{access == PipelineCacheAccess::ReadOnly};
+    std::array<char, 8> magic_number{};
+    u32 cache_version{};
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            return;
+        }
+        file.read(magic_number.data(), magic_number.size())
+            .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
+    }
+    bool is_legacy{magic_number == LEGACY_MAGIC_NUMBER};
+    if ((magic_number != MAGIC_NUMBER && !is_legacy) || cache_version != expected_cache_version) {
+        if (read_only) {
+            LOG_ERROR(Common_Filesystem, "Skipping invalid or outdated pipeline cache file {}",
+                      Common::FS::PathToUTF8String(filename));
+        } else if (Common::FS::RemoveFile(filename)) {
+            if (magic_number != MAGIC_NUMBER && !is_legacy) {
                 LOG_ERROR(Common_Filesystem, "Invalid pipeline cache file");
             }
             if (cache_version != expected_cache_version) {
@@ -646,29 +961,110 @@ void LoadPipelines(
         }
         return;
     }
-    while (file.tellg() != end) {
+    if (is_legacy && !read_only) {
+        if (!MigrateLegacyPipelineCache(filename, cache_version, compute_key_size,
+                                        graphics_key_size)) {
+            if (!Common::FS::RemoveFile(filename)) {
+                LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
+                          Common::FS::PathToUTF8String(filename));
+            }
+            return;
+        }
+        is_legacy = false;
+    }
+    const auto file{std::make_shared<Common::FS::MappedFile>(filename)};
+    if (!file->IsOpen()) {
+        return;
+    }
+    std::vector<PipelineRecord> records;
+    if (is_legacy) {
+        IndexLegacyPipelineRecords(file->Data(), compute_key_size, graphics_key_size, records);
+    } else {
+        const std::span<const u8> data{file->Data()};
+        const size_t end{
+            IndexPipelineRecords(data, compute_key_size, graphics_key_size, records)};
+        if (end != data.size() && read_only) {
+            LOG_WARNING(Common_Filesystem, "Pipeline cache file is truncated, ignoring {} bytes",
+                        data.size() - end);
+        } else if (end != data.size()) {
+            // Drop the partially written record so new pipelines are appended after valid data
+            LOG_WARNING(Common_Filesystem,
+                        "Pipeline cache file is truncated, discarding {} bytes",
+                        data.size() - end);
+            file->Close();
+            std::error_code ec;
+            std::filesystem::resize_file(filename, end, ec);
+            if (ec) {
+                LOG_ERROR(Common_Filesystem, "Failed to truncate pipeline cache file {}",
+                          Common::FS::PathToUTF8String(filename));
+            }
+            if (!file->Open(filename)) {
+                return;
+            }
+        }
+    }
+    const std::span<const u8> data{file->Data()};
+    const auto key_bytes{[data](const PipelineRecord& record) {
+        return data.subspan(record.key_offset, record.header.key_size);
+    }};
+    // Later records replace earlier records with the same key. Keys are compared in full,
+    // records whose keys only share a hash are kept apart.
+    std::unordered_multimap<u64, size_t> index;
+    for (size_t record_index = 0; record_index < records.size(); ++record_index) {
+        PipelineRecord& record{records[record_index]};
+        const auto [begin, end]{index.equal_range(record.header.key_hash)};
+        const auto it{std::find_if(begin, end, [&](const auto& pair) {
+            const PipelineRecord& other{records[pair.second]};
+            return other.header.is_compute == record.header.is_compute &&
+                   std::ranges::equal(key_bytes(other), key_bytes(record));
+        })};
+        if (it == end) {
+            index.emplace(record.header.key_hash, record_index);
+            continue;
+        }
+        records[it->second].header.num_envs = 0;
+        it->second = record_index;
+    }
+    const auto writable_filename{
+        read_only || is_legacy ? nullptr : std::make_shared<const std::filesystem::path>(filename)};
+    for (const PipelineRecord& record : records) {
         if (stop_loading.stop_requested()) {
             return;
         }
-        u32 num_envs{};
-        file.read(reinterpret_cast<char*>(&num_envs), sizeof(num_envs));
-        std::vector<FileEnvironment> envs(num_envs);
-        for (FileEnvironment& env : envs) {
-            env.Deserialize(file);
+        if (record.header.num_envs == 0) {
+            continue;
         }
-        if (envs.front().ShaderStage() == Shader::Stage::Compute) {
-            load_compute(file, std::move(envs.front()));
+        const char* const key{reinterpret_cast<const char*>(data.data() + record.key_offset)};
+        PipelineCacheEntry entry{file,
+                                 writable_filename,
+                                 record.header_offset,
+                                 record.data_offset,
+                                 record.header.compressed_size,
+                                 record.header.uncompressed_size,
+                                 record.header.num_envs,
+                                 record.header.checksum,
+                                 record.is_compressed};
+        if (record.header.is_compute != 0) {
+            load_compute(std::span(key, record.header.key_size), std::move(entry));
         } else {
-            load_graphics(file, std::move(envs));
+            load_graphics(std::span(key, record.header.key_size), std::move(entry));
         }
     }
+}
 
-} catch (const std::ios_base::failure& e) {
-    LOG_ERROR(Common_Filesystem, "{}", e.what());
-    if (!Common::FS::RemoveFile(filename)) {
-        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
-                  Common::FS::PathToUTF8String(filename));
+std::optional<u32> ReadPipelineCacheVersion(const std::filesystem::path& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    std::array<char, 8> magic_number;
+    u32 cache_version;
+    file.read(magic_number.data(), magic_number.size())
+        .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
+    if (!file || (magic_number != MAGIC_NUMBER && magic_number != LEGACY_MAGIC_NUMBER)) {
+        return std::nullopt;
     }
+    return cache_version;
 }
 
 } // namespace VideoCommon
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <cstring>
 #include <filesystem>
 #include <iosfwd>
 #include <limits>
@@ -15,6 +16,7 @@
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/fs/mapped_file.h"
 #include "common/polyfill_thread.h"
 #include "common/unique_function.h"
 #include "shader_recompiler/environment.h"
@@ -60,7 +62,7 @@ public:
 
     void Dump(u64 pipeline_hash, u64 shader_hash) override;
 
-    void Serialize(std::ofstream& file) const;
+    void Serialize(std::ostream& file) const;
 
     bool HasHLEMacroState() const override {
         return has_hle_engine_state;
@@ -165,7 +167,7 @@ public:
     FileEnvironment& operator=(const FileEnvironment&) = delete;
     FileEnvironment(const FileEnvironment&) = delete;
 
-    void Deserialize(std::ifstream& file);
+    void Deserialize(std::istream& file);
 
     [[nodiscard]] u64 ReadInstruction(u32 address) override;
 
@@ -224,9 +226,77 @@ void SerializePipeline(const Key& key, const Envs& envs, const std::filesystem::
                       std::span(envs.data(), envs.size()), filename, cache_version);
 }
 
+/// Lazily decoded pipeline stored in a pipeline cache file.
+/// The environments are kept compressed in the memory mapped cache file until they are loaded,
+/// so pipelines that are discarded by the backend are never decompressed.
+class PipelineCacheEntry {
+public:
+    explicit PipelineCacheEntry() = default;
+    explicit PipelineCacheEntry(std::shared_ptr<const Common::FS::MappedFile> file_,
+                                std::shared_ptr<const std::filesystem::path> writable_filename_,
+                                size_t header_offset_, size_t data_offset_, u32 stored_size_,
+                                u32 uncompressed_size_, u32 num_envs_, u32 checksum_,
+                                bool is_compressed_);
+
+    /// Decompresses and deserializes the environments of the pipeline.
+    /// Returns an empty vector when the entry is corrupted, the record is then dropped from
+    /// writable cache files so it is not loaded again.
+    [[nodiscard]] std::vector<FileEnvironment> LoadEnvironments() const;
+
+private:
+    void DropRecord() const;
+
+    std::shared_ptr<const Common::FS::MappedFile> file;
+    std::shared_ptr<const std::filesystem::path> writable_filename;
+    size_t header_offset{};
+    size_t data_offset{};
+    u32 stored_size{};
+    u32 uncompressed_size{};
+    u32 num_envs{};
+    u32 checksum{};
+    bool is_compressed{};
+};
+
+/// How LoadPipelines may touch the pipeline cache file.
+enum class PipelineCacheAccess {
+    /// Outdated files are deleted, legacy files migrated and partial records truncated
+    ReadWrite,
+    /// The file is never modified, legacy files are read in place
+    ReadOnly,
+};
+
+void LoadPipelines(
+    std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
+    size_t compute_key_size, size_t graphics_key_size,
+    Common::UniqueFunction<void, std::span<const char>, PipelineCacheEntry> load_compute,
+    Common::UniqueFunction<void, std::span<const char>, PipelineCacheEntry> load_graphics,
+    PipelineCacheAccess access = PipelineCacheAccess::ReadWrite);
+
+template <typename ComputeKey, typename GraphicsKey>
 void LoadPipelines(
     std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
-    Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
-    Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics);
+    Common::UniqueFunction<void, const ComputeKey&, PipelineCacheEntry> load_compute,
+    Common::UniqueFunction<void, const GraphicsKey&, PipelineCacheEntry> load_graphics,
+    PipelineCacheAccess access = PipelineCacheAccess::ReadWrite) {
+    static_assert(std::is_trivially_copyable_v<ComputeKey>);
+    static_assert(std::is_trivially_copyable_v<GraphicsKey>);
+    LoadPipelines(
+        stop_loading, filename, expected_cache_version, sizeof(ComputeKey), sizeof(GraphicsKey),
+        [&load_compute](std::span<const char> key_data, PipelineCacheEntry entry) {
+            ComputeKey key;
+            std::memcpy(&key, key_data.data(), sizeof(key));
+            load_compute(key, std::move(entry));
+        },
+        [&load_graphics](std::span<const char> key_data, PipelineCacheEntry entry) {
+            GraphicsKey key;
+            std::memcpy(&key, key_data.data(), sizeof(key));
+            load_graphics(key, std::move(entry));
+        },
+        access);
+}
+
+/// Reads the cache version of a pipeline cache file without modifying it.
+/// Returns std::nullopt when the file can't be opened or doesn't have a valid header.
+[[nodiscard]] std::optional<u32> ReadPipelineCacheVersion(const std::filesystem::path& filename);
 
 } // namespace VideoCommon
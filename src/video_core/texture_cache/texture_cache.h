@@ -29,7 +29,8 @@ using namespace Common::Literals;
 
 template <class P>
 TextureCache<P>::TextureCache(Runtime& runtime_, Tegra::MaxwellDeviceMemoryManager& device_memory_)
-    : runtime{runtime_}, device_memory{device_memory_} {
+    : runtime{runtime_}, device_memory{device_memory_},
+      astc_decode_cache{size_t{Settings::values.astc_decode_cache_size.GetValue()} * 1_MiB} {
     // Configure null sampler
     TSCEntry sampler_descriptor{};
     sampler_descriptor.min_filter.Assign(Tegra::Texture::TextureFilter::Linear);
@@ -68,6 +69,15 @@ TextureCache<P>::TextureCache(Runtime& runtime_, Tegra::MaxwellDeviceMemoryManag
         critical_memory = DEFAULT_CRITICAL_MEMORY + 1_GiB;
         minimum_memory = 0;
     }
+
+    // A configured budget replaces the thresholds derived from the device
+    const u64 budget = static_cast<u64>(Settings::values.texture_cache_budget.GetValue()) * 1_MiB;
+    if (budget != 0) {
+        critical_memory = budget;
+        expected_memory = budget - budget / 8;
+        minimum_memory = budget / 2;
+        LOG_INFO(HW_GPU, "Texture cache budget set to {} MiB", budget / 1_MiB);
+    }
 }
 
 template <class P>
@@ -80,7 +90,9 @@ void TextureCache<P>::RunGarbageCollector() {
     const auto Configure = [&](bool allow_aggressive) {
         high_priority_mode = total_used_memory >= expected_memory;
         aggressive_mode = allow_aggressive && total_used_memory >= critical_memory;
-        ticks_to_destroy = aggressive_mode ? 10ULL : high_priority_mode ? 25ULL : 50ULL;
+        // Only the aggressive pass reaches into the warm tier. Under high priority the cold tier
+        // is evicted with a larger budget and even when the images have to be downloaded.
+        ticks_to_destroy = aggressive_mode ? HOT_TIER_TICKS : COLD_TIER_TICKS;
         num_iterations = aggressive_mode ? 40 : (high_priority_mode ? 20 : 10);
     };
     const auto Cleanup = [this, &num_iterations, &high_priority_mode,
@@ -111,6 +123,9 @@ void TextureCache<P>::RunGarbageCollector() {
             SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, map.mapped_span,
                          swizzle_data_buffer);
         }
+        ++stats.evictions;
+        stats.evicted_bytes += GetImageMemoryUsage(image);
+        recent_evictions.insert_or_assign(image.gpu_addr, frame_tick);
         if (True(image.flags & ImageFlagBits::Tracked)) {
             UntrackImage(image, image_id);
         }
@@ -130,15 +145,33 @@ void TextureCache<P>::RunGarbageCollector() {
         }
         return false;
     };
+    // Weigh the oldest images by how long they have been unused and how much memory they hold,
+    // a few large stale images are evicted before many small ones.
+    const auto Evict = [&] {
+        const size_t max_candidates = num_iterations * EVICTION_CANDIDATES_PER_ITERATION;
+        eviction_candidates.clear();
+        lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy, [&](ImageId image_id) {
+            const ImageBase& image = slot_images[image_id];
+            const u64 age = frame_tick - lru_cache.GetTick(image.lru_index);
+            eviction_candidates.push_back({image_id, age * GetImageMemoryUsage(image)});
+            return eviction_candidates.size() >= max_candidates;
+        });
+        std::ranges::stable_sort(eviction_candidates, std::greater{}, &EvictionCandidate::weight);
+        for (const EvictionCandidate& candidate : eviction_candidates) {
+            if (Cleanup(candidate.image_id)) {
+                return;
+            }
+        }
+    };
 
     // Try to remove anything old enough and not high priority.
     Configure(false);
-    lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy, Cleanup);
+    Evict();
 
     // If pressure is still too high, prune aggressively.
     if (total_used_memory >= critical_memory) {
         Configure(true);
-        lru_cache.ForEachItemBelow(frame_tick - ticks_to_destroy, Cleanup);
+        Evict();
     }
 }
 
@@ -151,6 +184,20 @@ void TextureCache<P>::TickFrame() {
     if (total_used_memory > minimum_memory) {
         RunGarbageCollector();
     }
+    if (frame_tick % IMAGE_VIEW_PRUNE_TICKS == 0) {
+        // Entries of deleted views are replaced on their next lookup, sweep the ones never
+        // looked up again so the maps do not grow without bound
+        for (TextureCacheImageViewMap& image_views : image_view_map_storage) {
+            std::erase_if(image_views, [this](const auto& pair) {
+                return !IsCachedImageViewAlive(pair.second);
+            });
+        }
+    }
+    if (frame_tick % REUPLOAD_WINDOW_TICKS == 0) {
+        settled_evictions += std::erase_if(recent_evictions, [this](const auto& eviction) {
+            return frame_tick - eviction.second > REUPLOAD_WINDOW_TICKS;
+        });
+    }
     sentenced_images.Tick();
     sentenced_framebuffers.Tick();
     sentenced_image_view.Tick();
@@ -158,6 +205,8 @@ void TextureCache<P>::TickFrame() {
 
     runtime.TickFrame();
     ++frame_tick;
+    // The counter of the frame that just turned cold is reused for the new frame
+    tier_tick_bytes[frame_tick % COLD_TIER_TICKS] = 0;
 
     if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
         for (auto& buffer : async_buffers_death_ring) {
@@ -302,7 +351,7 @@ void TextureCache<P>::SynchronizeGraphicsDescriptors() {
     }
     if (channel_state->graphics_image_table.Synchronize(maxwell3d->regs.tex_header.Address(),
                                                         tic_limit)) {
-        channel_state->graphics_image_view_ids.resize(tic_limit + 1, CORRUPT_ID);
+        channel_state->graphics_image_view_ids.resize(tic_limit + 1, {CORRUPT_ID, 0});
     }
 }
 
@@ -317,7 +366,7 @@ void TextureCache<P>::SynchronizeComputeDescriptors() {
     }
     if (channel_state->compute_image_table.Synchronize(kepler_compute->regs.tic.Address(),
                                                        tic_limit)) {
-        channel_state->compute_image_view_ids.resize(tic_limit + 1, CORRUPT_ID);
+        channel_state->compute_image_view_ids.resize(tic_limit + 1, {CORRUPT_ID, 0});
     }
 }
 
@@ -472,7 +521,7 @@ typename P::Framebuffer* TextureCache<P>::GetFramebuffer() {
 template <class P>
 template <bool has_blacklists>
 void TextureCache<P>::FillImageViews(DescriptorTable<TICEntry>& table,
-                                     std::span<ImageViewId> cached_image_view_ids,
+                                     std::span<CachedImageViewId> cached_image_view_ids,
                                      std::span<ImageViewInOut> views) {
     bool has_blacklisted = false;
     do {
@@ -496,23 +545,44 @@ void TextureCache<P>::FillImageViews(DescriptorTable<TICEntry>& table,
 
 template <class P>
 ImageViewId TextureCache<P>::VisitImageView(DescriptorTable<TICEntry>& table,
-                                            std::span<ImageViewId> cached_image_view_ids,
+                                            std::span<CachedImageViewId> cached_image_view_ids,
                                             u32 index) {
     if (index > table.Limit()) {
         LOG_DEBUG(HW_GPU, "Invalid image view index={}", index);
         return NULL_IMAGE_VIEW_ID;
     }
     const auto [descriptor, is_new] = table.Read(index);
-    ImageViewId& image_view_id = cached_image_view_ids[index];
-    if (is_new) {
-        image_view_id = FindImageView(descriptor);
+    CachedImageViewId& cached = cached_image_view_ids[index];
+    if (is_new || !IsCachedImageViewAlive(cached)) {
+        cached = MakeCachedImageViewId(FindImageView(descriptor));
     }
+    const ImageViewId image_view_id = cached.id;
     if (image_view_id != NULL_IMAGE_VIEW_ID) {
         PrepareImageView(image_view_id, false, false);
     }
     return image_view_id;
 }
 
+template <class P>
+CachedImageViewId TextureCache<P>::MakeCachedImageViewId(ImageViewId id) const noexcept {
+    const u32 generation =
+        id.index < image_view_generations.size() ? image_view_generations[id.index] : 0;
+    return {id, generation};
+}
+
+template <class P>
+bool TextureCache<P>::IsCachedImageViewAlive(CachedImageViewId cached) const noexcept {
+    return MakeCachedImageViewId(cached.id).generation == cached.generation;
+}
+
+template <class P>
+void TextureCache<P>::RetireImageViewId(ImageViewId id) {
+    if (id.index >= image_view_generations.size()) {
+        image_view_generations.resize(id.index + 1);
+    }
+    ++image_view_generations[id.index];
+}
+
 template <class P>
 FramebufferId TextureCache<P>::GetFramebufferId(const RenderTargets& key) {
     const auto [pair, is_new] = framebuffers.try_emplace(key);
@@ -1090,7 +1160,7 @@ void TextureCache<P>::UploadImageContents(Image& image, StagingBuffer& staging)
         unswizzle_data_buffer.resize_destructive(image.unswizzled_size_bytes);
         auto copies =
             UnswizzleImage(*gpu_memory, gpu_addr, image.info, swizzle_data, unswizzle_data_buffer);
-        ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies);
+        ConvertImage(unswizzle_data_buffer, image.info, mapped_span, copies, &astc_decode_cache);
         image.UploadMemory(staging, copies);
     } else {
         const auto copies =
@@ -1104,12 +1174,12 @@ ImageViewId TextureCache<P>::FindImageView(const TICEntry& config) {
     if (!IsValidEntry(*gpu_memory, config)) {
         return NULL_IMAGE_VIEW_ID;
     }
-    const auto [pair, is_new] = channel_state->image_views.try_emplace(config);
-    ImageViewId& image_view_id = pair->second;
-    if (is_new) {
-        image_view_id = CreateImageView(config);
+    const auto [pair, is_new] = channel_state->image_views->try_emplace(config);
+    CachedImageViewId& cached = pair->second;
+    if (is_new || !IsCachedImageViewAlive(cached)) {
+        cached = MakeCachedImageViewId(CreateImageView(config));
     }
-    return image_view_id;
+    return cached.id;
 }
 
 template <class P>
@@ -1243,23 +1313,14 @@ void TextureCache<P>::InvalidateScale(Image& image) {
             render_targets.depth_buffer_id = ImageViewId{};
         }
     }
-    RemoveImageViewReferences(image_view_ids);
     RemoveFramebuffers(image_view_ids);
     for (const ImageViewId image_view_id : image_view_ids) {
         sentenced_image_view.Push(std::move(slot_image_views[image_view_id]));
         slot_image_views.erase(image_view_id);
+        RetireImageViewId(image_view_id);
     }
     image.image_view_ids.clear();
     image.image_view_infos.clear();
-    for (size_t c : active_channel_ids) {
-        auto& channel_info = channel_storage[c];
-        if constexpr (ENABLE_VALIDATION) {
-            std::ranges::fill(channel_info.graphics_image_view_ids, CORRUPT_ID);
-            std::ranges::fill(channel_info.compute_image_view_ids, CORRUPT_ID);
-        }
-        channel_info.graphics_image_table.Invalidate();
-        channel_info.compute_image_table.Invalidate();
-    }
     has_deleted_images = true;
 }
 
@@ -1276,6 +1337,49 @@ u64 TextureCache<P>::GetScaledImageSizeBytes(const ImageBase& image) {
     return fitted_size;
 }
 
+template <class P>
+u64 TextureCache<P>::GetImageSizeBytes(const ImageBase& image) {
+    u64 tentative_size = std::max(image.guest_size_bytes, image.unswizzled_size_bytes);
+    if ((IsPixelFormatASTC(image.info.format) &&
+         True(image.flags & ImageFlagBits::AcceleratedUpload)) ||
+        True(image.flags & ImageFlagBits::Converted)) {
+        tentative_size = TranscodedAstcSize(tentative_size, image.info.format);
+    }
+    return Common::AlignUp(tentative_size, 1024);
+}
+
+template <class P>
+u64 TextureCache<P>::GetImageMemoryUsage(const ImageBase& image) {
+    const u64 size_bytes = GetImageSizeBytes(image);
+    return image.HasScaled() ? size_bytes + GetScaledImageSizeBytes(image) : size_bytes;
+}
+
+template <class P>
+void TextureCache<P>::TouchImage(const ImageBase& image) {
+    const u64 last_tick = lru_cache.GetTick(image.lru_index);
+    if (last_tick >= frame_tick) {
+        return;
+    }
+    const u64 size_bytes = GetImageSizeBytes(image);
+    RemoveTierBytes(last_tick, size_bytes);
+    AddTierBytes(frame_tick, size_bytes);
+    lru_cache.Touch(image.lru_index, frame_tick);
+}
+
+template <class P>
+void TextureCache<P>::AddTierBytes(u64 tick, u64 bytes) {
+    if (frame_tick - tick < COLD_TIER_TICKS) {
+        tier_tick_bytes[tick % COLD_TIER_TICKS] += bytes;
+    }
+}
+
+template <class P>
+void TextureCache<P>::RemoveTierBytes(u64 tick, u64 bytes) {
+    if (frame_tick - tick < COLD_TIER_TICKS) {
+        tier_tick_bytes[tick % COLD_TIER_TICKS] -= bytes;
+    }
+}
+
 template <class P>
 void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id) {
     UNIMPLEMENTED_IF(False(image.flags & ImageFlagBits::Converted));
@@ -1296,12 +1400,12 @@ void TextureCache<P>::QueueAsyncDecode(Image& image, ImageId image_id) {
                                  local_unswizzle_data_buffer);
     const size_t out_size = MapSizeBytes(image);
 
-    auto func = [out_size, copies, info = image.info,
+    auto func = [this, out_size, copies, info = image.info,
                  input = std::move(local_unswizzle_data_buffer),
                  async_decode = decode_ptr]() mutable {
         async_decode->decoded_data.resize_destructive(out_size);
         std::span copies_span{copies.data(), copies.size()};
-        ConvertImage(input, info, async_decode->decoded_data, copies_span);
+        ConvertImage(input, info, async_decode->decoded_data, copies_span, &astc_decode_cache);
 
         // TODO: Do we need this lock?
         std::unique_lock lock{async_decode->mutex};
@@ -1726,8 +1830,7 @@ std::pair<u32, u32> TextureCache<P>::PrepareDmaImage(ImageId dst_id, GPUVAddr ba
     const auto& image = slot_images[dst_id];
     const auto base = image.TryFindBase(base_addr);
     PrepareImage(dst_id, mark_as_modified, false);
-    const auto& new_image = slot_images[dst_id];
-    lru_cache.Touch(new_image.lru_index, frame_tick);
+    TouchImage(slot_images[dst_id]);
     return std::make_pair(base->level, base->layer);
 }
 
@@ -1736,7 +1839,7 @@ SamplerId TextureCache<P>::FindSampler(const TSCEntry& config) {
     if (std::ranges::all_of(config.raw, [](u64 value) { return value == 0; })) {
         return NULL_SAMPLER_ID;
     }
-    const auto [pair, is_new] = channel_state->samplers.try_emplace(config);
+    const auto [pair, is_new] = samplers.try_emplace(config);
     if (is_new) {
         pair->second = slot_samplers.insert(runtime, config);
     }
@@ -1991,14 +2094,22 @@ void TextureCache<P>::RegisterImage(ImageId image_id) {
     ASSERT_MSG(False(image.flags & ImageFlagBits::Registered),
                "Trying to register an already registered image");
     image.flags |= ImageFlagBits::Registered;
-    u64 tentative_size = std::max(image.guest_size_bytes, image.unswizzled_size_bytes);
-    if ((IsPixelFormatASTC(image.info.format) &&
-         True(image.flags & ImageFlagBits::AcceleratedUpload)) ||
-        True(image.flags & ImageFlagBits::Converted)) {
-        tentative_size = TranscodedAstcSize(tentative_size, image.info.format);
-    }
-    total_used_memory += Common::AlignUp(tentative_size, 1024);
+    const u64 size_bytes = GetImageSizeBytes(image);
+    total_used_memory += size_bytes;
+    registered_bytes += size_bytes;
     image.lru_index = lru_cache.Insert(image_id, frame_tick);
+    AddTierBytes(frame_tick, size_bytes);
+
+    // Creating an image the garbage collector recently evicted means it was evicted too early
+    if (const auto it = recent_evictions.find(image.gpu_addr); it != recent_evictions.end()) {
+        if (frame_tick - it->second <= REUPLOAD_WINDOW_TICKS) {
+            ++stats.reuploads;
+            stats.reuploaded_bytes += size_bytes;
+        } else {
+            ++settled_evictions;
+        }
+        recent_evictions.erase(it);
+    }
 
     ForEachGPUPage(image.gpu_addr, image.guest_size_bytes, [this, image_id](u64 page) {
         (*channel_state->gpu_page_table)[page].push_back(image_id);
@@ -2032,6 +2143,9 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
                "Trying to unregister an already registered image");
     image.flags &= ~ImageFlagBits::Registered;
     image.flags &= ~ImageFlagBits::BadOverlap;
+    const u64 size_bytes = GetImageSizeBytes(image);
+    registered_bytes -= size_bytes;
+    RemoveTierBytes(lru_cache.GetTick(image.lru_index), size_bytes);
     lru_cache.Free(image.lru_index);
     const auto& clear_page_table =
         [image_id](u64 page,
@@ -2162,16 +2276,7 @@ void TextureCache<P>::UntrackImage(ImageBase& image, ImageId image_id) {
 template <class P>
 void TextureCache<P>::DeleteImage(ImageId image_id, bool immediate_delete) {
     ImageBase& image = slot_images[image_id];
-    if (image.HasScaled()) {
-        total_used_memory -= GetScaledImageSizeBytes(image);
-    }
-    u64 tentative_size = std::max(image.guest_size_bytes, image.unswizzled_size_bytes);
-    if ((IsPixelFormatASTC(image.info.format) &&
-         True(image.flags & ImageFlagBits::AcceleratedUpload)) ||
-        True(image.flags & ImageFlagBits::Converted)) {
-        tentative_size = TranscodedAstcSize(tentative_size, image.info.format);
-    }
-    total_used_memory -= Common::AlignUp(tentative_size, 1024);
+    total_used_memory -= GetImageMemoryUsage(image);
     const GPUVAddr gpu_addr = image.gpu_addr;
     const auto alloc_it = image_allocs_table.find(gpu_addr);
     if (alloc_it == image_allocs_table.end()) {
@@ -2203,7 +2308,6 @@ void TextureCache<P>::DeleteImage(ImageId image_id, bool immediate_delete) {
             render_targets.depth_buffer_id = ImageViewId{};
         }
     }
-    RemoveImageViewReferences(image_view_ids);
     RemoveFramebuffers(image_view_ids);
 
     for (const AliasedImage& alias : image.aliased_images) {
@@ -2230,6 +2334,7 @@ void TextureCache<P>::DeleteImage(ImageId image_id, bool immediate_delete) {
             sentenced_image_view.Push(std::move(slot_image_views[image_view_id]));
         }
         slot_image_views.erase(image_view_id);
+        RetireImageViewId(image_view_id);
     }
     if (!immediate_delete) {
         sentenced_images.Push(std::move(slot_images[image_id]));
@@ -2240,34 +2345,9 @@ void TextureCache<P>::DeleteImage(ImageId image_id, bool immediate_delete) {
     if (alloc_images.empty()) {
         image_allocs_table.erase(alloc_it);
     }
-    for (size_t c : active_channel_ids) {
-        auto& channel_info = channel_storage[c];
-        if constexpr (ENABLE_VALIDATION) {
-            std::ranges::fill(channel_info.graphics_image_view_ids, CORRUPT_ID);
-            std::ranges::fill(channel_info.compute_image_view_ids, CORRUPT_ID);
-        }
-        channel_info.graphics_image_table.Invalidate();
-        channel_info.compute_image_table.Invalidate();
-    }
     has_deleted_images = true;
 }
 
-template <class P>
-void TextureCache<P>::RemoveImageViewReferences(std::span<const ImageViewId> removed_views) {
-    for (size_t c : active_channel_ids) {
-        auto& channel_info = channel_storage[c];
-        auto it = channel_info.image_views.begin();
-        while (it != channel_info.image_views.end()) {
-            const auto found = std::ranges::find(removed_views, it->second);
-            if (found != removed_views.end()) {
-                it = channel_info.image_views.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
-}
-
 template <class P>
 void TextureCache<P>::RemoveFramebuffers(std::span<const ImageViewId> removed_views) {
     auto it = framebuffers.begin();
@@ -2357,7 +2437,33 @@ void TextureCache<P>::PrepareImage(ImageId image_id, bool is_modification, bool
     if (is_modification) {
         MarkModification(image);
     }
-    lru_cache.Touch(image.lru_index, frame_tick);
+    TouchImage(image);
+}
+
+template <class P>
+TextureCacheStats TextureCache<P>::GetAndResetStats() {
+    TextureCacheStats result = stats;
+    result.budget = critical_memory;
+    result.used_memory = total_used_memory;
+    u64 hot_bytes = 0;
+    u64 warm_bytes = 0;
+    for (u64 unused_ticks = 0; unused_ticks < std::min(COLD_TIER_TICKS, frame_tick + 1);
+         ++unused_ticks) {
+        const u64 bytes = tier_tick_bytes[(frame_tick - unused_ticks) % COLD_TIER_TICKS];
+        (unused_ticks < HOT_TIER_TICKS ? hot_bytes : warm_bytes) += bytes;
+    }
+    result.tier_bytes[static_cast<size_t>(ImageTier::Hot)] = hot_bytes;
+    result.tier_bytes[static_cast<size_t>(ImageTier::Warm)] = warm_bytes;
+    result.tier_bytes[static_cast<size_t>(ImageTier::Cold)] =
+        registered_bytes - hot_bytes - warm_bytes;
+    const u64 resolved_evictions = stats.reuploads + settled_evictions;
+    if (resolved_evictions != 0) {
+        result.thrash_rate =
+            static_cast<double>(stats.reuploads) / static_cast<double>(resolved_evictions);
+    }
+    stats = {};
+    settled_evictions = 0;
+    return result;
 }
 
 template <class P>
@@ -2533,6 +2639,7 @@ void TextureCache<P>::CreateChannel(struct Tegra::Control::ChannelState& channel
     const auto it = channel_map.find(channel.bind_id);
     auto* this_state = &channel_storage[it->second];
     const auto& this_as_ref = address_spaces[channel.memory_manager->GetID()];
+    this_state->image_views = &image_view_map_storage[this_as_ref.storage_id];
     this_state->gpu_page_table = &gpu_page_table_storage[this_as_ref.storage_id * 2];
     this_state->sparse_page_table = &gpu_page_table_storage[this_as_ref.storage_id * 2 + 1];
 }
@@ -2542,6 +2649,7 @@ template <class P>
 void TextureCache<P>::OnGPUASRegister([[maybe_unused]] size_t map_id) {
     gpu_page_table_storage.emplace_back();
     gpu_page_table_storage.emplace_back();
+    image_view_map_storage.emplace_back();
 }
 
 } // namespace VideoCommon
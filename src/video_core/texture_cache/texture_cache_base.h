@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <limits>
@@ -34,6 +35,7 @@
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/texture_cache/render_targets.h"
 #include "video_core/texture_cache/types.h"
+#include "video_core/textures/decode_cache.h"
 #include "video_core/textures/texture.h"
 
 namespace Tegra {
@@ -65,6 +67,15 @@ struct AsyncDecodeContext {
 
 using TextureCacheGPUMap = std::unordered_map<u64, std::vector<ImageId>, Common::IdentityHash<u64>>;
 
+/// Image view resolved from a descriptor, it becomes stale when the generation of its slot changes
+struct CachedImageViewId {
+    ImageViewId id;
+    u32 generation;
+};
+
+/// Interned image views of an address space, indexed by the contents of their descriptor
+using TextureCacheImageViewMap = std::unordered_map<TICEntry, CachedImageViewId>;
+
 class TextureCacheChannelInfo : public ChannelInfo {
 public:
     TextureCacheChannelInfo() = delete;
@@ -75,16 +86,14 @@ public:
     DescriptorTable<TICEntry> graphics_image_table{gpu_memory};
     DescriptorTable<TSCEntry> graphics_sampler_table{gpu_memory};
     std::vector<SamplerId> graphics_sampler_ids;
-    std::vector<ImageViewId> graphics_image_view_ids;
+    std::vector<CachedImageViewId> graphics_image_view_ids;
 
     DescriptorTable<TICEntry> compute_image_table{gpu_memory};
     DescriptorTable<TSCEntry> compute_sampler_table{gpu_memory};
     std::vector<SamplerId> compute_sampler_ids;
-    std::vector<ImageViewId> compute_image_view_ids;
-
-    std::unordered_map<TICEntry, ImageViewId> image_views;
-    std::unordered_map<TSCEntry, SamplerId> samplers;
+    std::vector<CachedImageViewId> compute_image_view_ids;
 
+    TextureCacheImageViewMap* image_views;
     TextureCacheGPUMap* gpu_page_table;
     TextureCacheGPUMap* sparse_page_table;
 };
@@ -111,6 +120,16 @@ class TextureCache : public VideoCommon::ChannelSetupCaches<TextureCacheChannelI
     static constexpr s64 DEFAULT_EXPECTED_MEMORY = 1_GiB + 125_MiB;
     static constexpr s64 DEFAULT_CRITICAL_MEMORY = 1_GiB + 625_MiB;
     static constexpr size_t GC_EMERGENCY_COUNTS = 2;
+    /// Frames an image can go unused before it leaves the hot tier
+    static constexpr u64 HOT_TIER_TICKS = 10;
+    /// Frames an image can go unused before it sinks to the cold tier
+    static constexpr u64 COLD_TIER_TICKS = 50;
+    /// Frames after an eviction in which creating the image again counts as a re-upload
+    static constexpr u64 REUPLOAD_WINDOW_TICKS = 120;
+    /// Images from the LRU list weighed against each other per garbage collector iteration
+    static constexpr size_t EVICTION_CANDIDATES_PER_ITERATION = 4;
+    /// Frames between sweeps of the stale entries of the interned image view maps
+    static constexpr u64 IMAGE_VIEW_PRUNE_TICKS = 256;
 
     using Runtime = typename P::Runtime;
     using Image = typename P::Image;
@@ -250,6 +269,9 @@ public:
     /// Prepare an image to be used
     void PrepareImage(ImageId image_id, bool is_modification, bool invalidate);
 
+    /// Return the memory budget statistics and reset the eviction counters
+    [[nodiscard]] TextureCacheStats GetAndResetStats();
+
     std::recursive_mutex mutex;
 
 private:
@@ -292,12 +314,21 @@ private:
     /// Fills image_view_ids in the image views in indices
     template <bool has_blacklists>
     void FillImageViews(DescriptorTable<TICEntry>& table,
-                        std::span<ImageViewId> cached_image_view_ids,
+                        std::span<CachedImageViewId> cached_image_view_ids,
                         std::span<ImageViewInOut> views);
 
     /// Find or create an image view in the guest descriptor table
     ImageViewId VisitImageView(DescriptorTable<TICEntry>& table,
-                               std::span<ImageViewId> cached_image_view_ids, u32 index);
+                               std::span<CachedImageViewId> cached_image_view_ids, u32 index);
+
+    /// Tag an image view id with the current generation of its slot
+    [[nodiscard]] CachedImageViewId MakeCachedImageViewId(ImageViewId id) const noexcept;
+
+    /// Return true when the slot of a cached image view has not been freed since it was cached
+    [[nodiscard]] bool IsCachedImageViewAlive(CachedImageViewId cached) const noexcept;
+
+    /// Bump the generation of an image view slot, making every cached reference to it stale
+    void RetireImageViewId(ImageViewId id);
 
     /// Find or create a framebuffer with the given render target parameters
     FramebufferId GetFramebufferId(const RenderTargets& key);
@@ -382,9 +413,6 @@ private:
     /// Delete image from the cache
     void DeleteImage(ImageId image, bool immediate_delete = false);
 
-    /// Remove image views references from the cache
-    void RemoveImageViewReferences(std::span<const ImageViewId> removed_views);
-
     /// Remove framebuffers using the given image views from the cache
     void RemoveFramebuffers(std::span<const ImageViewId> removed_views);
 
@@ -419,6 +447,19 @@ private:
     bool ScaleDown(Image& image);
     u64 GetScaledImageSizeBytes(const ImageBase& image);
 
+    /// Size accounted for an image in the memory usage, without its rescaled copy
+    u64 GetImageSizeBytes(const ImageBase& image);
+
+    /// Size accounted for an image in the memory usage, including its rescaled copy
+    u64 GetImageMemoryUsage(const ImageBase& image);
+
+    /// Marks a registered image as used in the current frame
+    void TouchImage(const ImageBase& image);
+
+    /// Moves the bytes of an image in or out of the tier counter of the frame it was last used in
+    void AddTierBytes(u64 tick, u64 bytes);
+    void RemoveTierBytes(u64 tick, u64 bytes);
+
     void QueueAsyncDecode(Image& image, ImageId image_id);
     void TickAsyncDecode();
 
@@ -426,6 +467,10 @@ private:
 
     Tegra::MaxwellDeviceMemoryManager& device_memory;
     std::deque<TextureCacheGPUMap> gpu_page_table_storage;
+    std::deque<TextureCacheImageViewMap> image_view_map_storage;
+
+    std::unordered_map<TSCEntry, SamplerId> samplers;
+    std::vector<u32> image_view_generations;
 
     RenderTargets render_targets;
 
@@ -476,6 +521,20 @@ private:
     };
     Common::LeastRecentlyUsedCache<LRUItemParams> lru_cache;
 
+    struct EvictionCandidate {
+        ImageId image_id;
+        u64 weight;
+    };
+    std::vector<EvictionCandidate> eviction_candidates;
+    std::unordered_map<GPUVAddr, u64> recent_evictions;
+    TextureCacheStats stats{};
+    u64 settled_evictions = 0;
+
+    /// Bytes of the registered images by the frame they were last used in, for the frames that
+    /// are still hot or warm. Images unused for longer only count towards registered_bytes.
+    std::array<u64, COLD_TIER_TICKS> tier_tick_bytes{};
+    u64 registered_bytes = 0;
+
     static constexpr size_t TICKS_TO_DESTROY = 8;
     DelayedDestructionRing<Image, TICKS_TO_DESTROY> sentenced_images;
     DelayedDestructionRing<ImageView, TICKS_TO_DESTROY> sentenced_image_view;
@@ -483,6 +542,9 @@ private:
 
     std::unordered_map<GPUVAddr, ImageAllocId> image_allocs_table;
 
+    /// Decoded ASTC textures, declared before the decode worker which may still be using it
+    Tegra::Texture::DecodeCache astc_decode_cache;
+
     Common::ScratchBuffer<u8> swizzle_data_buffer;
     Common::ScratchBuffer<u8> unswizzle_data_buffer;
 
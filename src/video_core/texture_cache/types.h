@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/slot_vector.h"
@@ -152,4 +154,29 @@ struct SwizzleParameters {
     s32 level;
 };
 
+/// Recency tiers of the images in the texture cache, unused images sink to colder tiers
+enum class ImageTier : u32 {
+    Hot,  ///< Used in the last few frames, never evicted
+    Warm, ///< Only evicted under memory pressure
+    Cold, ///< Evicted whenever the garbage collector runs
+};
+constexpr size_t NUM_IMAGE_TIERS = 3;
+
+struct TextureCacheStats {
+    /// Memory usage above which the garbage collector evicts aggressively
+    u64 budget;
+    /// Memory used by the cache when the stats were queried
+    u64 used_memory;
+    /// Bytes held by the registered images of each tier, without their rescaled copies
+    std::array<u64, NUM_IMAGE_TIERS> tier_bytes;
+    /// Images evicted by the garbage collector
+    u64 evictions;
+    u64 evicted_bytes;
+    /// Evicted images that had to be created and uploaded again shortly after
+    u64 reuploads;
+    u64 reuploaded_bytes;
+    /// Fraction of the settled evictions that ended up being uploaded again
+    double thrash_rate;
+};
+
 } // namespace VideoCommon
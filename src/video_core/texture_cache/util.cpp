@@ -18,6 +18,7 @@
 #include "common/bit_util.h"
 #include "common/common_types.h"
 #include "common/div_ceil.h"
+#include "common/literals.h"
 #include "common/scratch_buffer.h"
 #include "common/settings.h"
 #include "video_core/compatible_formats.h"
@@ -33,6 +34,7 @@
 #include "video_core/textures/astc.h"
 #include "video_core/textures/bcn.h"
 #include "video_core/textures/decoders.h"
+#include "video_core/textures/workers.h"
 
 namespace VideoCommon {
 
@@ -61,6 +63,13 @@ using VideoCore::Surface::IsViewCompatible;
 using VideoCore::Surface::PixelFormatFromDepthFormat;
 using VideoCore::Surface::PixelFormatFromRenderTargetFormat;
 using VideoCore::Surface::SurfaceType;
+using namespace Common::Literals;
+
+/// Unswizzles of images smaller than this are done on the caller, waking up the workers would take
+/// longer than unswizzling them
+constexpr size_t MIN_PARALLEL_UNSWIZZLE_BYTES = 1_MiB;
+/// Approximate amount of host memory written by each job queued to the texture workers
+constexpr size_t UNSWIZZLE_BAND_BYTES = 256_KiB;
 
 struct LevelInfo {
     Extent3D size;
@@ -566,6 +575,43 @@ void SwizzleBlockLinearImage(Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr
     ASSERT(host_offset - copy.buffer_offset == copy.buffer_size);
 }
 
+/// Splits a block linear surface in bands of whole blocks that can be unswizzled independently.
+/// 2D surfaces are split in rows of blocks and 3D surfaces in slices of blocks.
+/// func is called with the host offset, the guest offset and the size in tiles of each band.
+template <typename Func>
+void ForEachUnswizzleBand(u32 bpp_log2, Extent3D num_tiles, Extent3D block, u32 stride_alignment,
+                          Func&& func) {
+    const u32 stride = Common::AlignUpLog2(num_tiles.width, stride_alignment) << bpp_log2;
+    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
+    const size_t block_size = static_cast<size_t>(gobs_in_x)
+                              << (GOB_SIZE_SHIFT + block.height + block.depth);
+    const size_t pitch = static_cast<size_t>(num_tiles.width) << bpp_log2;
+
+    if (num_tiles.depth == 1) {
+        const u32 lines_per_block = GOB_SIZE_Y << block.height;
+        const size_t blocks_per_band =
+            std::max<size_t>(UNSWIZZLE_BAND_BYTES / (pitch * lines_per_block), 1);
+        const u32 lines_per_band = static_cast<u32>(blocks_per_band) * lines_per_block;
+        for (u32 line = 0; line < num_tiles.height; line += lines_per_band) {
+            const u32 num_lines = std::min(lines_per_band, num_tiles.height - line);
+            func(line * pitch, (line / lines_per_block) * block_size,
+                 Extent3D{num_tiles.width, num_lines, 1});
+        }
+        return;
+    }
+    const size_t slice_size =
+        Common::DivCeilLog2(num_tiles.height, block.height + GOB_SIZE_Y_SHIFT) * block_size;
+    const u32 slices_per_block = 1U << block.depth;
+    const size_t blocks_per_band = std::max<size_t>(
+        UNSWIZZLE_BAND_BYTES / (pitch * num_tiles.height * slices_per_block), 1);
+    const u32 slices_per_band = static_cast<u32>(blocks_per_band) * slices_per_block;
+    for (u32 slice = 0; slice < num_tiles.depth; slice += slices_per_band) {
+        const u32 num_slices = std::min(slices_per_band, num_tiles.depth - slice);
+        func(slice * pitch * num_tiles.height, (slice / slices_per_block) * slice_size,
+             Extent3D{num_tiles.width, num_tiles.height, num_slices});
+    }
+}
+
 } // Anonymous namespace
 
 u32 CalculateGuestSizeInBytes(const ImageInfo& info) noexcept {
@@ -873,6 +919,15 @@ boost::container::small_vector<BufferImageCopy, 16> UnswizzleImage(Tegra::Memory
     u32 host_offset = 0;
     boost::container::small_vector<BufferImageCopy, 16> copies(num_levels);
 
+    // Large images are split in bands across the texture workers, all of them write straight to
+    // the output and the caller only waits once every level and layer has been queued
+    const bool is_parallel = guest_size_bytes >= MIN_PARALLEL_UNSWIZZLE_BYTES &&
+                             Tegra::Texture::GetNumThreadWorkers() > 1;
+    std::optional<Tegra::Texture::JobGroup> jobs;
+    if (is_parallel) {
+        jobs.emplace();
+    }
+
     for (s32 level = 0; level < num_levels; ++level) {
         const Extent3D level_size = AdjustMipSize(size, level);
         const u32 num_blocks_per_layer = NumBlocks(level_size, tile_size);
@@ -900,18 +955,35 @@ boost::container::small_vector<BufferImageCopy, 16> UnswizzleImage(Tegra::Memory
         for (s32 layer = 0; layer < info.resources.layers; ++layer) {
             const std::span<u8> dst = output.subspan(host_offset);
             const std::span<const u8> src = input.subspan(guest_offset + guest_layer_offset);
-            UnswizzleTexture(dst, src, 1U << bpp_log2, num_tiles.width, num_tiles.height,
-                             num_tiles.depth, block.height, block.depth, stride_alignment);
+            if (jobs) {
+                ForEachUnswizzleBand(
+                    bpp_log2, num_tiles, block, stride_alignment,
+                    [&](size_t band_host_offset, size_t band_guest_offset, Extent3D band_tiles) {
+                        jobs->Queue([dst = dst.subspan(band_host_offset),
+                                     src = src.subspan(band_guest_offset), bpp_log2, band_tiles,
+                                     block, stride_alignment] {
+                            UnswizzleTexture(dst, src, 1U << bpp_log2, band_tiles.width,
+                                             band_tiles.height, band_tiles.depth, block.height,
+                                             block.depth, stride_alignment);
+                        });
+                    });
+            } else {
+                UnswizzleTexture(dst, src, 1U << bpp_log2, num_tiles.width, num_tiles.height,
+                                 num_tiles.depth, block.height, block.depth, stride_alignment);
+            }
             guest_layer_offset += layer_stride;
             host_offset += host_bytes_per_layer;
         }
         guest_offset += level_sizes[level];
     }
+    if (jobs) {
+        jobs->Wait();
+    }
     return copies;
 }
 
 void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies) {
+                  std::span<BufferImageCopy> copies, Tegra::Texture::DecodeCache* decode_cache) {
     u32 output_offset = 0;
     Common::ScratchBuffer<u8> decode_scratch;
 
@@ -935,7 +1007,7 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
             Tegra::Texture::ASTC::Decompress(
                 input_offset, copy.image_extent.width, copy.image_extent.height,
                 copy.image_subresource.num_layers * copy.image_extent.depth, tile_size.width,
-                tile_size.height, output.subspan(output_offset));
+                tile_size.height, output.subspan(output_offset), decode_cache);
 
             output_offset += copy.image_extent.width * copy.image_extent.height *
                              copy.image_subresource.num_layers *
@@ -957,7 +1029,7 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
             Tegra::Texture::ASTC::Decompress(
                 input_offset, copy.image_extent.width, copy.image_extent.height,
                 copy.image_subresource.num_layers * copy.image_extent.depth, tile_size.width,
-                tile_size.height, decode_scratch);
+                tile_size.height, decode_scratch, decode_cache);
 
             compress(decode_scratch, copy.image_extent.width, copy.image_extent.height,
                      copy.image_subresource.num_layers * copy.image_extent.depth,
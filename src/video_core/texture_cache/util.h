@@ -15,6 +15,10 @@
 #include "video_core/texture_cache/types.h"
 #include "video_core/textures/texture.h"
 
+namespace Tegra::Texture {
+class DecodeCache;
+}
+
 namespace VideoCommon {
 
 using Tegra::Texture::TICEntry;
@@ -67,7 +71,8 @@ struct OverlapResult {
     std::span<const u8> input, std::span<u8> output);
 
 void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies);
+                  std::span<BufferImageCopy> copies,
+                  Tegra::Texture::DecodeCache* decode_cache = nullptr);
 
 [[nodiscard]] boost::container::small_vector<BufferImageCopy, 16> FullDownloadCopies(
     const ImageInfo& info);
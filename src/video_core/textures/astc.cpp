@@ -14,9 +14,11 @@
 #include <boost/container/static_vector.hpp>
 
 #include "common/alignment.h"
+#include "common/cityhash.h"
 #include "common/common_types.h"
 #include "common/polyfill_ranges.h"
 #include "video_core/textures/astc.h"
+#include "video_core/textures/decode_cache.h"
 #include "video_core/textures/workers.h"
 
 class InputBitStream {
@@ -215,6 +217,11 @@ static constexpr std::array<IntegerEncodedValue, 256> MakeEncodedValues() {
 static constexpr std::array<IntegerEncodedValue, 256> ASTC_ENCODINGS_VALUES = MakeEncodedValues();
 
 namespace Tegra::Texture::ASTC {
+/// Minimum number of blocks worth queueing on the texture workers
+static constexpr u32 MIN_BLOCKS_PER_JOB = 256;
+/// Jobs queued per worker thread, allows balancing between slower and faster rows
+static constexpr u32 JOBS_PER_WORKER = 4;
+
 using IntegerEncodedVector = boost::container::static_vector<
     IntegerEncodedValue, 256,
     boost::container::static_vector_options<
@@ -1651,42 +1658,88 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
         }
 }
 
+static void DecompressBlockRow(std::span<const u8> data, u32 width, u32 height, u32 block_width,
+                               u32 block_height, u32 rows, u32 cols, u32 row,
+                               std::span<u8> output) {
+    const u32 z = row / rows;
+    const u32 y_index = row % rows;
+    const u32 depth_offset = z * height * width * 4;
+    const u32 y = y_index * block_height;
+    for (u32 x_index = 0; x_index < cols; ++x_index) {
+        const u32 block_index = (row * cols) + x_index;
+        const u32 x = x_index * block_width;
+
+        const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
+
+        // Blocks can be at most 12x12
+        std::array<u32, 12 * 12> uncompData;
+        DecompressBlock(blockPtr, block_width, block_height, uncompData);
+
+        u32 decompWidth = std::min(block_width, width - x);
+        u32 decompHeight = std::min(block_height, height - y);
+
+        const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
+        for (u32 h = 0; h < decompHeight; ++h) {
+            std::memcpy(outRow.data() + h * width * 4, uncompData.data() + h * block_width,
+                        decompWidth * 4);
+        }
+    }
+}
+
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
-                uint32_t block_width, uint32_t block_height, std::span<uint8_t> output) {
+                uint32_t block_width, uint32_t block_height, std::span<uint8_t> output,
+                DecodeCache* decode_cache) {
     const u32 rows = Common::DivideUp(height, block_height);
     const u32 cols = Common::DivideUp(width, block_width);
+    const u32 total_rows = rows * depth;
+
+    const std::span<const u8> blocks{data.first(size_t{total_rows} * cols * 16)};
+    const std::span<u8> decoded{output.first(size_t{width} * height * depth * 4)};
+    DecodeKey key{};
+    if (decode_cache) {
+        key = {
+            .hash = Common::CityHash64(reinterpret_cast<const char*>(blocks.data()), blocks.size()),
+            .size = blocks.size(),
+            .width = width,
+            .height = height,
+            .depth = depth,
+            .block_width = block_width,
+            .block_height = block_height,
+        };
+        if (decode_cache->Lookup(key, blocks, decoded)) {
+            return;
+        }
+    }
 
-    Common::ThreadWorker& workers{GetThreadWorkers()};
-
-    for (u32 z = 0; z < depth; ++z) {
-        const u32 depth_offset = z * height * width * 4;
-        for (u32 y_index = 0; y_index < rows; ++y_index) {
-            auto decompress_stride = [data, width, height, block_width, block_height, output, rows,
-                                      cols, z, depth_offset, y_index] {
-                const u32 y = y_index * block_height;
-                for (u32 x_index = 0; x_index < cols; ++x_index) {
-                    const u32 block_index = (z * rows * cols) + (y_index * cols) + x_index;
-                    const u32 x = x_index * block_width;
-
-                    const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
-
-                    // Blocks can be at most 12x12
-                    std::array<u32, 12 * 12> uncompData;
-                    DecompressBlock(blockPtr, block_width, block_height, uncompData);
-
-                    u32 decompWidth = std::min(block_width, width - x);
-                    u32 decompHeight = std::min(block_height, height - y);
-
-                    const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
-                    for (u32 h = 0; h < decompHeight; ++h) {
-                        std::memcpy(outRow.data() + h * width * 4,
-                                    uncompData.data() + h * block_width, decompWidth * 4);
-                    }
+    // Split the block rows of every slice in a few jobs per worker, small textures are decoded
+    // on the caller as waking up the workers would take longer than decoding them
+    const u32 total_blocks = total_rows * cols;
+    if (total_blocks < MIN_BLOCKS_PER_JOB * 2) {
+        for (u32 row = 0; row < total_rows; ++row) {
+            DecompressBlockRow(blocks, width, height, block_width, block_height, rows, cols, row,
+                               decoded);
+        }
+    } else {
+        const u32 num_jobs = static_cast<u32>(GetNumThreadWorkers()) * JOBS_PER_WORKER;
+        const u32 rows_per_job = std::max(Common::DivideUp(total_rows, num_jobs),
+                                          Common::DivideUp(MIN_BLOCKS_PER_JOB, cols));
+
+        JobGroup jobs;
+        for (u32 first_row = 0; first_row < total_rows; first_row += rows_per_job) {
+            const u32 last_row = std::min(first_row + rows_per_job, total_rows);
+            jobs.Queue([blocks, width, height, block_width, block_height, rows, cols, first_row,
+                        last_row, decoded] {
+                for (u32 row = first_row; row < last_row; ++row) {
+                    DecompressBlockRow(blocks, width, height, block_width, block_height, rows,
+                                       cols, row, decoded);
                 }
-            };
-            workers.QueueWork(std::move(decompress_stride));
+            });
         }
-        workers.WaitForRequests();
+        jobs.Wait();
+    }
+
+    if (decode_cache) {
+        decode_cache->Insert(key, blocks, decoded);
     }
 }
 
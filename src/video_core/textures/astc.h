@@ -3,9 +3,15 @@
 
 #pragma once
 
+namespace Tegra::Texture {
+class DecodeCache;
+}
+
 namespace Tegra::Texture::ASTC {
 
+/// Decodes ASTC blocks to RGBA8, reusing and filling decode_cache when it is not null
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
-                uint32_t block_width, uint32_t block_height, std::span<uint8_t> output);
+                uint32_t block_width, uint32_t block_height, std::span<uint8_t> output,
+                DecodeCache* decode_cache = nullptr);
 
 } // namespace Tegra::Texture::ASTC
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "video_core/textures/decode_cache.h"
+
+namespace Tegra::Texture {
+
+namespace {
+/// Decodes bigger than this fraction of the budget would evict most of the cache, skip them
+constexpr size_t MAX_ENTRY_BUDGET_FRACTION = 4;
+/// Number of recent misses remembered to decide which decodes are worth caching
+constexpr size_t NUM_MISSED_HASHES = 4096;
+} // Anonymous namespace
+
+DecodeCache::DecodeCache(size_t budget_) : budget{budget_} {
+    if (budget != 0) {
+        missed_hashes.resize(NUM_MISSED_HASHES);
+    }
+}
+
+DecodeCache::~DecodeCache() = default;
+
+bool DecodeCache::Lookup(const DecodeKey& key, std::span<const u8> encoded,
+                         std::span<u8> output) {
+    if (budget == 0) {
+        return false;
+    }
+    std::shared_ptr<const Data> data;
+    {
+        std::scoped_lock lock{mutex};
+        const auto it = entries.find(key);
+        if (it == entries.end()) {
+            return false;
+        }
+        lru.splice(lru.begin(), lru, it->second);
+        data = it->second->data;
+    }
+    if (data->decoded.size() > output.size() || data->encoded.size() != encoded.size() ||
+        std::memcmp(data->encoded.data(), encoded.data(), encoded.size()) != 0) {
+        return false;
+    }
+    std::memcpy(output.data(), data->decoded.data(), data->decoded.size());
+    return true;
+}
+
+void DecodeCache::Insert(const DecodeKey& key, std::span<const u8> encoded,
+                         std::span<const u8> decoded) {
+    const size_t size = encoded.size() + decoded.size();
+    if (budget == 0 || size > budget / MAX_ENTRY_BUDGET_FRACTION) {
+        return;
+    }
+    {
+        std::scoped_lock lock{mutex};
+        u64& missed_hash = missed_hashes[key.hash % NUM_MISSED_HASHES];
+        if (missed_hash != key.hash) {
+            missed_hash = key.hash;
+            return;
+        }
+        if (entries.contains(key)) {
+            // Same hash with different contents, keep the entry that is already cached
+            return;
+        }
+    }
+    auto data = std::make_shared<const Data>(Data{
+        .encoded{encoded.begin(), encoded.end()},
+        .decoded{decoded.begin(), decoded.end()},
+    });
+
+    std::scoped_lock lock{mutex};
+    if (entries.contains(key)) {
+        return;
+    }
+    lru.push_front(Entry{
+        .key = key,
+        .data = std::move(data),
+    });
+    entries.emplace(key, lru.begin());
+    used_bytes += size;
+    EvictToBudget();
+}
+
+void DecodeCache::Clear() {
+    std::scoped_lock lock{mutex};
+    entries.clear();
+    lru.clear();
+    std::ranges::fill(missed_hashes, 0);
+    used_bytes = 0;
+}
+
+void DecodeCache::EvictToBudget() {
+    while (used_bytes > budget && !lru.empty()) {
+        const Entry& entry = lru.back();
+        used_bytes -= entry.data->encoded.size() + entry.data->decoded.size();
+        entries.erase(entry.key);
+        lru.pop_back();
+    }
+}
+
+} // namespace Tegra::Texture
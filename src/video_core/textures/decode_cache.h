@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Tegra::Texture {
+
+/// Identifies a CPU decode by the contents of the encoded data and its layout
+struct DecodeKey {
+    u64 hash;
+    u64 size;
+    u32 width;
+    u32 height;
+    u32 depth;
+    u32 block_width;
+    u32 block_height;
+
+    bool operator==(const DecodeKey&) const noexcept = default;
+};
+
+} // namespace Tegra::Texture
+
+namespace std {
+template <>
+struct hash<Tegra::Texture::DecodeKey> {
+    size_t operator()(const Tegra::Texture::DecodeKey& key) const noexcept {
+        return static_cast<size_t>(key.hash);
+    }
+};
+} // namespace std
+
+namespace Tegra::Texture {
+
+/// Content addressed cache of decoded textures, evicting the least recently used entries once
+/// the encoded and decoded data exceed the memory budget.
+/// Hits are verified against a copy of the encoded data, a matching hash alone is not trusted.
+class DecodeCache {
+public:
+    /// Creates a cache holding up to budget_ bytes, a budget of zero disables caching
+    explicit DecodeCache(size_t budget_);
+    ~DecodeCache();
+
+    DecodeCache& operator=(const DecodeCache&) = delete;
+    DecodeCache(const DecodeCache&) = delete;
+
+    /// Copies a cached decode of encoded into output, returns false when it is not cached
+    [[nodiscard]] bool Lookup(const DecodeKey& key, std::span<const u8> encoded,
+                              std::span<u8> output);
+
+    /// Stores a decode the second time its key misses, so textures uploaded only once never pay
+    /// for the copy. Entries bigger than a fraction of the budget are not cached.
+    void Insert(const DecodeKey& key, std::span<const u8> encoded, std::span<const u8> decoded);
+
+    /// Releases every entry
+    void Clear();
+
+private:
+    struct Data {
+        std::vector<u8> encoded;
+        std::vector<u8> decoded;
+    };
+
+    struct Entry {
+        DecodeKey key;
+        std::shared_ptr<const Data> data;
+    };
+
+    void EvictToBudget();
+
+    std::mutex mutex;
+    std::list<Entry> lru; ///< Most recently used entries at the front
+    std::unordered_map<DecodeKey, std::list<Entry>::iterator> entries;
+    std::vector<u64> missed_hashes; ///< Direct mapped hashes of recent misses
+    size_t budget;
+    size_t used_bytes{};
+};
+
+} // namespace Tegra::Texture
@@ -13,6 +13,11 @@
 #include "video_core/gpu.h"
 #include "video_core/textures/decoders.h"
 
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#endif
+
 namespace Tegra::Texture {
 namespace {
 template <u32 mask>
@@ -33,9 +38,173 @@ void incrpdep(u32& value) {
     value = ((value | ~mask) + swizzled_incr) & mask;
 }
 
+// Each row of a GOB is made of four 16 byte sectors that are contiguous in memory
+constexpr u32 SECTOR_SIZE = 16;
+constexpr u32 SECTOR_SIZE_SHIFT = 4;
+constexpr u32 SECTORS_PER_GOB_ROW = GOB_SIZE_X / SECTOR_SIZE;
+
+using GobSectorTable = std::array<std::array<u32, SECTORS_PER_GOB_ROW>, GOB_SIZE_Y>;
+
+constexpr GobSectorTable MakeGobSectorTable() {
+    GobSectorTable table{};
+    for (u32 row = 0; row < GOB_SIZE_Y; ++row) {
+        for (u32 sector = 0; sector < SECTORS_PER_GOB_ROW; ++sector) {
+            table[row][sector] =
+                pdep<SWIZZLE_X_BITS>(sector << SECTOR_SIZE_SHIFT) | pdep<SWIZZLE_Y_BITS>(row);
+        }
+    }
+    return table;
+}
+
+/// Offset of every sector within a GOB
+constexpr GobSectorTable GOB_SECTOR_OFFSETS = MakeGobSectorTable();
+
+/// Copies a rectangle of sectors between a GOB and linear memory.
+/// The GOB pointer points to the start of the GOB, the linear one to the first copied sector.
+template <bool TO_LINEAR>
+void CopyGobSectors(u8* dst, const u8* src, u32 pitch, u32 first_row, u32 num_rows,
+                    u32 first_sector, u32 num_sectors) {
+    for (u32 row = 0; row < num_rows; ++row) {
+        for (u32 sector = 0; sector < num_sectors; ++sector) {
+            const u32 gob_offset = GOB_SECTOR_OFFSETS[first_row + row][first_sector + sector];
+            const u32 linear_offset = row * pitch + sector * SECTOR_SIZE;
+            if constexpr (TO_LINEAR) {
+                std::memcpy(dst + gob_offset, src + linear_offset, SECTOR_SIZE);
+            } else {
+                std::memcpy(dst + linear_offset, src + gob_offset, SECTOR_SIZE);
+            }
+        }
+    }
+}
+
+/// Copies a whole GOB, compilers lower each sector to a single 128-bit load and store
+template <bool TO_LINEAR>
+void CopyGob(u8* dst, const u8* src, u32 pitch) {
+    CopyGobSectors<TO_LINEAR>(dst, src, pitch, 0, GOB_SIZE_Y, 0, SECTORS_PER_GOB_ROW);
+}
+
+#ifdef ARCHITECTURE_x86_64
+/// Copies a whole GOB moving the same sector of two consecutive rows, which are adjacent in the
+/// GOB, with a single 256-bit access
+template <bool TO_LINEAR>
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+void CopyGobAVX2(u8* dst, const u8* src, u32 pitch) {
+    for (u32 row = 0; row < GOB_SIZE_Y; row += 2) {
+        for (u32 sector = 0; sector < SECTORS_PER_GOB_ROW; ++sector) {
+            const u32 gob_offset = GOB_SECTOR_OFFSETS[row][sector];
+            const u32 linear_offset = row * pitch + sector * SECTOR_SIZE;
+            if constexpr (TO_LINEAR) {
+                const __m128i first =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + linear_offset));
+                const __m128i second =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + linear_offset + pitch));
+                const __m256i pair =
+                    _mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + gob_offset), pair);
+            } else {
+                const __m256i pair =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + gob_offset));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + linear_offset),
+                                 _mm256_castsi256_si128(pair));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + linear_offset + pitch),
+                                 _mm256_extracti128_si256(pair, 1));
+            }
+        }
+    }
+}
+#endif
+
+using CopyGobFunction = void (*)(u8* dst, const u8* src, u32 pitch);
+
+template <bool TO_LINEAR>
+CopyGobFunction SelectCopyGob() {
+#ifdef ARCHITECTURE_x86_64
+    if (Common::GetCPUCaps().avx2) {
+        return &CopyGobAVX2<TO_LINEAR>;
+    }
+#endif
+    return &CopyGob<TO_LINEAR>;
+}
+
+/// Swizzles a rectangle whose rows start and end on sector boundaries one GOB at a time.
+/// origin_x and extent_x are measured in sectors, stride in bytes.
+template <bool TO_LINEAR>
+void SwizzleSectorsImpl(std::span<u8> output, std::span<const u8> input, u32 stride, u32 height,
+                        u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 num_lines,
+                        u32 block_height, u32 block_depth, u32 pitch) {
+    static const CopyGobFunction copy_gob = SelectCopyGob<TO_LINEAR>();
+
+    static constexpr u32 origin_z = 0;
+
+    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
+    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height + block_depth);
+    const u32 slice_size =
+        Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) * block_size;
+
+    const u32 block_height_mask = (1U << block_height) - 1;
+    const u32 block_depth_mask = (1U << block_depth) - 1;
+    const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
+
+    u32 unprocessed_lines = num_lines;
+    const u32 extent_y = std::min(num_lines, height - origin_y);
+
+    for (u32 slice = 0; slice < depth; ++slice) {
+        const u32 z = slice + origin_z;
+        const u32 offset_z = (z >> block_depth) * slice_size +
+                             ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
+        const u32 lines_in_y = std::min(unprocessed_lines, extent_y);
+        for (u32 line = 0; line < lines_in_y;) {
+            const u32 y = line + origin_y;
+            const u32 gob_row = y & (GOB_SIZE_Y - 1);
+            const u32 num_rows = std::min(GOB_SIZE_Y - gob_row, lines_in_y - line);
+
+            const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+            const u32 offset_y = (block_y >> block_height) * block_size +
+                                 ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+            const u32 linear_line = slice * pitch * height + line * pitch;
+
+            for (u32 column = 0; column < extent_x;) {
+                const u32 x = column + origin_x;
+                const u32 gob_sector = x & (SECTORS_PER_GOB_ROW - 1);
+                const u32 num_sectors =
+                    std::min(SECTORS_PER_GOB_ROW - gob_sector, extent_x - column);
+
+                const u32 offset_x = (x / SECTORS_PER_GOB_ROW) << x_shift;
+                const u32 gob_offset = offset_z + offset_y + offset_x;
+                const u32 linear_offset = linear_line + column * SECTOR_SIZE;
+
+                u8* const dst = &output[TO_LINEAR ? gob_offset : linear_offset];
+                const u8* const src = &input[TO_LINEAR ? linear_offset : gob_offset];
+
+                if (num_rows == GOB_SIZE_Y && num_sectors == SECTORS_PER_GOB_ROW) {
+                    copy_gob(dst, src, pitch);
+                } else {
+                    CopyGobSectors<TO_LINEAR>(dst, src, pitch, gob_row, num_rows, gob_sector,
+                                              num_sectors);
+                }
+                column += num_sectors;
+            }
+            line += num_rows;
+        }
+        unprocessed_lines -= lines_in_y;
+        if (unprocessed_lines == 0) {
+            return;
+        }
+    }
+}
+
 template <bool TO_LINEAR, u32 BYTES_PER_PIXEL>
 void SwizzleImpl(std::span<u8> output, std::span<const u8> input, u32 width, u32 height, u32 depth,
                  u32 block_height, u32 block_depth, u32 stride) {
+    if constexpr (BYTES_PER_PIXEL == SECTOR_SIZE) {
+        // Every pixel is a whole sector, move entire GOBs at once
+        return SwizzleSectorsImpl<TO_LINEAR>(output, input, stride, height, depth, 0, 0, width,
+                                             height * depth, block_height, block_depth,
+                                             width * BYTES_PER_PIXEL);
+    }
+
     // The origin of the transformation can be configured here, leave it as zero as the current API
     // doesn't expose it.
     static constexpr u32 origin_x = 0;
@@ -174,6 +343,12 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
     }
 }
 
+/// Returns true when the rows of a subrect start and end on sector boundaries
+bool IsSectorAligned(u32 bytes_per_pixel, u32 origin_x, u32 extent_x) {
+    return ((origin_x * bytes_per_pixel) & (SECTOR_SIZE - 1)) == 0 &&
+           ((extent_x * bytes_per_pixel) & (SECTOR_SIZE - 1)) == 0;
+}
+
 } // Anonymous namespace
 
 void UnswizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
@@ -201,6 +376,13 @@ void SwizzleTexture(std::span<u8> output, std::span<const u8> input, u32 bytes_p
 void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
                     u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x, u32 extent_y,
                     u32 block_height, u32 block_depth, u32 pitch_linear) {
+    if (IsSectorAligned(bytes_per_pixel, origin_x, extent_x)) {
+        return SwizzleSectorsImpl<true>(
+            output, input, Common::AlignUpLog2(width * bytes_per_pixel, GOB_SIZE_X_SHIFT), height,
+            depth, (origin_x * bytes_per_pixel) >> SECTOR_SIZE_SHIFT, origin_y,
+            (extent_x * bytes_per_pixel) >> SECTOR_SIZE_SHIFT, extent_y, block_height,
+            block_depth, pitch_linear);
+    }
     switch (bytes_per_pixel) {
 #define BPP_CASE(x)                                                                                \
     case x:                                                                                        \
@@ -225,6 +407,13 @@ void SwizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_p
 void UnswizzleSubrect(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel,
                       u32 width, u32 height, u32 depth, u32 origin_x, u32 origin_y, u32 extent_x,
                       u32 extent_y, u32 block_height, u32 block_depth, u32 pitch_linear) {
+    if (IsSectorAligned(bytes_per_pixel, origin_x, extent_x)) {
+        return SwizzleSectorsImpl<false>(
+            output, input, Common::AlignUpLog2(width * bytes_per_pixel, GOB_SIZE_X_SHIFT), height,
+            depth, (origin_x * bytes_per_pixel) >> SECTOR_SIZE_SHIFT, origin_y,
+            (extent_x * bytes_per_pixel) >> SECTOR_SIZE_SHIFT, extent_y, block_height,
+            block_depth, pitch_linear);
+    }
     switch (bytes_per_pixel) {
 #define BPP_CASE(x)                                                                                \
     case x:                                                                                        \
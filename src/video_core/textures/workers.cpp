@@ -6,10 +6,26 @@
 namespace Tegra::Texture {
 
 Common::ThreadWorker& GetThreadWorkers() {
-    static Common::ThreadWorker workers{std::max(std::thread::hardware_concurrency(), 2U) / 2,
-                                        "ImageTranscode"};
+    static Common::ThreadWorker workers{GetNumThreadWorkers(), "ImageTranscode"};
 
     return workers;
 }
 
+size_t GetNumThreadWorkers() {
+    return std::max(std::thread::hardware_concurrency(), 2U) / 2;
+}
+
+void JobGroup::Wait() {
+    std::unique_lock lk{mutex};
+    cv.wait(lk, [this] { return pending_jobs == 0; });
+}
+
+void JobGroup::Complete() {
+    // Notify under the lock, the waiter may destroy the group as soon as it can return
+    std::scoped_lock lk{mutex};
+    if (--pending_jobs == 0) {
+        cv.notify_all();
+    }
+}
+
 } // namespace Tegra::Texture
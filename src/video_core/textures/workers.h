@@ -3,10 +3,48 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
 #include "common/thread_worker.h"
 
 namespace Tegra::Texture {
 
 Common::ThreadWorker& GetThreadWorkers();
 
-}
+/// Number of threads in the texture worker pool
+size_t GetNumThreadWorkers();
+
+/// Jobs queued to the texture workers by one caller. Waiting on the group only waits for its own
+/// jobs, not for the ones other threads queued to the shared pool in the meantime.
+class JobGroup {
+public:
+    ~JobGroup() {
+        Wait();
+    }
+
+    template <typename Func>
+    void Queue(Func&& func) {
+        {
+            std::scoped_lock lk{mutex};
+            ++pending_jobs;
+        }
+        GetThreadWorkers().QueueWork([this, func = std::forward<Func>(func)]() mutable {
+            func();
+            Complete();
+        });
+    }
+
+    /// Blocks until every job queued to this group has run
+    void Wait();
+
+private:
+    void Complete();
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t pending_jobs = 0;
+};
+
+} // namespace Tegra::Texture
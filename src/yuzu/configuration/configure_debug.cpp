@@ -53,6 +53,8 @@ void ConfigureDebug::SetConfiguration() {
     ui->enable_renderdoc_hotkey->setChecked(Settings::values.enable_renderdoc_hotkey.GetValue());
     ui->disable_buffer_reorder->setEnabled(runtime_lock);
     ui->disable_buffer_reorder->setChecked(Settings::values.disable_buffer_reorder.GetValue());
+    ui->disable_gpu_fastmem->setEnabled(runtime_lock);
+    ui->disable_gpu_fastmem->setChecked(Settings::values.disable_gpu_fastmem.GetValue());
     ui->enable_graphics_debugging->setEnabled(runtime_lock);
     ui->enable_graphics_debugging->setChecked(Settings::values.renderer_debug.GetValue());
     ui->enable_shader_feedback->setEnabled(runtime_lock);
@@ -65,6 +67,8 @@ void ConfigureDebug::SetConfiguration() {
     ui->dump_shaders->setChecked(Settings::values.dump_shaders.GetValue());
     ui->dump_macros->setEnabled(runtime_lock);
     ui->dump_macros->setChecked(Settings::values.dump_macros.GetValue());
+    ui->dump_gpu_commands->setEnabled(runtime_lock);
+    ui->dump_gpu_commands->setChecked(Settings::values.dump_gpu_commands.GetValue());
     ui->disable_macro_jit->setEnabled(runtime_lock);
     ui->disable_macro_jit->setChecked(Settings::values.disable_macro_jit.GetValue());
     ui->disable_macro_hle->setEnabled(runtime_lock);
@@ -99,11 +103,13 @@ void ConfigureDebug::ApplyConfiguration() {
     Settings::values.renderer_debug = ui->enable_graphics_debugging->isChecked();
     Settings::values.enable_renderdoc_hotkey = ui->enable_renderdoc_hotkey->isChecked();
     Settings::values.disable_buffer_reorder = ui->disable_buffer_reorder->isChecked();
+    Settings::values.disable_gpu_fastmem = ui->disable_gpu_fastmem->isChecked();
     Settings::values.renderer_shader_feedback = ui->enable_shader_feedback->isChecked();
     Settings::values.cpu_debug_mode = ui->enable_cpu_debugging->isChecked();
     Settings::values.enable_nsight_aftermath = ui->enable_nsight_aftermath->isChecked();
     Settings::values.dump_shaders = ui->dump_shaders->isChecked();
     Settings::values.dump_macros = ui->dump_macros->isChecked();
+    Settings::values.dump_gpu_commands = ui->dump_gpu_commands->isChecked();
     Settings::values.disable_shader_loop_safety_checks =
         ui->disable_loop_safety_checks->isChecked();
     Settings::values.disable_macro_jit = ui->disable_macro_jit->isChecked();
@@ -71,6 +71,20 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
               "faster or not.\n200% for a 30 FPS game is 60 FPS, and for a "
               "60 FPS game it will be 120 FPS.\nDisabling it means unlocking the framerate to the "
               "maximum your PC can reach."));
+    INSERT(Settings, use_huge_pages, tr("Use huge pages for emulated memory"),
+           tr("Backs the emulated RAM with 2 MiB pages when the host kernel allows it for shared "
+              "memory.\nThis reduces TLB misses in games with large working sets, at the cost of "
+              "higher memory use.\nTakes effect after restarting yuzu."));
+    INSERT(Settings, use_shared_service_threads, tr("Share host threads between services"),
+           tr("Processes the requests of the services that use host threads on one pool of "
+              "threads sized to the CPU core count, instead of giving each service its own "
+              "threads.\nTakes effect the next time a game is started."));
+    INSERT(Settings, use_host_thread_per_guest_thread,
+           tr("Run guest threads on host threads (experimental)"),
+           tr("Gives each emulated thread a host thread of its own instead of switching between "
+              "them on the CPU core threads.\nThe emulated scheduler still decides which threads "
+              "run. Only applies to multicore emulation without NCE.\nTakes effect the next "
+              "time a game is started."));
 
     // Cpu
     INSERT(Settings, cpu_accuracy, tr("Accuracy:"),
@@ -169,6 +183,14 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
               "of available video memory for performance. Has no effect on integrated graphics. "
               "Aggressive mode may severely impact the performance of other applications such as "
               "recording software."));
+    INSERT(Settings, texture_cache_budget, tr("Texture Cache Budget (MiB):"),
+           tr("Limits the video memory the texture cache may use before it starts evicting "
+              "textures that have not been used recently, largest first.\n"
+              "0 picks a budget automatically from the available video memory."));
+    INSERT(Settings, astc_decode_cache_size, tr("ASTC Decode Cache Size (MiB):"),
+           tr("System memory used to keep textures decoded on the CPU, so textures uploaded "
+              "again with the same contents are not decoded again.\n"
+              "0 disables the cache."));
     INSERT(
         Settings, vsync_mode, tr("VSync Mode:"),
         tr("FIFO (VSync) does not drop frames or exhibit tearing but is limited by the screen "
@@ -28,6 +28,7 @@
 #include "core/file_sys/vfs/vfs_real.h"
 #include "core/hle/service/am/applet_manager.h"
 #include "core/hle/service/filesystem/filesystem.h"
+#include "core/hle/service/ipc_profiler.h"
 #include "core/loader/loader.h"
 #include "core/telemetry_session.h"
 #include "frontend_common/config.h"
@@ -75,6 +76,8 @@ static void PrintHelp(const char* argv0) {
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-g, --game            File path of the game to load\n"
                  "-h, --help            Display this help and exit\n"
+                 "-i, --ipc-profile     Profile HLE service calls and write them as JSON to the "
+                 "given file on exit\n"
                  "-m, --multiplayer=nick:password@address:port"
                  " Nickname, password, address and port for multiplayer\n"
                  "-p, --program         Pass following string as arguments to executable\n"
@@ -211,6 +214,7 @@ int main(int argc, char** argv) {
     std::optional<std::string> config_path;
     std::string program_args;
     std::optional<int> selected_user;
+    std::optional<std::string> ipc_profile_path;
 
     bool use_multiplayer = false;
     bool fullscreen = false;
@@ -224,6 +228,7 @@ int main(int argc, char** argv) {
         {"config", required_argument, 0, 'c'},
         {"fullscreen", no_argument, 0, 'f'},
         {"help", no_argument, 0, 'h'},
+        {"ipc-profile", required_argument, 0, 'i'},
         {"game", required_argument, 0, 'g'},
         {"multiplayer", required_argument, 0, 'm'},
         {"program", optional_argument, 0, 'p'},
@@ -234,7 +239,7 @@ int main(int argc, char** argv) {
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::c:u:", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:fhi:vp::c:u:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'c':
@@ -252,6 +257,10 @@ int main(int argc, char** argv) {
                 filepath = str_arg;
                 break;
             }
+            case 'i':
+                ipc_profile_path = optarg;
+                Service::IpcProfiler::SetEnabled(true);
+                break;
             case 'm': {
                 use_multiplayer = true;
                 const std::string str_arg(optarg);
@@ -430,7 +439,14 @@ int main(int argc, char** argv) {
             [](VideoCore::LoadCallbackStage, size_t value, size_t total) {});
     }
 
+    const auto dump_ipc_profile = [&ipc_profile_path] {
+        if (ipc_profile_path && Service::IpcProfiler::DumpJson(*ipc_profile_path)) {
+            LOG_INFO(Frontend, "IPC profile written to {}", *ipc_profile_path);
+        }
+    };
+
     system.RegisterExitCallback([&] {
+        dump_ipc_profile();
         // Just exit right away.
         exit(0);
     });
@@ -448,6 +464,7 @@ int main(int argc, char** argv) {
     }
     system.DetachDebugger();
     void(system.Pause());
+    dump_ipc_profile();
     system.ShutdownMainProcess();
 
 #ifdef __unix__